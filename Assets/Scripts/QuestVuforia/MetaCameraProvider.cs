@@ -4,6 +4,7 @@ using Meta.XR;
 using Unity.Collections;
 using UnityEngine;
 using UnityEngine.Android;
+using Vuforia;
 
 /// <summary>
 /// Provides camera frames and device poses to Vuforia Driver Framework.
@@ -19,18 +20,95 @@ public class MetaCameraProvider : MonoBehaviour
     [SerializeField] private bool autoStart = true;
     [SerializeField] private bool flipImageVertically = true;
     [SerializeField] private bool useCameraRotation = false;
+    [SerializeField] private bool grayscaleOnly = false;
+    [SerializeField] private int poseToleranceMs = 50;
+
+    [Header("Lens Undistortion")]
+    [SerializeField] private bool undistort = false;
+    // k1, k2, p1, p2, k3, k4, k5, k6 (OpenCV rational model, calibrated at SensorResolution)
+    [SerializeField] private float[] distortionCoefficients = new float[8];
+
+    [Header("Low Light")]
+    [SerializeField] private QuestVuforiaBridge.LowLightMode lowLightMode = QuestVuforiaBridge.LowLightMode.Off;
+    [SerializeField] [Range(0, 255)] private int darkThreshold = 80;
+    [SerializeField] [Range(1f, 8f)] private float maxLowLightGain = 3f;
+    [SerializeField] private bool gateDarkFrames = false;
+    [SerializeField] [Range(0, 255)] private int minMeanLuma = 20;
+
+    [Header("Crop")]
+    [SerializeField] private bool enableCrop = false;
+    [SerializeField] private Rect cropWindow = new Rect(0.25f, 0.25f, 0.5f, 0.5f);
+    [SerializeField] private bool upscaleCrop = false;
+
+    [Header("Adaptive Resolution")]
+    [SerializeField] private bool adaptiveResolution = false;
+    [SerializeField] [Range(0.25f, 1f)] private float trackedResolutionScale = 0.5f;
+    [SerializeField] private int trackedHoldMs = 1000;
+    [SerializeField] private ObserverBehaviour[] trackedTargets;
+
+    [Header("Pose Prediction")]
+    [SerializeField] private bool predictPoses = false;
+    [SerializeField] private QuestVuforiaBridge.PredictionModel predictionModel = QuestVuforiaBridge.PredictionModel.ConstantVelocity;
+    [SerializeField] private int maxPredictionMs = 50;
+    [SerializeField] private int unreliablePredictionMs = 20;
+    [SerializeField] private bool joinLatePoses = false;
+    [SerializeField] private int poseJoinTimeoutMs = 5;
+    [SerializeField] private bool streamPoses = false;
+
+    [Header("Camera Rig")]
+    [SerializeField] private bool composeCameraPoseNatively = false;
+    [SerializeField] [Range(0, 1)] private int rigCameraIndex = 0;
+
+    [Header("Stereo")]
+    [SerializeField] private PassthroughCameraAccess secondaryCameraAccess;
+    [SerializeField] private QuestVuforiaBridge.StereoPolicy stereoPolicy = QuestVuforiaBridge.StereoPolicy.ActiveCamera;
+
+    [Header("Pose Validity")]
+    [SerializeField] private bool validatePoses = false;
+    [SerializeField] [Range(0f, 1f)] private float minPoseConfidence = 0.5f;
+    [SerializeField] private int maxPoseGapMs = 20;
+    [SerializeField] private float poseJumpDistance = 0.1f;
+    [SerializeField] private float poseJumpAngle = 20f;
+    [SerializeField] private float excessiveAngularVelocity = 340f;
+    [SerializeField] private int poseSettleMs = 500;
+
+    [Header("Motion Skipping")]
+    [SerializeField] private bool skipFastMotionFrames = false;
+    [SerializeField] private float maxAngularVelocity = 170f;
+    [SerializeField] private float maxLinearVelocity = 1f;
+    [SerializeField] private int maxConsecutiveSkips = 5;
+
+    [Header("Static Scene Throttling")]
+    [SerializeField] private bool throttleStaticScene = false;
+    [SerializeField] private float sceneLumaThreshold = 2f;
+    [SerializeField] private float sceneTranslationThreshold = 0.005f;
+    [SerializeField] private float sceneRotationThreshold = 0.5f;
+    [SerializeField] private float staticFloorFps = 5f;
+
+    [Header("Frame Selection")]
+    [SerializeField] private bool selectSharpestFrame = false;
+    [SerializeField] private int selectionWindowMs = 50;
 
     [Header("Debug")]
     [SerializeField] private bool enableDebugLogs = false;
     [SerializeField] private bool showFrameStats = false;
     [SerializeField] private bool showPoseDebug = false;
     [SerializeField] private float statsInterval = 1.0f;
+    [SerializeField] private bool recordTrace = false;
+    [SerializeField] private QuestVuforiaBridge.LogLevel nativeLogLevel = QuestVuforiaBridge.LogLevel.Debug;
 
-    private byte[] imageDataRGB;
+    private byte[] imageDataRGBA;
     private bool isRunning = false;
     private int frameCount = 0;
     private int width, height;
     private float[] cachedIntrinsics;
+    private bool extrinsicsSet = false;
+    private byte[] secondaryImageDataRGBA;
+    private bool stereoEnabled = false;
+    private bool secondaryExtrinsicsSet = false;
+
+    // The secondary camera is the other rig camera
+    private int SecondaryCameraIndex => 1 - rigCameraIndex;
 
     // Frame stats
     private float lastStatsTime;
@@ -86,50 +164,105 @@ public class MetaCameraProvider : MonoBehaviour
         Vector2Int resolution = cameraAccess.CurrentResolution;
         width = resolution.x;
         height = resolution.y;
-        imageDataRGB = new byte[width * height * 3];
+        imageDataRGBA = new byte[width * height * 4];
 
         var sensorRes = cameraAccess.Intrinsics.SensorResolution;
         Log($"Camera initialized: Current={width}x{height}, Sensor={sensorRes.x}x{sensorRes.y}");
         if (width != sensorRes.x || height != sensorRes.y)
         {
             Debug.LogWarning($"[Quforia] CurrentResolution ({width}x{height}) != SensorResolution ({sensorRes.x}x{sensorRes.y}). " +
-                           "Image may be cropped/scaled. This can cause tracking offset!");
+                           "Intrinsics are rescaled natively; if the image is cropped rather than scaled this can cause tracking offset!");
+        }
+
+        // Stereo: the second camera's pose is composed natively from the head pose
+        if (secondaryCameraAccess != null)
+        {
+            if (!composeCameraPoseNatively)
+            {
+                Debug.LogWarning("[Quforia] Stereo ingestion needs composeCameraPoseNatively; feeding one camera only");
+            }
+            else
+            {
+                yield return StartSecondaryCamera();
+            }
         }
 
         // Setup intrinsics
         SetupCameraIntrinsics();
+        QuestVuforiaBridge.SetClockDomain(QuestVuforiaBridge.ClockDomain.Estimated);
+        QuestVuforiaBridge.SetGrayscaleOnly(grayscaleOnly);
+        QuestVuforiaBridge.SetPoseTolerance(poseToleranceMs);
+        QuestVuforiaBridge.SetPosePrediction(predictPoses, predictionModel, maxPredictionMs, unreliablePredictionMs);
+        QuestVuforiaBridge.SetPoseJoin(joinLatePoses, poseJoinTimeoutMs);
+        QuestVuforiaBridge.SetPoseStreaming(streamPoses);
+        QuestVuforiaBridge.SetActiveCamera(rigCameraIndex);
+        QuestVuforiaBridge.SetStereoPolicy(stereoEnabled ? stereoPolicy : QuestVuforiaBridge.StereoPolicy.ActiveCamera);
+        QuestVuforiaBridge.SetPoseValidation(validatePoses, minPoseConfidence, maxPoseGapMs, poseJumpDistance,
+                                             poseJumpAngle, excessiveAngularVelocity, poseSettleMs);
+        QuestVuforiaBridge.SetCropWindow(enableCrop, cropWindow, upscaleCrop);
+        QuestVuforiaBridge.SetUndistortionEnabled(undistort);
+        QuestVuforiaBridge.SetLowLightNormalization(lowLightMode, darkThreshold, maxLowLightGain);
+        QuestVuforiaBridge.SetBrightnessGating(gateDarkFrames, minMeanLuma);
+        QuestVuforiaBridge.SetMotionSkipping(skipFastMotionFrames, maxAngularVelocity, maxLinearVelocity, maxConsecutiveSkips);
+        QuestVuforiaBridge.SetFrameSelection(selectSharpestFrame, selectionWindowMs);
+        QuestVuforiaBridge.SetSceneChangeGating(throttleStaticScene, sceneLumaThreshold, sceneTranslationThreshold, sceneRotationThreshold, staticFloorFps);
+        SetupAdaptiveResolution();
+        QuestVuforiaBridge.SetTraceEnabled(recordTrace);
+        QuestVuforiaBridge.SetLogLevel(nativeLogLevel);
 
         isRunning = true;
         lastStatsTime = Time.time;
         StartCoroutine(ProcessFrames());
     }
 
+    private IEnumerator StartSecondaryCamera()
+    {
+        if (!secondaryCameraAccess.enabled)
+        {
+            secondaryCameraAccess.enabled = true;
+            yield return null;
+        }
+
+        float elapsed = 0f;
+        while (!secondaryCameraAccess.IsPlaying && elapsed < 10f)
+        {
+            yield return null;
+            elapsed += Time.deltaTime;
+        }
+
+        if (!secondaryCameraAccess.IsPlaying)
+        {
+            Debug.LogWarning("[Quforia] Secondary camera failed to start; feeding one camera only");
+            yield break;
+        }
+
+        // Both streams share the ingestion buffers' size
+        Vector2Int resolution = secondaryCameraAccess.CurrentResolution;
+        if (resolution.x != width || resolution.y != height)
+        {
+            Debug.LogWarning($"[Quforia] Secondary camera resolution ({resolution.x}x{resolution.y}) != primary ({width}x{height}); feeding one camera only");
+            yield break;
+        }
+
+        secondaryImageDataRGBA = new byte[width * height * 4];
+        stereoEnabled = true;
+        Log($"Stereo ingestion: camera {rigCameraIndex} + camera {SecondaryCameraIndex}, policy {stereoPolicy}");
+    }
+
     private void SetupCameraIntrinsics()
     {
         try
         {
-            var intrinsics = cameraAccess.Intrinsics;
-
-            // The intrinsics from Meta are calibrated to SensorResolution
-            // But we're feeding CurrentResolution to Vuforia
-            // We need to scale the intrinsics if there's a resolution mismatch
-            var sensorRes = intrinsics.SensorResolution;
-            float scaleX = (float)width / sensorRes.x;
-            float scaleY = (float)height / sensorRes.y;
-
-            cachedIntrinsics = new float[14];
-            cachedIntrinsics[0] = width;  // Use actual frame width
-            cachedIntrinsics[1] = height; // Use actual frame height
-            cachedIntrinsics[2] = intrinsics.FocalLength.x * scaleX;  // Scale focal length
-            cachedIntrinsics[3] = intrinsics.FocalLength.y * scaleY;
-            cachedIntrinsics[4] = intrinsics.PrincipalPoint.x * scaleX;  // Scale principal point
-            cachedIntrinsics[5] = intrinsics.PrincipalPoint.y * scaleY;
-            // Distortion coefficients (6-13) remain 0 (Meta doesn't provide them)
-
-            QuestVuforiaBridge.SetCameraIntrinsics(cachedIntrinsics);
-            Log($"Intrinsics scaled: {width}x{height} (from {sensorRes.x}x{sensorRes.y}), " +
+            cachedIntrinsics = BuildIntrinsics(cameraAccess);
+            QuestVuforiaBridge.SetCameraIntrinsics(rigCameraIndex, cachedIntrinsics);
+            Log($"Intrinsics set: calibrated at {cachedIntrinsics[0]}x{cachedIntrinsics[1]}, frame {width}x{height}, " +
                 $"fx={cachedIntrinsics[2]:F1}, fy={cachedIntrinsics[3]:F1}, " +
                 $"cx={cachedIntrinsics[4]:F1}, cy={cachedIntrinsics[5]:F1}");
+
+            if (stereoEnabled)
+            {
+                QuestVuforiaBridge.SetCameraIntrinsics(SecondaryCameraIndex, BuildIntrinsics(secondaryCameraAccess));
+            }
         }
         catch (Exception e)
         {
@@ -137,6 +270,71 @@ public class MetaCameraProvider : MonoBehaviour
         }
     }
 
+    private float[] BuildIntrinsics(PassthroughCameraAccess access)
+    {
+        var intrinsics = access.Intrinsics;
+
+        // The intrinsics from Meta are calibrated to SensorResolution.
+        // The native driver rescales them to the frame size of whichever
+        // camera mode Vuforia selects, so they are passed through as-is.
+        var sensorRes = intrinsics.SensorResolution;
+
+        float[] values = new float[14];
+        values[0] = sensorRes.x;  // Calibration width
+        values[1] = sensorRes.y;  // Calibration height
+        values[2] = intrinsics.FocalLength.x;
+        values[3] = intrinsics.FocalLength.y;
+        values[4] = intrinsics.PrincipalPoint.x;
+        values[5] = intrinsics.PrincipalPoint.y;
+        // Distortion coefficients (6-13): Meta doesn't provide them, use calibrated values if set
+        if (distortionCoefficients != null)
+        {
+            for (int i = 0; i < Mathf.Min(8, distortionCoefficients.Length); i++)
+            {
+                values[6 + i] = distortionCoefficients[i];
+            }
+        }
+        return values;
+    }
+
+    private void SetupAdaptiveResolution()
+    {
+        QuestVuforiaBridge.SetAdaptiveResolution(adaptiveResolution, trackedResolutionScale, trackedHoldMs);
+
+        if (!adaptiveResolution || trackedTargets == null) return;
+
+        foreach (var target in trackedTargets)
+        {
+            if (target != null)
+            {
+                target.OnTargetStatusChanged += OnTargetStatusChanged;
+            }
+        }
+    }
+
+    private void OnTargetStatusChanged(ObserverBehaviour behaviour, TargetStatus status)
+    {
+        // Aggregate over all targets: any tracked target counts as tracked
+        var aggregate = QuestVuforiaBridge.TrackingStatus.Searching;
+        foreach (var target in trackedTargets)
+        {
+            if (target == null) continue;
+
+            var targetStatus = target.TargetStatus.Status;
+            if (targetStatus == Status.TRACKED)
+            {
+                aggregate = QuestVuforiaBridge.TrackingStatus.Tracked;
+                break;
+            }
+            if (targetStatus == Status.EXTENDED_TRACKED)
+            {
+                aggregate = QuestVuforiaBridge.TrackingStatus.Extended;
+            }
+        }
+
+        QuestVuforiaBridge.SetTrackingStatus(aggregate);
+    }
+
     private IEnumerator ProcessFrames()
     {
         while (isRunning)
@@ -159,6 +357,70 @@ public class MetaCameraProvider : MonoBehaviour
             {
                 float fps = framesProcessed / (Time.time - lastStatsTime);
                 Log($"Processing: {fps:F1} FPS | Total: {frameCount}");
+                if (skipFastMotionFrames)
+                {
+                    long[] skipStats = QuestVuforiaBridge.GetMotionSkipStats();
+                    if (skipStats != null)
+                    {
+                        Log($"Motion skipping: {skipStats[1]} of {skipStats[0]} frames skipped");
+                    }
+                }
+                if (predictPoses)
+                {
+                    long[] predictionStats = QuestVuforiaBridge.GetPosePredictionStats();
+                    if (predictionStats != null)
+                    {
+                        Log($"Pose prediction: {predictionStats[1]} of {predictionStats[0]} lookups, " +
+                            $"avg horizon {predictionStats[2] / 1000f:F1} ms, max {predictionStats[3] / 1000f:F1} ms");
+                    }
+                }
+                if (joinLatePoses)
+                {
+                    long[] joinStats = QuestVuforiaBridge.GetPoseJoinStats();
+                    if (joinStats != null)
+                    {
+                        Log($"Pose join: {joinStats[1]} of {joinStats[0]} frames waited (avg {joinStats[3] / 1000f:F2} ms), " +
+                            $"{joinStats[2]} timed out, {joinStats[4]} frames delivered before their pose");
+                    }
+                }
+                if (validatePoses)
+                {
+                    long[] validityStats = QuestVuforiaBridge.GetPoseValidityStats();
+                    if (validityStats != null)
+                    {
+                        Log($"Pose validity: {validityStats[1]} of {validityStats[0]} unreliable " +
+                            $"(initializing {validityStats[2]}, relocalizing {validityStats[3]}, " +
+                            $"excessive motion {validityStats[4]}), {validityStats[5]} relocalizations");
+                    }
+                }
+                if (stereoEnabled)
+                {
+                    long[] stereoStats = QuestVuforiaBridge.GetStereoStats();
+                    if (stereoStats != null)
+                    {
+                        Log($"Stereo: camera 0 picked {stereoStats[0]}, camera 1 picked {stereoStats[1]}, " +
+                            $"{stereoStats[2]} switches");
+                    }
+                }
+                long[] clockStats = QuestVuforiaBridge.GetClockStats();
+                if (clockStats != null)
+                {
+                    Log($"Clock: offset {clockStats[0] / 1e6:F3} ms, drift {clockStats[1] / 1e3:F1} ppm, " +
+                        $"{clockStats[2]} resyncs, frame age {clockStats[4] / 1e6:F2} ms");
+                }
+                long[] pipelineStats = QuestVuforiaBridge.GetPipelineStats();
+                if (pipelineStats != null)
+                {
+                    LogPipelineStats(pipelineStats);
+                }
+                if (throttleStaticScene)
+                {
+                    long[] sceneStats = QuestVuforiaBridge.GetSceneChangeStats();
+                    if (sceneStats != null)
+                    {
+                        Log($"Static scene: {sceneStats[1]} of {sceneStats[0]} frames skipped");
+                    }
+                }
                 lastStatsTime = Time.time;
                 framesProcessed = 0;
             }
@@ -177,29 +439,29 @@ public class MetaCameraProvider : MonoBehaviour
             return;
         }
 
-        // Convert Color32 to RGB888
-        for (int i = 0; i < pixels.Length; i++)
-        {
-            int rgbIndex = i * 3;
-            Color32 pixel = pixels[i];
-            imageDataRGB[rgbIndex] = pixel.r;
-            imageDataRGB[rgbIndex + 1] = pixel.g;
-            imageDataRGB[rgbIndex + 2] = pixel.b;
-        }
+        // Copy RGBA32 as-is; format conversion and flipping happen natively
+        pixels.Reinterpret<byte>(4).CopyTo(imageDataRGBA);
+
+        // Get synchronized timestamp and pose (monotonic; the driver maps it to CLOCK_MONOTONIC)
+        long timestampNs = QuestVuforiaBridge.TimestampNs();
+        Pose cameraPose = cameraAccess.GetCameraPose();
 
-        // Flip Y-axis if needed
-        if (flipImageVertically)
+        // Camera rig: hand the lens offset to the driver once and feed the raw head pose
+        Pose fedPose = cameraPose;
+        if (composeCameraPoseNatively && Camera.main != null)
         {
-            FlipImageVertically(imageDataRGB, width, height);
+            Transform head = Camera.main.transform;
+            if (!extrinsicsSet)
+            {
+                Quaternion headInverse = Quaternion.Inverse(head.rotation);
+                extrinsicsSet = QuestVuforiaBridge.SetCameraExtrinsics(rigCameraIndex,
+                    headInverse * (cameraPose.position - head.position), headInverse * cameraPose.rotation);
+            }
+            fedPose = new Pose(head.position, head.rotation);
         }
 
-        // Get synchronized timestamp and pose
-        DateTime currentTime = DateTime.Now;
-        long timestampNs = currentTime.Ticks * 100;
-        Pose cameraPose = cameraAccess.GetCameraPose();
-
         // Choose rotation based on setting
-        Quaternion rotation = useCameraRotation ? cameraPose.rotation : Quaternion.identity;
+        Quaternion rotation = useCameraRotation ? fedPose.rotation : Quaternion.identity;
 
         // Debug pose info
         if (showPoseDebug && frameCount % 30 == 0)
@@ -210,40 +472,150 @@ public class MetaCameraProvider : MonoBehaviour
         }
 
         // Feed to Vuforia (pose first, then frame with same timestamp)
-        QuestVuforiaBridge.FeedDevicePose(cameraPose.position, rotation, timestampNs);
-        QuestVuforiaBridge.FeedCameraFrame(imageDataRGB, width, height, null, timestampNs);
+        QuestVuforiaBridge.FeedDevicePose(fedPose.position, rotation, GetHeadTrackingConfidence(), timestampNs);
+        QuestVuforiaBridge.FeedCameraFrameRGBA(imageDataRGBA, width, height, flipImageVertically, null, timestampNs);
+
+        if (stereoEnabled && secondaryCameraAccess.IsPlaying)
+        {
+            ProcessSecondaryFrame(cameraPose, timestampNs);
+        }
 
         frameCount++;
     }
 
-    private void FlipImageVertically(byte[] imageData, int width, int height)
+    private void LogPipelineStats(long[] stats)
+    {
+        var line = new System.Text.StringBuilder("Pipeline p50/p95/p99 ms:");
+        for (int stage = 0; stage < QuestVuforiaBridge.PipelineStageCount; stage++)
+        {
+            int i = stage * 4;
+            line.Append($" {(QuestVuforiaBridge.PipelineStage)stage} {stats[i + 1] / 1e6:F1}/{stats[i + 2] / 1e6:F1}/{stats[i + 3] / 1e6:F1}");
+        }
+        int c = QuestVuforiaBridge.PipelineStageCount * 4;
+        double seconds = stats[c + 4] / 1e9;
+        if (seconds > 0)
+        {
+            line.Append($" | fed {stats[c] / seconds:F1} fps, delivered {stats[c + 1] / seconds:F1} fps, " +
+                        $"poses fed {stats[c + 2] / seconds:F1}/s, delivered {stats[c + 3] / seconds:F1}/s");
+        }
+        Log(line.ToString());
+    }
+
+    private void ProcessSecondaryFrame(Pose primaryPose, long timestampNs)
     {
-        int stride = width * 3;
-        byte[] rowBuffer = new byte[stride];
+        NativeArray<Color32> pixels = secondaryCameraAccess.GetColors();
+        if (!pixels.IsCreated || pixels.Length != width * height)
+        {
+            return;
+        }
+        pixels.Reinterpret<byte>(4).CopyTo(secondaryImageDataRGBA);
+
+        Pose secondaryPose = secondaryCameraAccess.GetCameraPose();
+        if (!secondaryExtrinsicsSet && Camera.main != null)
+        {
+            Transform head = Camera.main.transform;
+            Quaternion headInverse = Quaternion.Inverse(head.rotation);
+            secondaryExtrinsicsSet = QuestVuforiaBridge.SetCameraExtrinsics(SecondaryCameraIndex,
+                headInverse * (secondaryPose.position - head.position), headInverse * secondaryPose.rotation);
+        }
 
-        for (int row = 0; row < height / 2; row++)
+        if (stereoPolicy == QuestVuforiaBridge.StereoPolicy.BestCamera)
         {
-            int topRow = row * stride;
-            int bottomRow = (height - 1 - row) * stride;
+            QuestVuforiaBridge.SetCameraTargetScore(rigCameraIndex, TargetScore(cameraAccess, primaryPose));
+            QuestVuforiaBridge.SetCameraTargetScore(SecondaryCameraIndex, TargetScore(secondaryCameraAccess, secondaryPose));
+        }
+
+        // Same head pose sample and capture time as the primary frame (both cameras are read in
+        // the same Update), so stereo policies pick between cameras without raising the frame rate;
+        // the driver composes this camera's pose
+        QuestVuforiaBridge.FeedCameraFrameRGBA(SecondaryCameraIndex, secondaryImageDataRGBA, width, height,
+                                               flipImageVertically, null, timestampNs);
+    }
 
-            Array.Copy(imageData, topRow, rowBuffer, 0, stride);
-            Array.Copy(imageData, bottomRow, imageData, topRow, stride);
-            Array.Copy(rowBuffer, 0, imageData, bottomRow, stride);
+    private float TargetScore(PassthroughCameraAccess access, Pose cameraPose)
+    {
+        // Best over tracked targets: 1 at the image centre, 0 at the border or behind the camera
+        if (trackedTargets == null) return 0f;
+
+        var intrinsics = access.Intrinsics;
+        Vector2 halfSize = new Vector2(intrinsics.SensorResolution.x, intrinsics.SensorResolution.y) * 0.5f;
+        Quaternion cameraInverse = Quaternion.Inverse(cameraPose.rotation);
+        float best = 0f;
+        foreach (var target in trackedTargets)
+        {
+            if (target == null || target.TargetStatus.Status == Status.NO_POSE) continue;
+
+            Vector3 local = cameraInverse * (target.transform.position - cameraPose.position);
+            if (local.z <= 0f) continue;
+
+            float u = intrinsics.FocalLength.x * local.x / local.z + intrinsics.PrincipalPoint.x;
+            float v = intrinsics.PrincipalPoint.y - intrinsics.FocalLength.y * local.y / local.z;
+            float offset = Mathf.Max(Mathf.Abs(u - halfSize.x) / halfSize.x, Mathf.Abs(v - halfSize.y) / halfSize.y);
+            best = Mathf.Max(best, 1f - offset);
         }
+        return Mathf.Clamp01(best);
+    }
+
+    private static float GetHeadTrackingConfidence()
+    {
+        // Full 6DoF = 1, rotation only = 0.5, lost = 0
+        var head = UnityEngine.XR.InputDevices.GetDeviceAtXRNode(UnityEngine.XR.XRNode.Head);
+        if (!head.isValid ||
+            !head.TryGetFeatureValue(UnityEngine.XR.CommonUsages.trackingState, out UnityEngine.XR.InputTrackingState state))
+        {
+            return 1f;
+        }
+
+        bool position = (state & UnityEngine.XR.InputTrackingState.Position) != 0;
+        bool rotation = (state & UnityEngine.XR.InputTrackingState.Rotation) != 0;
+        return position && rotation ? 1f : (rotation ? 0.5f : 0f);
     }
 
     public void StopCamera()
     {
         if (!isRunning) return;
 
+        if (trackedTargets != null)
+        {
+            foreach (var target in trackedTargets)
+            {
+                if (target != null)
+                {
+                    target.OnTargetStatusChanged -= OnTargetStatusChanged;
+                }
+            }
+        }
+
+        if (recordTrace)
+        {
+            DumpTrace();
+        }
+
         isRunning = false;
         if (cameraAccess != null && cameraAccess.enabled)
         {
             cameraAccess.enabled = false;
         }
+        if (secondaryCameraAccess != null && secondaryCameraAccess.enabled)
+        {
+            secondaryCameraAccess.enabled = false;
+        }
+        stereoEnabled = false;
         Log("Camera stopped");
     }
 
+    /// <summary>
+    /// Write the native pipeline timeline recorded so far to persistentDataPath
+    /// (requires recordTrace). Pull it with adb and open it in Perfetto.
+    /// </summary>
+    public void DumpTrace()
+    {
+        string path = System.IO.Path.Combine(Application.persistentDataPath,
+            $"quforia_trace_{DateTime.Now:yyyyMMdd_HHmmss}.json");
+        int events = QuestVuforiaBridge.DumpTrace(path);
+        Log(events >= 0 ? $"Trace: {events} events written to {path}" : "Trace dump failed");
+    }
+
     private void OnDestroy() => StopCamera();
 
     private void OnApplicationPause(bool isPaused)
@@ -252,12 +624,21 @@ public class MetaCameraProvider : MonoBehaviour
 
         if (isPaused && cameraAccess.enabled)
         {
+            if (recordTrace && isRunning)
+            {
+                DumpTrace();
+            }
             cameraAccess.enabled = false;
         }
         else if (!isPaused && isRunning && !cameraAccess.enabled)
         {
             cameraAccess.enabled = true;
         }
+
+        if (stereoEnabled)
+        {
+            secondaryCameraAccess.enabled = !isPaused;
+        }
     }
 
     private void Log(string message)
@@ -0,0 +1,123 @@
+using System.Collections.Generic;
+using UnityEngine;
+
+/// <summary>
+/// Backs the driver's native anchors with Meta spatial anchors.
+/// Anchors Vuforia creates are mirrored as OVRSpatialAnchors; their poses are reported
+/// back every frame, so after a relocalization Vuforia receives one batched anchor
+/// update and restores anchored content without a new detection pass.
+/// </summary>
+public class QuestAnchorSync : MonoBehaviour
+{
+    [SerializeField] private bool enableDebugLogs = false;
+    [SerializeField] private bool showAnchorStats = false;
+    [SerializeField] private float statsInterval = 1.0f;
+
+    private readonly Dictionary<string, OVRSpatialAnchor> anchors = new Dictionary<string, OVRSpatialAnchor>();
+    private readonly List<KeyValuePair<string, Pose>> created = new List<KeyValuePair<string, Pose>>();
+    private readonly List<string> reportedUuids = new List<string>();
+    private readonly List<Pose> reportedPoses = new List<Pose>();
+    private readonly List<string> lost = new List<string>();
+    private readonly bool[] known = new bool[QuestVuforiaBridge.MaxAnchors];
+    private float lastStatsTime;
+
+    private void Update()
+    {
+        if (!QuestVuforiaBridge.IsDriverInitialized()) return;
+
+        CreateSpatialAnchors();
+        ReportAnchorPoses();
+
+        if (showAnchorStats && Time.time - lastStatsTime >= statsInterval)
+        {
+            long[] stats = QuestVuforiaBridge.GetAnchorStats();
+            if (stats != null)
+            {
+                Log($"Anchors: {stats[0]} live, {stats[2]} reported in {stats[1]} batches");
+            }
+            lastStatsTime = Time.time;
+        }
+    }
+
+    private void CreateSpatialAnchors()
+    {
+        created.Clear();
+        if (!QuestVuforiaBridge.GetCreatedAnchors(created)) return;
+
+        foreach (var pair in created)
+        {
+            var anchorObject = new GameObject($"Quforia Anchor {pair.Key}");
+            anchorObject.transform.SetParent(transform, false);
+            anchorObject.transform.SetPositionAndRotation(pair.Value.position, pair.Value.rotation);
+            anchors[pair.Key] = anchorObject.AddComponent<OVRSpatialAnchor>();
+            Log($"Spatial anchor requested for {pair.Key}");
+        }
+    }
+
+    private void ReportAnchorPoses()
+    {
+        if (anchors.Count == 0) return;
+
+        reportedUuids.Clear();
+        reportedPoses.Clear();
+        lost.Clear();
+        foreach (var pair in anchors)
+        {
+            // The component destroys itself if the spatial anchor could not be created
+            if (pair.Value == null)
+            {
+                lost.Add(pair.Key);
+                continue;
+            }
+            if (!pair.Value.Localized) continue;
+
+            Transform anchorTransform = pair.Value.transform;
+            reportedUuids.Add(pair.Key);
+            reportedPoses.Add(new Pose(anchorTransform.position, anchorTransform.rotation));
+        }
+
+        foreach (string uuid in lost)
+        {
+            QuestVuforiaBridge.DropAnchor(uuid);
+            anchors.Remove(uuid);
+            Log($"Spatial anchor lost for {uuid}");
+        }
+
+        if (reportedUuids.Count == 0 ||
+            !QuestVuforiaBridge.UpdateAnchors(reportedUuids, reportedPoses, known))
+        {
+            return;
+        }
+
+        // Anchors Vuforia removed no longer need a spatial anchor
+        for (int i = 0; i < Mathf.Min(reportedUuids.Count, known.Length); i++)
+        {
+            if (known[i]) continue;
+
+            string uuid = reportedUuids[i];
+            Destroy(anchors[uuid].gameObject);
+            anchors.Remove(uuid);
+            Log($"Anchor {uuid} removed by Vuforia");
+        }
+    }
+
+    private void OnDestroy()
+    {
+        foreach (var anchor in anchors.Values)
+        {
+            if (anchor != null)
+            {
+                Destroy(anchor.gameObject);
+            }
+        }
+        anchors.Clear();
+    }
+
+    private void Log(string message)
+    {
+        if (enableDebugLogs)
+        {
+            Debug.Log($"[Quforia] {message}");
+        }
+    }
+}
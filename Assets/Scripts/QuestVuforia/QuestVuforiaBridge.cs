@@ -1,5 +1,7 @@
 using System;
+using System.Collections.Generic;
 using System.Runtime.InteropServices;
+using System.Text;
 using UnityEngine;
 
 /// <summary>
@@ -9,15 +11,212 @@ public static class QuestVuforiaBridge
 {
     private const string LibraryName = "quforia";
 
+    // Reused by GetPoseAt to avoid per-call allocations (main thread only)
+    private static readonly float[] poseQueryBuffer = new float[7];
+
+    /// <summary>
+    /// Native anchor table capacity and UUID size (36 characters + terminator).
+    /// </summary>
+    public const int MaxAnchors = 64;
+    public const int AnchorUuidLength = 37;
+
+    // Reused by the anchor calls (main thread only)
+    private static readonly byte[] anchorUuidBuffer = new byte[MaxAnchors * AnchorUuidLength];
+    private static readonly float[] anchorPoseBuffer = new float[MaxAnchors * 7];
+    private static readonly int[] anchorKnownBuffer = new int[MaxAnchors];
+
+    /// <summary>
+    /// Target tracking status reported to the driver (drives adaptive resolution).
+    /// </summary>
+    public enum TrackingStatus
+    {
+        Searching = 0,
+        Tracked = 1,
+        Extended = 2
+    }
+
+    /// <summary>
+    /// Motion model used to extrapolate poses past the newest tracker sample.
+    /// </summary>
+    public enum PredictionModel
+    {
+        ConstantVelocity = 0,
+        ConstantAcceleration = 1
+    }
+
+    /// <summary>
+    /// Low-light normalization applied to dim frames before delivery.
+    /// </summary>
+    public enum LowLightMode
+    {
+        Off = 0,
+        Stretch = 1,
+        Clahe = 2
+    }
+
+    /// <summary>
+    /// Which rig camera's frames are delivered to Vuforia when both cameras are fed.
+    /// </summary>
+    public enum StereoPolicy
+    {
+        ActiveCamera = 0,
+        Alternate = 1,
+        BestCamera = 2
+    }
+
+    /// <summary>
+    /// Clock of fed and queried timestamps. The driver stamps every frame and pose into
+    /// CLOCK_MONOTONIC, estimating offset and drift for clocks it cannot read itself.
+    /// </summary>
+    public enum ClockDomain
+    {
+        Monotonic = 0,
+        Realtime = 1,
+        Estimated = 2,
+        Arrival = 3
+    }
+
     [DllImport(LibraryName)]
     private static extern bool nativeSetCameraIntrinsics(float[] intrinsics, int length);
 
+    [DllImport(LibraryName)]
+    private static extern bool nativeSetCameraIntrinsicsForCamera(int cameraId, float[] intrinsics, int length);
+
     [DllImport(LibraryName)]
     private static extern bool nativeFeedDevicePose(float[] position, float[] rotation, long timestamp);
 
+    [DllImport(LibraryName)]
+    private static extern bool nativeFeedDevicePoseWithConfidence(float[] position, float[] rotation, float confidence, long timestamp);
+
     [DllImport(LibraryName)]
     private static extern bool nativeFeedCameraFrame(byte[] imageData, int width, int height, float[] intrinsics, int intrinsicsLength, long timestamp);
 
+    [DllImport(LibraryName)]
+    private static extern bool nativeFeedCameraFrameRGBA(byte[] imageData, int width, int height, bool flipVertically, float[] intrinsics, int intrinsicsLength, long timestamp);
+
+    [DllImport(LibraryName)]
+    private static extern bool nativeFeedCameraFrameRGBAForCamera(int cameraId, byte[] imageData, int width, int height, bool flipVertically, float[] intrinsics, int intrinsicsLength, long timestamp);
+
+    [DllImport(LibraryName)]
+    private static extern bool nativeGetPoseAt(long timestamp, float[] pose, int length);
+
+    [DllImport(LibraryName)]
+    private static extern bool nativeSetPoseTolerance(int toleranceMs);
+
+    [DllImport(LibraryName)]
+    private static extern bool nativeSetPosePrediction(bool enabled, int model, int maxHorizonMs, int unreliableHorizonMs);
+
+    [DllImport(LibraryName)]
+    private static extern bool nativeGetPosePredictionStats(long[] stats, int length);
+
+    [DllImport(LibraryName)]
+    private static extern bool nativeSetPoseJoin(bool enabled, int timeoutMs);
+
+    [DllImport(LibraryName)]
+    private static extern bool nativeGetPoseJoinStats(long[] stats, int length);
+
+    [DllImport(LibraryName)]
+    private static extern bool nativeSetPoseStreaming(bool enabled);
+
+    [DllImport(LibraryName)]
+    private static extern bool nativeSetCameraExtrinsics(int cameraId, float[] position, float[] rotation);
+
+    [DllImport(LibraryName)]
+    private static extern bool nativeClearCameraExtrinsics();
+
+    [DllImport(LibraryName)]
+    private static extern bool nativeSetActiveCamera(int cameraId);
+
+    [DllImport(LibraryName)]
+    private static extern bool nativeSetStereoPolicy(int policy);
+
+    [DllImport(LibraryName)]
+    private static extern bool nativeGetCreatedAnchors(byte[] uuids, float[] poses, int maxAnchors, out int count);
+
+    [DllImport(LibraryName)]
+    private static extern bool nativeUpdateAnchors(byte[] uuids, float[] poses, int[] known, int count);
+
+    [DllImport(LibraryName)]
+    private static extern bool nativeDropAnchor(string uuid);
+
+    [DllImport(LibraryName)]
+    private static extern bool nativeGetAnchorStats(long[] stats, int length);
+
+    [DllImport(LibraryName)]
+    private static extern bool nativeSetCameraTargetScore(int cameraId, float score);
+
+    [DllImport(LibraryName)]
+    private static extern bool nativeGetStereoStats(long[] stats, int length);
+
+    [DllImport(LibraryName)]
+    private static extern bool nativeSetClockDomain(int domain);
+
+    [DllImport(LibraryName)]
+    private static extern bool nativeGetClockStats(long[] stats, int length);
+
+    [DllImport(LibraryName)]
+    private static extern bool nativeGetPipelineStats(long[] stats, int length);
+
+    [DllImport(LibraryName)]
+    private static extern bool nativeResetPipelineStats();
+
+    [DllImport(LibraryName)]
+    private static extern bool nativeSetTraceEnabled(bool enabled);
+
+    [DllImport(LibraryName)]
+    private static extern bool nativeDumpTrace(string path, out int count);
+
+    [DllImport(LibraryName)]
+    private static extern bool nativeSetLogLevel(int level);
+
+    [DllImport(LibraryName)]
+    private static extern bool nativeGetLogStats(long[] stats, int length);
+
+    [DllImport(LibraryName)]
+    private static extern bool nativeSetPoseValidation(bool enabled, float minConfidence, int maxGapMs, float jumpDistance, float jumpAngleDeg, float maxAngularVelocityDeg, int settleMs);
+
+    [DllImport(LibraryName)]
+    private static extern bool nativeGetPoseValidityStats(long[] stats, int length);
+
+    [DllImport(LibraryName)]
+    private static extern bool nativeSetCropWindow(bool enabled, float x, float y, float width, float height, bool upscale);
+
+    [DllImport(LibraryName)]
+    private static extern bool nativeSetUndistortionEnabled(bool enabled);
+
+    [DllImport(LibraryName)]
+    private static extern bool nativeSetLowLightNormalization(int mode, int darkThreshold, float maxGain);
+
+    [DllImport(LibraryName)]
+    private static extern bool nativeSetGrayscaleOnly(bool enabled);
+
+    [DllImport(LibraryName)]
+    private static extern bool nativeSetAdaptiveResolution(bool enabled, float reducedScale, int holdMs);
+
+    [DllImport(LibraryName)]
+    private static extern bool nativeSetTrackingStatus(int status);
+
+    [DllImport(LibraryName)]
+    private static extern bool nativeGetAdaptiveResolutionStats(long[] stats, int length);
+
+    [DllImport(LibraryName)]
+    private static extern bool nativeSetMotionSkipping(bool enabled, float maxAngularVelocity, float maxLinearVelocity, int maxConsecutiveSkips);
+
+    [DllImport(LibraryName)]
+    private static extern bool nativeGetMotionSkipStats(long[] stats, int length);
+
+    [DllImport(LibraryName)]
+    private static extern bool nativeSetSceneChangeGating(bool enabled, float lumaThreshold, float translationThreshold, float rotationThreshold, float floorFps);
+
+    [DllImport(LibraryName)]
+    private static extern bool nativeGetSceneChangeStats(long[] stats, int length);
+
+    [DllImport(LibraryName)]
+    private static extern bool nativeSetBrightnessGating(bool enabled, int minMeanLuma);
+
+    [DllImport(LibraryName)]
+    private static extern bool nativeSetFrameSelection(bool enabled, int windowMs);
+
     [DllImport(LibraryName)]
     private static extern bool nativeIsDriverInitialized();
 
@@ -35,6 +234,20 @@ public static class QuestVuforiaBridge
         return nativeSetCameraIntrinsics(intrinsics, intrinsics.Length);
     }
 
+    /// <summary>
+    /// Set intrinsics for one rig camera (0 = left, 1 = right) when feeding both cameras.
+    /// </summary>
+    public static bool SetCameraIntrinsics(int cameraId, float[] intrinsics)
+    {
+        if (intrinsics == null || intrinsics.Length < 14)
+        {
+            Debug.LogError("[Quforia] Invalid intrinsics array");
+            return false;
+        }
+
+        return nativeSetCameraIntrinsicsForCamera(cameraId, intrinsics, intrinsics.Length);
+    }
+
     /// <summary>
     /// Feed device pose to driver. Call BEFORE FeedCameraFrame.
     /// </summary>
@@ -45,6 +258,16 @@ public static class QuestVuforiaBridge
         return nativeFeedDevicePose(pos, rot, timestamp);
     }
 
+    /// <summary>
+    /// Feed device pose with the tracker's confidence (0-1). Call BEFORE FeedCameraFrame.
+    /// </summary>
+    public static bool FeedDevicePose(Vector3 position, Quaternion rotation, float confidence, long timestamp)
+    {
+        float[] pos = new float[] { position.x, position.y, position.z };
+        float[] rot = new float[] { rotation.x, rotation.y, rotation.z, rotation.w };
+        return nativeFeedDevicePoseWithConfidence(pos, rot, confidence, timestamp);
+    }
+
     /// <summary>
     /// Feed camera frame to driver. Call AFTER FeedDevicePose.
     /// </summary>
@@ -60,6 +283,476 @@ public static class QuestVuforiaBridge
         return nativeFeedCameraFrame(imageData, width, height, intrinsics, intrinsicsLength, timestamp);
     }
 
+    /// <summary>
+    /// Feed RGBA32 camera frame to driver. Repacking and flipping are done natively.
+    /// Call AFTER FeedDevicePose.
+    /// </summary>
+    public static bool FeedCameraFrameRGBA(byte[] imageData, int width, int height, bool flipVertically, float[] intrinsics, long timestamp)
+    {
+        if (imageData == null || imageData.Length != width * height * 4)
+        {
+            Debug.LogError("[Quforia] Invalid image data");
+            return false;
+        }
+
+        int intrinsicsLength = intrinsics?.Length ?? 0;
+        return nativeFeedCameraFrameRGBA(imageData, width, height, flipVertically, intrinsics, intrinsicsLength, timestamp);
+    }
+
+    /// <summary>
+    /// Feed an RGBA32 frame captured by a specific rig camera (0 = left, 1 = right).
+    /// Call AFTER FeedDevicePose.
+    /// </summary>
+    public static bool FeedCameraFrameRGBA(int cameraId, byte[] imageData, int width, int height, bool flipVertically, float[] intrinsics, long timestamp)
+    {
+        if (imageData == null || imageData.Length != width * height * 4)
+        {
+            Debug.LogError("[Quforia] Invalid image data");
+            return false;
+        }
+
+        int intrinsicsLength = intrinsics?.Length ?? 0;
+        return nativeFeedCameraFrameRGBAForCamera(cameraId, imageData, width, height, flipVertically, intrinsics, intrinsicsLength, timestamp);
+    }
+
+    /// <summary>
+    /// Look up the device pose at a past timestamp (e.g. a frame's capture time) from the
+    /// native pose history, interpolated between samples. Returns false if no sample is
+    /// within the pose tolerance. Use it to re-project results to display time.
+    /// </summary>
+    public static bool GetPoseAt(long timestamp, out Pose pose)
+    {
+        if (!nativeGetPoseAt(timestamp, poseQueryBuffer, poseQueryBuffer.Length))
+        {
+            pose = Pose.identity;
+            return false;
+        }
+
+        float[] p = poseQueryBuffer;
+        pose = new Pose(new Vector3(p[0], p[1], p[2]), new Quaternion(p[3], p[4], p[5], p[6]));
+        return true;
+    }
+
+    /// <summary>
+    /// Max distance (ms) between a frame and the nearest pose sample for the frame to get a pose.
+    /// </summary>
+    public static bool SetPoseTolerance(int toleranceMs)
+    {
+        return nativeSetPoseTolerance(toleranceMs);
+    }
+
+    /// <summary>
+    /// Extrapolate poses for frames newer than the newest pose sample (up to maxHorizonMs).
+    /// Poses predicted further than unreliableHorizonMs are reported as unreliable.
+    /// </summary>
+    public static bool SetPosePrediction(bool enabled, PredictionModel model, int maxHorizonMs, int unreliableHorizonMs)
+    {
+        return nativeSetPosePrediction(enabled, (int)model, maxHorizonMs, unreliableHorizonMs);
+    }
+
+    /// <summary>
+    /// Get pose prediction stats: [lookups, predicted, avgHorizonUs, maxHorizonUs].
+    /// </summary>
+    public static long[] GetPosePredictionStats()
+    {
+        long[] stats = new long[4];
+        return nativeGetPosePredictionStats(stats, stats.Length) ? stats : null;
+    }
+
+    /// <summary>
+    /// Hold each frame up to timeoutMs for a pose sample at or after its timestamp,
+    /// delivering the pose before the frame. On timeout the pose is extrapolated.
+    /// </summary>
+    public static bool SetPoseJoin(bool enabled, int timeoutMs)
+    {
+        return nativeSetPoseJoin(enabled, timeoutMs);
+    }
+
+    /// <summary>
+    /// Get late-pose join stats: [joins, waits, timeouts, avgWaitUs, orderTimeouts].
+    /// </summary>
+    public static long[] GetPoseJoinStats()
+    {
+        long[] stats = new long[5];
+        return nativeGetPoseJoinStats(stats, stats.Length) ? stats : null;
+    }
+
+    /// <summary>
+    /// Forward every pose sample to Vuforia at tracker rate instead of one per camera frame.
+    /// Each frame's pose is still delivered immediately before the frame.
+    /// </summary>
+    public static bool SetPoseStreaming(bool enabled)
+    {
+        return nativeSetPoseStreaming(enabled);
+    }
+
+    /// <summary>
+    /// Set a rig camera's pose relative to the head (head-local). Once set, feed the raw
+    /// head pose; the camera pose is composed natively for each frame and pose.
+    /// </summary>
+    public static bool SetCameraExtrinsics(int cameraId, Vector3 position, Quaternion rotation)
+    {
+        float[] pos = new float[] { position.x, position.y, position.z };
+        float[] rot = new float[] { rotation.x, rotation.y, rotation.z, rotation.w };
+        return nativeSetCameraExtrinsics(cameraId, pos, rot);
+    }
+
+    /// <summary>
+    /// Clear all rig extrinsics so fed poses are treated as camera poses again.
+    /// </summary>
+    public static bool ClearCameraExtrinsics()
+    {
+        return nativeClearCameraExtrinsics();
+    }
+
+    /// <summary>
+    /// Select the rig camera (0 = left, 1 = right) that subsequently fed frames come from.
+    /// </summary>
+    public static bool SetActiveCamera(int cameraId)
+    {
+        return nativeSetActiveCamera(cameraId);
+    }
+
+    /// <summary>
+    /// Choose how frames from both rig cameras are delivered: the active camera only,
+    /// alternating left/right, or whichever camera sees the tracked target best.
+    /// Vuforia still receives frames at the camera mode rate.
+    /// </summary>
+    public static bool SetStereoPolicy(StereoPolicy policy)
+    {
+        return nativeSetStereoPolicy((int)policy);
+    }
+
+    /// <summary>
+    /// Report how well a rig camera currently sees the tracked target (0-1).
+    /// Drives StereoPolicy.BestCamera.
+    /// </summary>
+    public static bool SetCameraTargetScore(int cameraId, float score)
+    {
+        return nativeSetCameraTargetScore(cameraId, score);
+    }
+
+    /// <summary>
+    /// Stereo delivery stats: [camera 0 picks, camera 1 picks, camera switches].
+    /// </summary>
+    public static long[] GetStereoStats()
+    {
+        long[] stats = new long[3];
+        return nativeGetStereoStats(stats, stats.Length) ? stats : null;
+    }
+
+    /// <summary>
+    /// Current time in nanoseconds on a monotonic clock, for fed timestamps
+    /// (declare it with SetClockDomain(ClockDomain.Estimated)).
+    /// </summary>
+    public static long TimestampNs()
+    {
+        return (long)(System.Diagnostics.Stopwatch.GetTimestamp() * (1e9 / System.Diagnostics.Stopwatch.Frequency));
+    }
+
+    /// <summary>
+    /// Declare the clock of fed and queried timestamps.
+    /// </summary>
+    public static bool SetClockDomain(ClockDomain domain)
+    {
+        return nativeSetClockDomain((int)domain);
+    }
+
+    /// <summary>
+    /// Clock mapping stats: [offset ns, drift ppb, resyncs, samples, average frame age ns].
+    /// </summary>
+    public static long[] GetClockStats()
+    {
+        long[] stats = new long[5];
+        return nativeGetClockStats(stats, stats.Length) ? stats : null;
+    }
+
+    /// <summary>
+    /// Frame pipeline stages timed by the driver, in GetPipelineStats order.
+    /// </summary>
+    public enum PipelineStage
+    {
+        UnitySubmit = 0,
+        Convert = 1,
+        QueueWait = 2,
+        PoseLookup = 3,
+        VuforiaCallback = 4,
+        Total = 5
+    }
+
+    public const int PipelineStageCount = 6;
+
+    /// <summary>
+    /// Pipeline latency and throughput: for each PipelineStage [samples, p50 ns, p95 ns, p99 ns]
+    /// at index stage * 4, then [frames fed, frames delivered, poses fed, poses delivered, elapsed ns].
+    /// </summary>
+    public static long[] GetPipelineStats()
+    {
+        long[] stats = new long[PipelineStageCount * 4 + 5];
+        return nativeGetPipelineStats(stats, stats.Length) ? stats : null;
+    }
+
+    /// <summary>
+    /// Restart the pipeline latency histograms and throughput counters.
+    /// </summary>
+    public static bool ResetPipelineStats()
+    {
+        return nativeResetPipelineStats();
+    }
+
+    /// <summary>
+    /// Start or stop recording the native pipeline timeline. Starting begins a new capture.
+    /// </summary>
+    public static bool SetTraceEnabled(bool enabled)
+    {
+        return nativeSetTraceEnabled(enabled);
+    }
+
+    /// <summary>
+    /// Write the recorded timeline as Chrome trace-event JSON (open in chrome://tracing or
+    /// Perfetto). Returns the number of events written, or -1 on failure.
+    /// </summary>
+    public static int DumpTrace(string path)
+    {
+        return nativeDumpTrace(path, out int count) ? count : -1;
+    }
+
+    /// <summary>
+    /// Lowest native log level written to logcat. Native logs are formatted on a background
+    /// thread; levels compiled out of the build (Debug in release builds) stay out.
+    /// </summary>
+    public enum LogLevel
+    {
+        Debug = 3,
+        Info = 4,
+        Warn = 5,
+        Error = 6
+    }
+
+    /// <summary>
+    /// Set the lowest native log level (can be called before the driver is initialized).
+    /// </summary>
+    public static bool SetLogLevel(LogLevel level)
+    {
+        return nativeSetLogLevel((int)level);
+    }
+
+    /// <summary>
+    /// Native logging stats: [messages written, messages dropped because the log ring was full].
+    /// </summary>
+    public static long[] GetLogStats()
+    {
+        long[] stats = new long[2];
+        return nativeGetLogStats(stats, stats.Length) ? stats : null;
+    }
+
+    /// <summary>
+    /// Classify delivered poses: low confidence or a large lookup gap makes a pose unreliable,
+    /// pose jumps (relocalization) and tracking loss report RELOCALIZING for settleMs,
+    /// and rotation faster than maxAngularVelocityDeg reports EXCESSIVE_MOTION.
+    /// </summary>
+    public static bool SetPoseValidation(bool enabled, float minConfidence, int maxGapMs, float jumpDistance, float jumpAngleDeg, float maxAngularVelocityDeg, int settleMs)
+    {
+        return nativeSetPoseValidation(enabled, minConfidence, maxGapMs, jumpDistance, jumpAngleDeg, maxAngularVelocityDeg, settleMs);
+    }
+
+    /// <summary>
+    /// Get pose validity stats: [classified, unreliable, initializing, relocalizing, excessiveMotion, relocalizations].
+    /// </summary>
+    public static long[] GetPoseValidityStats()
+    {
+        long[] stats = new long[6];
+        return nativeGetPoseValidityStats(stats, stats.Length) ? stats : null;
+    }
+
+    /// <summary>
+    /// Crop frames natively to a window (normalized, top-left origin) before delivery.
+    /// With upscale, the window is scaled back up to the camera mode size.
+    /// </summary>
+    public static bool SetCropWindow(bool enabled, Rect window, bool upscale)
+    {
+        return nativeSetCropWindow(enabled, window.x, window.y, window.width, window.height, upscale);
+    }
+
+    /// <summary>
+    /// Rectify frames natively using the distortion coefficients in the intrinsics (d0-d7).
+    /// </summary>
+    public static bool SetUndistortionEnabled(bool enabled)
+    {
+        return nativeSetUndistortionEnabled(enabled);
+    }
+
+    /// <summary>
+    /// Brighten frames whose mean luma is below darkThreshold (0-255) before delivery.
+    /// maxGain caps the contrast gain (stretch) or the clip limit (CLAHE).
+    /// </summary>
+    public static bool SetLowLightNormalization(LowLightMode mode, int darkThreshold, float maxGain)
+    {
+        return nativeSetLowLightNormalization((int)mode, darkThreshold, maxGain);
+    }
+
+    /// <summary>
+    /// Deliver luma only in NV12/NV21/YUV420P modes (chroma held at neutral grey).
+    /// </summary>
+    public static bool SetGrayscaleOnly(bool enabled)
+    {
+        return nativeSetGrayscaleOnly(enabled);
+    }
+
+    /// <summary>
+    /// Enable adaptive resolution: frames drop to reducedScale of the camera mode
+    /// after tracking has been stable for holdMs, and return to full size when searching.
+    /// </summary>
+    public static bool SetAdaptiveResolution(bool enabled, float reducedScale, int holdMs)
+    {
+        return nativeSetAdaptiveResolution(enabled, reducedScale, holdMs);
+    }
+
+    /// <summary>
+    /// Report current target tracking status to the driver.
+    /// </summary>
+    public static bool SetTrackingStatus(TrackingStatus status)
+    {
+        return nativeSetTrackingStatus((int)status);
+    }
+
+    /// <summary>
+    /// Get adaptive resolution metrics: [msAtFull, msAtReduced, switchCount].
+    /// </summary>
+    public static long[] GetAdaptiveResolutionStats()
+    {
+        long[] stats = new long[3];
+        return nativeGetAdaptiveResolutionStats(stats, stats.Length) ? stats : null;
+    }
+
+    /// <summary>
+    /// Skip frames captured during fast head motion (deg/s, m/s thresholds).
+    /// Poses are still delivered for skipped frames.
+    /// </summary>
+    public static bool SetMotionSkipping(bool enabled, float maxAngularVelocity, float maxLinearVelocity, int maxConsecutiveSkips)
+    {
+        return nativeSetMotionSkipping(enabled, maxAngularVelocity, maxLinearVelocity, maxConsecutiveSkips);
+    }
+
+    /// <summary>
+    /// Get motion skipping counters: [framesEvaluated, framesSkipped].
+    /// </summary>
+    public static long[] GetMotionSkipStats()
+    {
+        long[] stats = new long[2];
+        return nativeGetMotionSkipStats(stats, stats.Length) ? stats : null;
+    }
+
+    /// <summary>
+    /// Throttle delivery to floorFps while the image (mean luma difference) and the
+    /// headset pose (m, deg) stay below the thresholds; any change restores full rate.
+    /// </summary>
+    public static bool SetSceneChangeGating(bool enabled, float lumaThreshold, float translationThreshold, float rotationThreshold, float floorFps)
+    {
+        return nativeSetSceneChangeGating(enabled, lumaThreshold, translationThreshold, rotationThreshold, floorFps);
+    }
+
+    /// <summary>
+    /// Get static-scene throttling counters: [framesEvaluated, framesSkipped].
+    /// </summary>
+    public static long[] GetSceneChangeStats()
+    {
+        long[] stats = new long[2];
+        return nativeGetSceneChangeStats(stats, stats.Length) ? stats : null;
+    }
+
+    /// <summary>
+    /// Withhold frames darker than minMeanLuma (0-255); their poses are reported as insufficient light.
+    /// </summary>
+    public static bool SetBrightnessGating(bool enabled, int minMeanLuma)
+    {
+        return nativeSetBrightnessGating(enabled, minMeanLuma);
+    }
+
+    /// <summary>
+    /// Deliver the sharpest recent frame (within windowMs of the newest) instead of the newest.
+    /// </summary>
+    public static bool SetFrameSelection(bool enabled, int windowMs)
+    {
+        return nativeSetFrameSelection(enabled, windowMs);
+    }
+
+    /// <summary>
+    /// Take the anchors Vuforia created since the last call (UUID and pose) so they
+    /// can be backed by spatial anchors. Appends to anchors.
+    /// </summary>
+    public static bool GetCreatedAnchors(List<KeyValuePair<string, Pose>> anchors)
+    {
+        if (!nativeGetCreatedAnchors(anchorUuidBuffer, anchorPoseBuffer, MaxAnchors, out int count))
+        {
+            return false;
+        }
+
+        for (int i = 0; i < count; i++)
+        {
+            int offset = i * AnchorUuidLength;
+            string uuid = Encoding.ASCII.GetString(anchorUuidBuffer, offset, AnchorUuidLength - 1);
+            float[] p = anchorPoseBuffer;
+            int o = i * 7;
+            anchors.Add(new KeyValuePair<string, Pose>(uuid,
+                new Pose(new Vector3(p[o], p[o + 1], p[o + 2]), new Quaternion(p[o + 3], p[o + 4], p[o + 5], p[o + 6]))));
+        }
+        return true;
+    }
+
+    /// <summary>
+    /// Report the current spatial anchor poses of native anchors in one call (a
+    /// relocalization then reaches Vuforia as one batch). known[i] is false for
+    /// anchors Vuforia has removed.
+    /// </summary>
+    public static bool UpdateAnchors(IList<string> uuids, IList<Pose> poses, bool[] known)
+    {
+        int count = Mathf.Min(uuids.Count, MaxAnchors);
+        Array.Clear(anchorUuidBuffer, 0, anchorUuidBuffer.Length);
+        for (int i = 0; i < count; i++)
+        {
+            Encoding.ASCII.GetBytes(uuids[i], 0, Mathf.Min(uuids[i].Length, AnchorUuidLength - 1),
+                                    anchorUuidBuffer, i * AnchorUuidLength);
+            Pose pose = poses[i];
+            int o = i * 7;
+            anchorPoseBuffer[o] = pose.position.x;
+            anchorPoseBuffer[o + 1] = pose.position.y;
+            anchorPoseBuffer[o + 2] = pose.position.z;
+            anchorPoseBuffer[o + 3] = pose.rotation.x;
+            anchorPoseBuffer[o + 4] = pose.rotation.y;
+            anchorPoseBuffer[o + 5] = pose.rotation.z;
+            anchorPoseBuffer[o + 6] = pose.rotation.w;
+        }
+
+        if (!nativeUpdateAnchors(anchorUuidBuffer, anchorPoseBuffer, anchorKnownBuffer, count))
+        {
+            return false;
+        }
+
+        for (int i = 0; i < count; i++)
+        {
+            known[i] = anchorKnownBuffer[i] != 0;
+        }
+        return true;
+    }
+
+    /// <summary>
+    /// The spatial anchor backing a native anchor was lost; Vuforia is told it was removed.
+    /// </summary>
+    public static bool DropAnchor(string uuid)
+    {
+        return nativeDropAnchor(uuid);
+    }
+
+    /// <summary>
+    /// Anchor stats: [live anchors, onAnchorUpdate batches, anchors reported].
+    /// </summary>
+    public static long[] GetAnchorStats()
+    {
+        long[] stats = new long[3];
+        return nativeGetAnchorStats(stats, stats.Length) ? stats : null;
+    }
+
     /// <summary>
     /// Check if native driver is initialized.
     /// </summary>
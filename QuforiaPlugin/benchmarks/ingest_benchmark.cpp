@@ -0,0 +1,302 @@
+// CPU cost of the frame ingestion kernels on fixed 1280x960 passthrough-sized
+// buffers, and of the whole ingestion path per delivered format. Run on device
+// (adb push + shell) for representative numbers; the kernels take their NEON
+// paths on arm64 only.
+//
+// Usage: ingest_benchmark [iterations]
+
+#include "vuforia_driver.h"
+#include "clock_domain.h"
+#include "frame_converter.h"
+#include "frame_scaler.h"
+#include "luma_normalizer.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+static const int SOURCE_WIDTH = 1280;
+static const int SOURCE_HEIGHT = 960;
+static const int SOURCE_BPP = 4;  // Unity hands over RGBA32
+
+// Average milliseconds per call, after a few warm-up calls
+static double timeKernel(int iterations, const std::function<void()>& kernel) {
+    for (int i = 0; i < 3; i++) {
+        kernel();
+    }
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        kernel();
+    }
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / iterations;
+}
+
+static void report(const char* name, double ms, double baselineMs) {
+    printf("  %-40s %8.3f ms  (%5.1f%%)\n", name, ms, 100.0 * ms / baselineMs);
+}
+
+// Camera-like test image: gradients plus some texture, alpha 255
+static std::vector<uint8_t> makeSourceFrame() {
+    std::vector<uint8_t> frame((size_t)SOURCE_WIDTH * SOURCE_HEIGHT * SOURCE_BPP);
+    uint32_t noise = 12345;
+    for (int y = 0; y < SOURCE_HEIGHT; y++) {
+        for (int x = 0; x < SOURCE_WIDTH; x++) {
+            noise = noise * 1664525u + 1013904223u;
+            uint8_t* p = &frame[((size_t)y * SOURCE_WIDTH + x) * SOURCE_BPP];
+            p[0] = (uint8_t)((x * 255 / SOURCE_WIDTH + (noise >> 28)) & 0xFF);
+            p[1] = (uint8_t)((y * 255 / SOURCE_HEIGHT + (noise >> 27)) & 0xFF);
+            p[2] = (uint8_t)(((x ^ y) & 0x3F) + 96);
+            p[3] = 255;
+        }
+    }
+    return frame;
+}
+
+// =============================================================================
+// Format Conversion
+// =============================================================================
+
+// RGBA32 source delivered as RGB888 (alpha stripped) vs RGBA8888 (straight
+// copy). Both fold in the vertical flip, as ingestion does.
+static void benchmarkConversion(const std::vector<uint8_t>& source, int iterations) {
+    const int srcStride = SOURCE_WIDTH * SOURCE_BPP;
+    const VuforiaDriver::PixelFormat formats[] = {
+        VuforiaDriver::PixelFormat::RGBA8888,
+        VuforiaDriver::PixelFormat::RGB888,
+    };
+    const char* names[] = { "RGBA32 -> RGBA8888 (passthrough)", "RGBA32 -> RGB888 (strip alpha)" };
+
+    printf("Format conversion, %dx%d:\n", SOURCE_WIDTH, SOURCE_HEIGHT);
+    double baselineMs = 0.0;
+    for (int i = 0; i < 2; i++) {
+        std::vector<uint8_t> dst(frameBufferSize(formats[i], SOURCE_WIDTH, SOURCE_HEIGHT));
+        const double ms = timeKernel(iterations, [&]() {
+            convertFrame(source.data(), srcStride, VuforiaDriver::PixelFormat::RGBA8888,
+                         dst.data(), formats[i], SOURCE_WIDTH, SOURCE_HEIGHT, true, false);
+        });
+        if (i == 0) {
+            baselineMs = ms;
+        }
+        report(names[i], ms, baselineMs);
+    }
+}
+
+// =============================================================================
+// Crop Window
+// =============================================================================
+
+// Centred crop windows delivered as RGB888, against the full frame. Without
+// upscale only the window is converted; with upscale it is scaled back to the
+// full mode size first (the bilinear scaler, then the conversion).
+static void benchmarkCrop(const std::vector<uint8_t>& source, int iterations) {
+    const int srcStride = SOURCE_WIDTH * SOURCE_BPP;
+    const float fractions[] = { 1.0f, 0.75f, 0.5f, 0.25f };
+    const VuforiaDriver::PixelFormat format = VuforiaDriver::PixelFormat::RGB888;
+    std::vector<uint8_t> dst(frameBufferSize(format, SOURCE_WIDTH, SOURCE_HEIGHT));
+    std::vector<uint8_t> scaled((size_t)SOURCE_WIDTH * SOURCE_HEIGHT * SOURCE_BPP);
+    FrameScaler scaler;
+
+    printf("\nCrop window (centred, per side) -> RGB888:\n");
+    double baselineMs = 0.0;
+    for (float fraction : fractions) {
+        // Same rounding as ingestion: even origin and size
+        const int cropWidth = (int)(fraction * SOURCE_WIDTH) & ~1;
+        const int cropHeight = (int)(fraction * SOURCE_HEIGHT) & ~1;
+        const int cropX = ((SOURCE_WIDTH - cropWidth) / 2) & ~1;
+        const int cropY = ((SOURCE_HEIGHT - cropHeight) / 2) & ~1;
+        const uint8_t* window = source.data() + (size_t)cropY * srcStride + (size_t)cropX * SOURCE_BPP;
+
+        const double croppedMs = timeKernel(iterations, [&]() {
+            convertFrame(window, srcStride, VuforiaDriver::PixelFormat::RGBA8888,
+                         dst.data(), format, cropWidth, cropHeight, true, false);
+        });
+        if (fraction == 1.0f) {
+            baselineMs = croppedMs;
+        }
+
+        char name[64];
+        snprintf(name, sizeof(name), "%4.0f%% (%dx%d)", fraction * 100.0f, cropWidth, cropHeight);
+        report(name, croppedMs, baselineMs);
+
+        if (fraction < 1.0f) {
+            const double upscaledMs = timeKernel(iterations, [&]() {
+                scaler.scale(window, srcStride, cropWidth, cropHeight,
+                             scaled.data(), SOURCE_WIDTH * SOURCE_BPP, SOURCE_WIDTH, SOURCE_HEIGHT,
+                             SOURCE_BPP, true);
+                convertFrame(scaled.data(), SOURCE_WIDTH * SOURCE_BPP, VuforiaDriver::PixelFormat::RGBA8888,
+                             dst.data(), format, SOURCE_WIDTH, SOURCE_HEIGHT, false, false);
+            });
+            snprintf(name, sizeof(name), "%4.0f%% upscaled to %dx%d", fraction * 100.0f,
+                     SOURCE_WIDTH, SOURCE_HEIGHT);
+            report(name, upscaledMs, baselineMs);
+        }
+    }
+}
+
+// =============================================================================
+// Low-Light Normalization
+// =============================================================================
+
+// Added cost of normalizing a dim frame, per delivered format, relative to
+// converting the frame. The frame is restored before every pass; the restore
+// copy is timed separately and subtracted. A bright frame shows the cost of
+// the check alone (one sampled histogram).
+static void benchmarkNormalization(const std::vector<uint8_t>& source, int iterations) {
+    const int srcStride = SOURCE_WIDTH * SOURCE_BPP;
+    std::vector<uint8_t> dark(source.size());
+    for (size_t i = 0; i < source.size(); i++) {
+        dark[i] = (i % SOURCE_BPP) == 3 ? source[i] : (uint8_t)(source[i] / 6);
+    }
+
+    const VuforiaDriver::PixelFormat formats[] = {
+        VuforiaDriver::PixelFormat::RGB888,
+        VuforiaDriver::PixelFormat::RGBA8888,
+        VuforiaDriver::PixelFormat::NV21,
+    };
+    const char* formatNames[] = { "RGB888", "RGBA8888", "NV21" };
+    const NormalizationMode modes[] = { NormalizationMode::STRETCH, NormalizationMode::CLAHE };
+    const char* modeNames[] = { "STRETCH", "CLAHE" };
+
+    printf("\nLow-light normalization, %dx%d (cost relative to conversion):\n",
+           SOURCE_WIDTH, SOURCE_HEIGHT);
+    LumaNormalizer normalizer;
+    for (int f = 0; f < 3; f++) {
+        const VuforiaDriver::PixelFormat format = formats[f];
+        const int stride = frameStride(format, SOURCE_WIDTH);
+        const size_t size = frameBufferSize(format, SOURCE_WIDTH, SOURCE_HEIGHT);
+        std::vector<uint8_t> darkFrame(size);
+        std::vector<uint8_t> brightFrame(size);
+        std::vector<uint8_t> frame(size);
+
+        const double convertMs = timeKernel(iterations, [&]() {
+            convertFrame(dark.data(), srcStride, VuforiaDriver::PixelFormat::RGBA8888,
+                         darkFrame.data(), format, SOURCE_WIDTH, SOURCE_HEIGHT, true, false);
+        });
+        convertFrame(source.data(), srcStride, VuforiaDriver::PixelFormat::RGBA8888,
+                     brightFrame.data(), format, SOURCE_WIDTH, SOURCE_HEIGHT, true, false);
+        const double restoreMs = timeKernel(iterations, [&]() {
+            memcpy(frame.data(), darkFrame.data(), size);
+        });
+
+        char name[64];
+        snprintf(name, sizeof(name), "%s convert", formatNames[f]);
+        report(name, convertMs, convertMs);
+
+        for (int m = 0; m < 2; m++) {
+            normalizer.setConfig(modes[m], 64, 4.0f);
+            bool normalized = false;
+            const double ms = timeKernel(iterations, [&]() {
+                memcpy(frame.data(), darkFrame.data(), size);
+                normalized = normalizer.process(frame.data(), format, SOURCE_WIDTH, SOURCE_HEIGHT, stride);
+            }) - restoreMs;
+            snprintf(name, sizeof(name), "%s %s%s", formatNames[f], modeNames[m],
+                     normalized ? "" : " (not triggered)");
+            report(name, ms, convertMs);
+        }
+
+        const double checkMs = timeKernel(iterations, [&]() {
+            normalizer.process(brightFrame.data(), format, SOURCE_WIDTH, SOURCE_HEIGHT, stride);
+        });
+        snprintf(name, sizeof(name), "%s bright frame (check only)", formatNames[f]);
+        report(name, checkMs, convertMs);
+    }
+}
+
+// =============================================================================
+// End-to-End Ingestion
+// =============================================================================
+
+// Stands in for Vuforia: touches the delivered buffer and nothing else
+class StubCameraCallback : public VuforiaDriver::CameraCallback {
+public:
+    StubCameraCallback() : frames_(0), checksum_(0) {}
+
+    void onNewCameraFrame(VuforiaDriver::CameraFrame* frame) override {
+        frames_++;
+        checksum_ += frame->buffer[frame->bufferSize / 2];
+    }
+
+    int frames() const { return frames_; }
+    uint32_t checksum() const { return checksum_; }
+
+private:
+    int frames_;
+    uint32_t checksum_;
+};
+
+// Unity's RGBA32 frame through the driver, per delivered format: ingestion
+// (pool slot, conversion, queue) in feedCameraFrame, then the camera
+// thread's pick (peekFrame, commitPick) and a stub delivery callback.
+// Relative to the RGBA8888 passthrough.
+static void benchmarkEndToEnd(const std::vector<uint8_t>& source, int iterations) {
+    const VuforiaDriver::PixelFormat formats[] = {
+        VuforiaDriver::PixelFormat::RGBA8888,
+        VuforiaDriver::PixelFormat::RGB888,
+    };
+    const char* names[] = { "RGBA32 -> RGBA8888 delivered", "RGBA32 -> RGB888 delivered" };
+
+    printf("\nEnd-to-end ingestion and delivery, %dx%d:\n", SOURCE_WIDTH, SOURCE_HEIGHT);
+    double baselineMs = 0.0;
+    for (int i = 0; i < 2; i++) {
+        QuestVuforiaDriver driver(nullptr, nullptr);
+        VuforiaDriver::CameraMode mode;
+        mode.width = SOURCE_WIDTH;
+        mode.height = SOURCE_HEIGHT;
+        mode.fps = 30;
+        mode.format = formats[i];
+        driver.setOutputMode(mode);
+
+        StubCameraCallback callback;
+        int64_t timestamp = monotonicNowNs();
+        const double ms = timeKernel(iterations, [&]() {
+            driver.feedCameraFrame(source.data(), SOURCE_WIDTH, SOURCE_HEIGHT,
+                                   VuforiaDriver::PixelFormat::RGBA8888, true, nullptr, timestamp);
+            timestamp += 33333333;
+
+            bool sharperOlder = false;
+            std::shared_ptr<CameraFrameData> frame = driver.peekFrame(&sharperOlder);
+            if (!frame) {
+                return;
+            }
+            VuforiaDriver::CameraFrame delivered;
+            delivered.buffer = frame->imageData;
+            delivered.width = frame->width;
+            delivered.height = frame->height;
+            delivered.stride = frame->stride;
+            delivered.bufferSize = frame->bufferSize;
+            delivered.format = frame->format;
+            delivered.timestamp = frame->timestamp;
+            delivered.intrinsics = frame->intrinsics;
+            callback.onNewCameraFrame(&delivered);
+            driver.commitPick(*frame, sharperOlder);
+        });
+        if (i == 0) {
+            baselineMs = ms;
+        }
+        report(names[i], ms, baselineMs);
+        if (callback.frames() == 0) {
+            printf("  (no frames delivered)\n");
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    const int iterations = argc > 1 ? std::max(1, atoi(argv[1])) : 200;
+    const std::vector<uint8_t> source = makeSourceFrame();
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    printf("Kernels: NEON, %d iterations\n\n", iterations);
+#else
+    printf("Kernels: scalar, %d iterations\n\n", iterations);
+#endif
+
+    benchmarkConversion(source, iterations);
+    benchmarkCrop(source, iterations);
+    benchmarkNormalization(source, iterations);
+    benchmarkEndToEnd(source, iterations);
+    return 0;
+}
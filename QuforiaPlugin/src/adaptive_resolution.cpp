@@ -0,0 +1,90 @@
+#include "adaptive_resolution.h"
+#include "quforia_log.h"
+
+#define LOG_TAG "QUFORIA"
+
+AdaptiveResolutionController::AdaptiveResolutionController()
+    : enabled_(false)
+    , reducedScale_(0.5f)
+    , holdNs_(1000000000)  // 1s of stable tracking before reducing
+    , status_(TrackingStatus::SEARCHING)
+    , lockedSinceNs_(0)
+    , reduced_(false)
+    , lastSwitchNs_(0)
+    , lastSampleNs_(0)
+    , timeFullNs_(0)
+    , timeReducedNs_(0)
+    , switchCount_(0)
+{
+}
+
+void AdaptiveResolutionController::setConfig(bool enabled, float reducedScale, int64_t holdNs) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    enabled_ = enabled;
+    if (reducedScale > 0.0f && reducedScale <= 1.0f) {
+        reducedScale_ = reducedScale;
+    }
+    if (holdNs >= 0) {
+        holdNs_ = holdNs;
+    }
+    if (!enabled_) {
+        reduced_ = false;
+    }
+
+    LOGI("Adaptive resolution %s (reduced scale=%.2f, hold=%lld ms)",
+         enabled_ ? "enabled" : "disabled", reducedScale_, (long long)(holdNs_ / 1000000));
+}
+
+void AdaptiveResolutionController::reportTrackingStatus(TrackingStatus status, int64_t nowNs) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (status == TrackingStatus::SEARCHING) {
+        lockedSinceNs_ = 0;
+    } else if (status_ == TrackingStatus::SEARCHING) {
+        lockedSinceNs_ = nowNs;
+    }
+    status_ = status;
+}
+
+float AdaptiveResolutionController::selectScale(int64_t nowNs) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Account time spent at the level used since the previous frame
+    if (lastSampleNs_ != 0 && nowNs > lastSampleNs_) {
+        (reduced_ ? timeReducedNs_ : timeFullNs_) += nowNs - lastSampleNs_;
+    }
+    lastSampleNs_ = nowNs;
+
+    if (!enabled_) {
+        return 1.0f;
+    }
+
+    bool wantReduced = reduced_;
+    if (status_ == TrackingStatus::SEARCHING) {
+        // Lost the target: back to full resolution right away
+        wantReduced = false;
+    } else if (!reduced_ && lockedSinceNs_ != 0 &&
+               nowNs - lockedSinceNs_ >= holdNs_ &&
+               nowNs - lastSwitchNs_ >= MIN_DWELL_NS) {
+        wantReduced = true;
+    }
+
+    if (wantReduced != reduced_) {
+        reduced_ = wantReduced;
+        lastSwitchNs_ = nowNs;
+        switchCount_++;
+        LOGI("Adaptive resolution: switching to %s (scale=%.2f)",
+             reduced_ ? "reduced" : "full", reduced_ ? reducedScale_ : 1.0f);
+    }
+
+    return reduced_ ? reducedScale_ : 1.0f;
+}
+
+void AdaptiveResolutionController::getStats(int64_t* fullNs, int64_t* reducedNs, int* switchCount) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (fullNs) *fullNs = timeFullNs_;
+    if (reducedNs) *reducedNs = timeReducedNs_;
+    if (switchCount) *switchCount = switchCount_;
+}
@@ -0,0 +1,58 @@
+#ifndef QUEST_ADAPTIVE_RESOLUTION_H
+#define QUEST_ADAPTIVE_RESOLUTION_H
+
+#include <cstdint>
+#include <mutex>
+
+/**
+ * Tracking status reported from Unity (mirrors Vuforia's target status).
+ */
+enum class TrackingStatus : int32_t {
+    SEARCHING = 0,  ///< No target tracked - detection needs full resolution
+    TRACKED = 1,    ///< Target actively tracked
+    EXTENDED = 2    ///< Target extended-tracked (out of view / device-pose only)
+};
+
+/**
+ * Picks the output scale for the next frames within the active camera mode.
+ *
+ * While searching, frames are delivered at full mode resolution. Once a target
+ * has been tracked (or extended-tracked) continuously for the hold time, the
+ * output drops to the reduced scale. Any report of SEARCHING snaps back to full
+ * resolution immediately, so re-detection never runs on reduced frames.
+ * A minimum dwell time after every switch prevents flapping.
+ */
+class AdaptiveResolutionController {
+public:
+    AdaptiveResolutionController();
+
+    void setConfig(bool enabled, float reducedScale, int64_t holdNs);
+    void reportTrackingStatus(TrackingStatus status, int64_t nowNs);
+
+    // Scale (0 < scale <= 1) to apply to the mode size for a frame ingested now
+    float selectScale(int64_t nowNs);
+
+    // Time spent at each level and number of switches since start
+    void getStats(int64_t* fullNs, int64_t* reducedNs, int* switchCount);
+
+private:
+    static const int64_t MIN_DWELL_NS = 500000000;  // 500ms between switches
+
+    std::mutex mutex_;
+    bool enabled_;
+    float reducedScale_;
+    int64_t holdNs_;
+
+    TrackingStatus status_;
+    int64_t lockedSinceNs_;   // When tracking (tracked/extended) began, 0 if searching
+    bool reduced_;
+    int64_t lastSwitchNs_;
+
+    // Metrics
+    int64_t lastSampleNs_;
+    int64_t timeFullNs_;
+    int64_t timeReducedNs_;
+    int switchCount_;
+};
+
+#endif // QUEST_ADAPTIVE_RESOLUTION_H
@@ -0,0 +1,285 @@
+#include "anchor_store.h"
+#include "coordinate_transform.h"
+#include "quforia_log.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#define LOG_TAG "QUFORIA"
+
+// CV world -> fed pose convention (inverse of the delivered pose mapping)
+typedef BasisChange<PositionToCV::Target, PositionToCV::Source> PositionFromCV;
+
+static void toCV(const float* pose, VuforiaDriver::AnchorPose* out) {
+    PositionToCV::position(pose, out->translationData);
+    RotationToCV::matrix(pose + 3, out->rotationData);
+}
+
+static void fromCV(const VuforiaDriver::AnchorPose& pose, float* out) {
+    PositionFromCV::position(pose.translationData, out);
+    RotationToCV::inverse(pose.rotationData, out + 3);
+}
+
+static bool posesDiffer(const VuforiaDriver::AnchorPose& a, const VuforiaDriver::AnchorPose& b,
+                        float minTranslation, float minRotation) {
+    const float dx = a.translationData[0] - b.translationData[0];
+    const float dy = a.translationData[1] - b.translationData[1];
+    const float dz = a.translationData[2] - b.translationData[2];
+    if (dx * dx + dy * dy + dz * dz > minTranslation * minTranslation) {
+        return true;
+    }
+    for (int i = 0; i < 9; i++) {
+        if (std::fabs(a.rotationData[i] - b.rotationData[i]) > minRotation) {
+            return true;
+        }
+    }
+    return false;
+}
+
+AnchorStore::AnchorStore()
+    : count_(0)
+    , random_(std::random_device()())
+    , removedCount_(0)
+    , pendingChanges_(false)
+    , batches_(0)
+    , notified_(0)
+{
+    memset(records_, 0, sizeof(records_));
+}
+
+const char* AnchorStore::create(const VuforiaDriver::AnchorPose& pose) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    Record* record = nullptr;
+    for (int i = 0; i < MAX_ANCHORS; i++) {
+        if (!records_[i].used) {
+            record = &records_[i];
+            break;
+        }
+    }
+    if (record == nullptr) {
+        LOGE("Anchor table full (%d anchors)", MAX_ANCHORS);
+        return nullptr;
+    }
+
+    // Random UUIDs, unique among live anchors
+    char uuid[ANCHOR_UUID_LENGTH];
+    do {
+        generateUuid(uuid);
+    } while (find(uuid) != nullptr);
+
+    memset(record, 0, sizeof(*record));
+    record->used = true;
+    memcpy(record->uuid, uuid, ANCHOR_UUID_LENGTH);
+    record->pose = pose;
+    record->created = true;
+    count_++;
+
+    LOGI("Anchor %s created at (%.3f, %.3f, %.3f), %d anchors", record->uuid,
+         pose.translationData[0], pose.translationData[1], pose.translationData[2], count_);
+    return record->uuid;
+}
+
+bool AnchorStore::remove(const char* uuid) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    Record* record = find(uuid);
+    if (record == nullptr) {
+        return false;
+    }
+
+    // Removed by Vuforia itself: nothing to report back. Unity notices on its
+    // next update and releases the spatial anchor.
+    record->used = false;
+    count_--;
+    refreshPending();
+
+    LOGI("Anchor %s removed, %d anchors", uuid, count_);
+    return true;
+}
+
+int AnchorStore::takeCreated(char* uuids, float* poses, int maxCount) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    int taken = 0;
+    for (int i = 0; i < MAX_ANCHORS && taken < maxCount; i++) {
+        Record& record = records_[i];
+        if (!record.used || !record.created) {
+            continue;
+        }
+        memcpy(uuids + taken * ANCHOR_UUID_LENGTH, record.uuid, ANCHOR_UUID_LENGTH);
+        fromCV(record.pose, poses + taken * 7);
+        record.created = false;
+        taken++;
+    }
+    return taken;
+}
+
+bool AnchorStore::update(const char* uuid, const float* pose) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    Record* record = find(uuid);
+    if (record == nullptr) {
+        return false;
+    }
+
+    VuforiaDriver::AnchorPose converted;
+    toCV(pose, &converted);
+
+    // First pose from the spatial anchor (ADDED), the first after a
+    // relocalization, or a real change; jitter is ignored
+    if (!record->reported || record->paused ||
+        posesDiffer(converted, record->pose, MIN_TRANSLATION, MIN_ROTATION)) {
+        record->pose = converted;
+        record->moved = true;
+        record->paused = false;
+        pendingChanges_ = true;
+    }
+    return true;
+}
+
+bool AnchorStore::drop(const char* uuid) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    Record* record = find(uuid);
+    if (record == nullptr) {
+        return false;
+    }
+
+    if (record->reported && removedCount_ < MAX_ANCHORS) {
+        memcpy(removed_[removedCount_++], record->uuid, ANCHOR_UUID_LENGTH);
+        pendingChanges_ = true;
+    }
+    record->used = false;
+    count_--;
+
+    LOGI("Anchor %s lost by the spatial anchor, %d anchors", uuid, count_);
+    return true;
+}
+
+void AnchorStore::pauseAll() {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    int paused = 0;
+    for (int i = 0; i < MAX_ANCHORS; i++) {
+        Record& record = records_[i];
+        if (record.used && record.reported && !record.paused) {
+            record.paused = true;
+            record.pausePending = true;
+            paused++;
+        }
+    }
+    if (paused > 0) {
+        pendingChanges_ = true;
+        LOGI("Relocalizing: %d anchors paused", paused);
+    }
+}
+
+int AnchorStore::takeChanges(VuforiaDriver::AnchorStatus status, VuforiaDriver::Anchor* out,
+                             char* uuidStorage, int maxCount) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    int taken = 0;
+    if (status == VuforiaDriver::AnchorStatus::REMOVED) {
+        // Removed anchors have no pose any more
+        taken = std::min(removedCount_, maxCount);
+        for (int i = 0; i < taken; i++) {
+            char* uuid = uuidStorage + i * ANCHOR_UUID_LENGTH;
+            memcpy(uuid, removed_[i], ANCHOR_UUID_LENGTH);
+            out[i].uuid = uuid;
+            memset(&out[i].pose, 0, sizeof(out[i].pose));
+        }
+        memmove(removed_, removed_ + taken, (size_t)(removedCount_ - taken) * ANCHOR_UUID_LENGTH);
+        removedCount_ -= taken;
+    } else {
+        for (int i = 0; i < MAX_ANCHORS && taken < maxCount; i++) {
+            Record& record = records_[i];
+            if (!record.used) {
+                continue;
+            }
+
+            bool take = false;
+            switch (status) {
+            case VuforiaDriver::AnchorStatus::ADDED:
+                take = !record.reported && record.moved;
+                record.reported = record.reported || take;
+                record.moved = record.moved && !take;
+                break;
+            case VuforiaDriver::AnchorStatus::UPDATED:
+                take = record.reported && record.moved && !record.pausePending;
+                record.moved = record.moved && !take;
+                break;
+            case VuforiaDriver::AnchorStatus::PAUSED:
+                take = record.pausePending;
+                record.pausePending = false;
+                break;
+            default:
+                break;
+            }
+            if (!take) {
+                continue;
+            }
+
+            char* uuid = uuidStorage + taken * ANCHOR_UUID_LENGTH;
+            memcpy(uuid, record.uuid, ANCHOR_UUID_LENGTH);
+            out[taken].uuid = uuid;
+            out[taken].pose = record.pose;
+            taken++;
+        }
+    }
+
+    if (taken > 0) {
+        batches_++;
+        notified_ += taken;
+    }
+    refreshPending();
+    return taken;
+}
+
+void AnchorStore::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    memset(records_, 0, sizeof(records_));
+    count_ = 0;
+    removedCount_ = 0;
+    pendingChanges_ = false;
+}
+
+void AnchorStore::getStats(int64_t* anchors, int64_t* batches, int64_t* notified) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (anchors) *anchors = count_;
+    if (batches) *batches = batches_;
+    if (notified) *notified = notified_;
+}
+
+AnchorStore::Record* AnchorStore::find(const char* uuid) {
+    if (uuid == nullptr) {
+        return nullptr;
+    }
+    for (int i = 0; i < MAX_ANCHORS; i++) {
+        if (records_[i].used && strncmp(records_[i].uuid, uuid, ANCHOR_UUID_LENGTH) == 0) {
+            return &records_[i];
+        }
+    }
+    return nullptr;
+}
+
+void AnchorStore::generateUuid(char* out) {
+    // Version 4 (random) layout: xxxxxxxx-xxxx-4xxx-yxxx-xxxxxxxxxxxx
+    const uint64_t high = (random_() & 0xFFFFFFFFFFFF0FFFull) | 0x0000000000004000ull;
+    const uint64_t low = (random_() & 0x3FFFFFFFFFFFFFFFull) | 0x8000000000000000ull;
+    snprintf(out, ANCHOR_UUID_LENGTH, "%08x-%04x-%04x-%04x-%012llx",
+             (unsigned)(high >> 32), (unsigned)((high >> 16) & 0xFFFF), (unsigned)(high & 0xFFFF),
+             (unsigned)(low >> 48), (unsigned long long)(low & 0xFFFFFFFFFFFFull));
+}
+
+void AnchorStore::refreshPending() {
+    bool pending = removedCount_ > 0;
+    for (int i = 0; i < MAX_ANCHORS && !pending; i++) {
+        const Record& record = records_[i];
+        pending = record.used && (record.moved || record.pausePending);
+    }
+    pendingChanges_ = pending;
+}
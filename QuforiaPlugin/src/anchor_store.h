@@ -0,0 +1,90 @@
+#ifndef QUEST_ANCHOR_STORE_H
+#define QUEST_ANCHOR_STORE_H
+
+#include <VuforiaEngine/Driver/Driver.h>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <random>
+
+static const int ANCHOR_UUID_LENGTH = 37;  // 36 characters + terminator
+
+/**
+ * Native anchor table keyed by UUID.
+ *
+ * Vuforia creates anchors at a pose in the delivered (CV) world frame. Each
+ * anchor is handed to Unity, which backs it with a spatial anchor and reports
+ * the spatial anchor's pose back (fed pose convention) as tracking refines or
+ * the headset relocalizes. Changes are queued per AnchorStatus and taken in
+ * batches by the tracker, so a relocalization that moves every anchor turns
+ * into a single onAnchorUpdate call.
+ *
+ * Records live in a fixed array, so the UUID returned by create() stays valid
+ * until the anchor is removed.
+ */
+class AnchorStore {
+public:
+    static const int MAX_ANCHORS = 64;
+
+    AnchorStore();
+
+    // Vuforia side. create() returns nullptr when the table is full.
+    const char* create(const VuforiaDriver::AnchorPose& pose);
+    bool remove(const char* uuid);
+
+    // Unity side. Poses are position (x, y, z) + rotation (x, y, z, w) in the
+    // fed pose convention, 7 floats per anchor.
+    // Anchors created since the last call (uuids: ANCHOR_UUID_LENGTH bytes each)
+    int takeCreated(char* uuids, float* poses, int maxCount);
+    // Spatial anchor pose; false if the anchor no longer exists
+    bool update(const char* uuid, const float* pose);
+    // Spatial anchor lost: reported to Vuforia as REMOVED
+    bool drop(const char* uuid);
+
+    // Headset relocalized: reported anchors are PAUSED until Unity re-reports them
+    void pauseAll();
+
+    // Pending changes with the given status, oldest first. out[i].uuid points
+    // into uuidStorage (one ANCHOR_UUID_LENGTH slot per anchor).
+    int takeChanges(VuforiaDriver::AnchorStatus status, VuforiaDriver::Anchor* out,
+                    char* uuidStorage, int maxCount);
+    bool hasChanges() const { return pendingChanges_.load(); }
+
+    void clear();
+    void getStats(int64_t* anchors, int64_t* batches, int64_t* notified);
+
+private:
+    struct Record {
+        bool used;
+        char uuid[ANCHOR_UUID_LENGTH];
+        VuforiaDriver::AnchorPose pose;  // CV world frame
+        bool created;   // Not yet handed to Unity
+        bool reported;  // ADDED delivered to Vuforia
+        bool moved;     // Pose changed since last reported
+        bool paused;    // Relocalizing, waiting for a fresh spatial anchor pose
+        bool pausePending;
+    };
+
+    Record* find(const char* uuid);
+    void generateUuid(char* out);
+    void refreshPending();
+
+    std::mutex mutex_;
+    Record records_[MAX_ANCHORS];
+    int count_;
+    std::mt19937_64 random_;
+
+    // Dropped by Unity, waiting to be reported as REMOVED
+    char removed_[MAX_ANCHORS][ANCHOR_UUID_LENGTH];
+    int removedCount_;
+
+    std::atomic<bool> pendingChanges_;
+    int64_t batches_;
+    int64_t notified_;
+
+    // Smallest change reported as UPDATED (spatial anchors jitter slightly)
+    static constexpr float MIN_TRANSLATION = 0.001f;   // m
+    static constexpr float MIN_ROTATION = 0.001f;      // Rotation matrix element
+};
+
+#endif // QUEST_ANCHOR_STORE_H
@@ -0,0 +1,214 @@
+#include "clock_domain.h"
+#include "quforia_log.h"
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+
+#define LOG_TAG "QUFORIA"
+
+static int64_t clockNowNs(clockid_t clock) {
+    struct timespec ts;
+    clock_gettime(clock, &ts);
+    return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+int64_t monotonicNowNs() {
+    return clockNowNs(CLOCK_MONOTONIC);
+}
+
+const int ClockSync::WINDOW;
+const int ClockSync::BINS;
+const int ClockSync::CACHE_SIZE;
+const int64_t ClockSync::STEP_THRESHOLD_NS;
+
+ClockSync::ClockSync()
+    : domain_(ClockDomain::MONOTONIC)
+    , head_(0)
+    , count_(0)
+    , valid_(false)
+    , referenceNs_(0)
+    , offsetNs_(0.0)
+    , drift_(0.0)
+    , cacheHead_(0)
+    , cacheCount_(0)
+    , resyncs_(0)
+    , samples_(0)
+{
+}
+
+void ClockSync::setDomain(ClockDomain domain) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (domain != domain_) {
+        domain_ = domain;
+        reset();
+    }
+
+    LOGI("Timestamp clock domain: %s",
+         domain == ClockDomain::MONOTONIC ? "CLOCK_MONOTONIC" :
+         domain == ClockDomain::REALTIME ? "CLOCK_REALTIME" :
+         domain == ClockDomain::ESTIMATED ? "estimated offset/drift" : "arrival time");
+}
+
+ClockDomain ClockSync::domain() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return domain_;
+}
+
+int64_t ClockSync::stamp(int64_t sourceNs) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (domain_ == ClockDomain::MONOTONIC) {
+        return sourceNs;
+    }
+
+    for (int i = 0; i < cacheCount_; i++) {
+        if (cacheSource_[i] == sourceNs) {
+            return cacheMapped_[i];
+        }
+    }
+
+    const int64_t nowNs = monotonicNowNs();
+    if (domain_ == ClockDomain::ESTIMATED) {
+        addSample(sourceNs, nowNs);
+    }
+    const int64_t mapped = mapLocked(sourceNs, nowNs);
+
+    cacheSource_[cacheHead_] = sourceNs;
+    cacheMapped_[cacheHead_] = mapped;
+    cacheHead_ = (cacheHead_ + 1) % CACHE_SIZE;
+    cacheCount_ = std::min(cacheCount_ + 1, CACHE_SIZE);
+    return mapped;
+}
+
+int64_t ClockSync::map(int64_t sourceNs) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (domain_ == ClockDomain::MONOTONIC) {
+        return sourceNs;
+    }
+    for (int i = 0; i < cacheCount_; i++) {
+        if (cacheSource_[i] == sourceNs) {
+            return cacheMapped_[i];
+        }
+    }
+    return mapLocked(sourceNs, monotonicNowNs());
+}
+
+int64_t ClockSync::mapLocked(int64_t sourceNs, int64_t nowNs) const {
+    switch (domain_) {
+    case ClockDomain::REALTIME:
+        // Both clocks read back to back: exact up to the read latency
+        return sourceNs - (clockNowNs(CLOCK_REALTIME) - nowNs);
+    case ClockDomain::ESTIMATED:
+        if (!valid_) {
+            return nowNs;
+        }
+        return sourceNs + (int64_t)std::llround(offsetNs_ + drift_ * (double)(sourceNs - referenceNs_));
+    case ClockDomain::ARRIVAL:
+        return nowNs;
+    case ClockDomain::MONOTONIC:
+    default:
+        return sourceNs;
+    }
+}
+
+void ClockSync::addSample(int64_t sourceNs, int64_t nowNs) {
+    const int64_t delay = nowNs - sourceNs;
+
+    // Far off the fit: the source clock was stepped (or restarted)
+    if (valid_) {
+        const double expected = offsetNs_ + drift_ * (double)(sourceNs - referenceNs_);
+        if (std::fabs((double)delay - expected) > (double)STEP_THRESHOLD_NS) {
+            resyncs_++;
+            LOGI("Source clock stepped by %.1f ms, re-estimating offset (%lld resyncs)",
+                 ((double)delay - expected) / 1e6, (long long)resyncs_);
+            reset();
+        }
+    }
+
+    sources_[head_] = sourceNs;
+    delays_[head_] = delay;
+    head_ = (head_ + 1) % WINDOW;
+    count_ = std::min(count_ + 1, WINDOW);
+    samples_++;
+
+    fit();
+}
+
+void ClockSync::fit() {
+    // Lower envelope: minimum delay per slice of the window (oldest first)
+    const int bins = std::min(BINS, count_);
+    const int oldest = (head_ - count_ + WINDOW) % WINDOW;
+    double xs[BINS];
+    double ys[BINS];
+    referenceNs_ = sources_[(head_ - 1 + WINDOW) % WINDOW];
+    for (int b = 0; b < bins; b++) {
+        const int begin = b * count_ / bins;
+        const int end = (b + 1) * count_ / bins;
+        int best = (oldest + begin) % WINDOW;
+        for (int i = begin + 1; i < end; i++) {
+            const int index = (oldest + i) % WINDOW;
+            if (delays_[index] < delays_[best]) {
+                best = index;
+            }
+        }
+        xs[b] = (double)(sources_[best] - referenceNs_);
+        ys[b] = (double)delays_[best];
+    }
+
+    // Least-squares line through the envelope points
+    double meanX = 0.0;
+    double meanY = 0.0;
+    for (int b = 0; b < bins; b++) {
+        meanX += xs[b];
+        meanY += ys[b];
+    }
+    meanX /= bins;
+    meanY /= bins;
+    double sxx = 0.0;
+    double sxy = 0.0;
+    for (int b = 0; b < bins; b++) {
+        sxx += (xs[b] - meanX) * (xs[b] - meanX);
+        sxy += (xs[b] - meanX) * (ys[b] - meanY);
+    }
+    double drift = sxx > 0.0 ? sxy / sxx : 0.0;
+    if (std::fabs(drift) > MAX_DRIFT) {
+        drift = 0.0;  // Not enough spread yet to tell drift from jitter
+    }
+
+    // Offset: line through the envelope, but never above the best point seen
+    // (a fit above a sample would put that sample's capture in the future)
+    double offset = meanY - drift * meanX;
+    for (int b = 0; b < bins; b++) {
+        offset = std::min(offset, ys[b] - drift * xs[b]);
+    }
+
+    drift_ = drift;
+    offsetNs_ = offset;
+    valid_ = true;
+
+    if (samples_ % 300 == 0) {
+        LOGD("Clock estimate: offset %.3f ms, drift %.1f ppm over %d samples",
+             offsetNs_ / 1e6, drift_ * 1e6, count_);
+    }
+}
+
+void ClockSync::reset() {
+    head_ = 0;
+    count_ = 0;
+    valid_ = false;
+    offsetNs_ = 0.0;
+    drift_ = 0.0;
+    cacheHead_ = 0;
+    cacheCount_ = 0;
+}
+
+void ClockSync::getStats(int64_t* offsetNs, int64_t* driftPpb, int64_t* resyncs, int64_t* samples) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (offsetNs) *offsetNs = (int64_t)std::llround(offsetNs_);
+    if (driftPpb) *driftPpb = (int64_t)std::llround(drift_ * 1e9);
+    if (resyncs) *resyncs = resyncs_;
+    if (samples) *samples = samples_;
+}
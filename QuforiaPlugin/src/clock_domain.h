@@ -0,0 +1,85 @@
+#ifndef QUEST_CLOCK_DOMAIN_H
+#define QUEST_CLOCK_DOMAIN_H
+
+#include <cstdint>
+#include <mutex>
+
+// CLOCK_MONOTONIC in nanoseconds (the clock Vuforia expects for frame and pose timestamps)
+int64_t monotonicNowNs();
+
+/**
+ * Clock the fed timestamps are expressed in.
+ */
+enum class ClockDomain : int32_t {
+    MONOTONIC = 0,  ///< Already CLOCK_MONOTONIC ns (passed through)
+    REALTIME = 1,   ///< Unix-epoch ns (CLOCK_REALTIME), converted by pairing both clocks
+    ESTIMATED = 2,  ///< Any other ns clock; offset and drift learned from arrival times
+    ARRIVAL = 3     ///< Source timestamps ignored; stamped with CLOCK_MONOTONIC on arrival
+};
+
+/**
+ * Maps source timestamps into CLOCK_MONOTONIC.
+ *
+ * For ESTIMATED sources every fed timestamp is paired with its arrival time.
+ * arrival - source is the clock offset plus a non-negative delivery delay, so
+ * the offset is tracked as the lower envelope of that difference: the minimum
+ * of each of BINS slices of a sliding window, fitted with a line whose slope
+ * is the drift between the two clocks. A jump away from the fit (the source
+ * clock was stepped) restarts the estimate.
+ *
+ * The most recent mappings are cached, so a pose and a frame fed with the same
+ * source timestamp always get the same monotonic timestamp.
+ */
+class ClockSync {
+public:
+    ClockSync();
+
+    void setDomain(ClockDomain domain);
+    ClockDomain domain();
+
+    // Fed timestamp -> CLOCK_MONOTONIC (updates the estimate)
+    int64_t stamp(int64_t sourceNs);
+
+    // Query timestamp -> CLOCK_MONOTONIC with the current estimate
+    int64_t map(int64_t sourceNs);
+
+    void getStats(int64_t* offsetNs, int64_t* driftPpb, int64_t* resyncs, int64_t* samples);
+
+private:
+    int64_t mapLocked(int64_t sourceNs, int64_t nowNs) const;
+    void addSample(int64_t sourceNs, int64_t nowNs);
+    void fit();
+    void reset();
+
+    std::mutex mutex_;
+    ClockDomain domain_;
+
+    // Sliding window of (source, arrival - source)
+    static const int WINDOW = 128;
+    static const int BINS = 8;
+    int64_t sources_[WINDOW];
+    int64_t delays_[WINDOW];
+    int head_;
+    int count_;
+
+    // delay(s) = offsetNs_ + drift_ * (s - referenceNs_)
+    bool valid_;
+    int64_t referenceNs_;
+    double offsetNs_;
+    double drift_;
+
+    // Recent source -> monotonic mappings
+    static const int CACHE_SIZE = 8;
+    int64_t cacheSource_[CACHE_SIZE];
+    int64_t cacheMapped_[CACHE_SIZE];
+    int cacheHead_;
+    int cacheCount_;
+
+    int64_t resyncs_;
+    int64_t samples_;
+
+    static const int64_t STEP_THRESHOLD_NS = 200000000;  // 200ms away from the fit
+    static constexpr double MAX_DRIFT = 500e-6;          // 500 ppm
+};
+
+#endif // QUEST_CLOCK_DOMAIN_H
@@ -0,0 +1,557 @@
+#ifndef QUEST_COORDINATE_TRANSFORM_H
+#define QUEST_COORDINATE_TRANSFORM_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define QUFORIA_HAS_NEON 1
+#endif
+
+/**
+ * Header-only coordinate-convention transforms.
+ *
+ * A convention names the physical direction of each of its +X/+Y/+Z axes.
+ * BasisChange<From, To> derives the signed axis permutation between two
+ * conventions at compile time, so converting a pose is a handful of
+ * constant-folded sign flips and shuffles:
+ *
+ *   position:  p' = C p
+ *   rotation:  R' = C R C^T
+ *   quaternion: v' = det(C) C v, w' = w  (a mirror flips the rotation sense)
+ *
+ * Quaternions are (x, y, z, w); matrices are 3x3 row-major. The
+ * static_asserts at the end of this file check every pair of conventions.
+ * Everything except the batch functions is constexpr.
+ */
+
+// =============================================================================
+// Conventions
+// =============================================================================
+
+enum class Direction : int8_t {
+    RIGHT, LEFT, UP, DOWN, BACK, FORWARD
+};
+
+// Reference frame: RIGHT = +X, UP = +Y, BACK = +Z (right-handed)
+constexpr int directionAxis(Direction d) {
+    return (d == Direction::RIGHT || d == Direction::LEFT) ? 0 :
+           (d == Direction::UP || d == Direction::DOWN) ? 1 : 2;
+}
+
+constexpr int directionSign(Direction d) {
+    return (d == Direction::RIGHT || d == Direction::UP || d == Direction::BACK) ? 1 : -1;
+}
+
+// OpenXR: X right, Y up, Z back (right-handed)
+struct OpenXRConvention {
+    static constexpr Direction axes[3] = { Direction::RIGHT, Direction::UP, Direction::BACK };
+};
+
+// Unity: X right, Y up, Z forward (left-handed)
+struct UnityConvention {
+    static constexpr Direction axes[3] = { Direction::RIGHT, Direction::UP, Direction::FORWARD };
+};
+
+// Vuforia / OpenCV camera: X right, Y down, Z forward (right-handed)
+struct VuforiaCVConvention {
+    static constexpr Direction axes[3] = { Direction::RIGHT, Direction::DOWN, Direction::FORWARD };
+};
+
+// +1 for right-handed, -1 for left-handed
+template <typename Convention>
+constexpr int handedness() {
+    const int a0 = directionAxis(Convention::axes[0]);
+    const int a1 = directionAxis(Convention::axes[1]);
+    const int a2 = directionAxis(Convention::axes[2]);
+    // Parity of the axis permutation (number of inversions)
+    const int inversions = (a0 > a1) + (a0 > a2) + (a1 > a2);
+    const int parity = (inversions % 2 == 0) ? 1 : -1;
+    return parity * directionSign(Convention::axes[0]) *
+           directionSign(Convention::axes[1]) * directionSign(Convention::axes[2]);
+}
+
+template <typename Convention>
+constexpr bool isValidConvention() {
+    return directionAxis(Convention::axes[0]) != directionAxis(Convention::axes[1]) &&
+           directionAxis(Convention::axes[0]) != directionAxis(Convention::axes[2]) &&
+           directionAxis(Convention::axes[1]) != directionAxis(Convention::axes[2]);
+}
+
+// =============================================================================
+// Quaternion / Matrix
+// =============================================================================
+
+// Quaternion (x, y, z, w) to 3x3 row-major rotation matrix
+constexpr void quaternionToMatrix(const float* q, float* m) {
+    const float x = q[0];
+    const float y = q[1];
+    const float z = q[2];
+    const float w = q[3];
+
+    m[0] = 1.0f - 2.0f * (y * y + z * z);
+    m[1] = 2.0f * (x * y - z * w);
+    m[2] = 2.0f * (x * z + y * w);
+
+    m[3] = 2.0f * (x * y + z * w);
+    m[4] = 1.0f - 2.0f * (x * x + z * z);
+    m[5] = 2.0f * (y * z - x * w);
+
+    m[6] = 2.0f * (x * z - y * w);
+    m[7] = 2.0f * (y * z + x * w);
+    m[8] = 1.0f - 2.0f * (x * x + y * y);
+}
+
+// Hamilton product r = a * b, quaternions as (x, y, z, w)
+constexpr void multiplyQuaternion(const float* a, const float* b, float* r) {
+    r[0] = a[3] * b[0] + a[0] * b[3] + a[1] * b[2] - a[2] * b[1];
+    r[1] = a[3] * b[1] - a[0] * b[2] + a[1] * b[3] + a[2] * b[0];
+    r[2] = a[3] * b[2] + a[0] * b[1] - a[1] * b[0] + a[2] * b[3];
+    r[3] = a[3] * b[3] - a[0] * b[0] - a[1] * b[1] - a[2] * b[2];
+}
+
+// out = q * v * q^-1 for a unit quaternion (out may not alias v)
+constexpr void rotateVector(const float* q, const float* v, float* out) {
+    // t = 2 * cross(q.xyz, v); out = v + w * t + cross(q.xyz, t)
+    const float tx = 2.0f * (q[1] * v[2] - q[2] * v[1]);
+    const float ty = 2.0f * (q[2] * v[0] - q[0] * v[2]);
+    const float tz = 2.0f * (q[0] * v[1] - q[1] * v[0]);
+    out[0] = v[0] + q[3] * tx + (q[1] * tz - q[2] * ty);
+    out[1] = v[1] + q[3] * ty + (q[2] * tx - q[0] * tz);
+    out[2] = v[2] + q[3] * tz + (q[0] * ty - q[1] * tx);
+}
+
+// Rotation matrix to unit quaternion (x, y, z, w), w >= 0 when the trace
+// dominates. Pivots on the largest of trace/m00/m11/m22 for precision.
+inline void matrixToQuaternion(const float* m, float* q) {
+    const float tw = m[0] + m[4] + m[8];
+    const float tx = m[0] - m[4] - m[8];
+    const float ty = m[4] - m[0] - m[8];
+    const float tz = m[8] - m[0] - m[4];
+
+    if (tw >= tx && tw >= ty && tw >= tz) {
+        const float r = std::sqrt(1.0f + tw);
+        const float s = 0.5f / r;
+        q[0] = (m[7] - m[5]) * s;
+        q[1] = (m[2] - m[6]) * s;
+        q[2] = (m[3] - m[1]) * s;
+        q[3] = 0.5f * r;
+    } else if (tx >= ty && tx >= tz) {
+        const float r = std::sqrt(1.0f + tx);
+        const float s = 0.5f / r;
+        q[0] = 0.5f * r;
+        q[1] = (m[1] + m[3]) * s;
+        q[2] = (m[2] + m[6]) * s;
+        q[3] = (m[7] - m[5]) * s;
+    } else if (ty >= tz) {
+        const float r = std::sqrt(1.0f + ty);
+        const float s = 0.5f / r;
+        q[0] = (m[1] + m[3]) * s;
+        q[1] = 0.5f * r;
+        q[2] = (m[5] + m[7]) * s;
+        q[3] = (m[2] - m[6]) * s;
+    } else {
+        const float r = std::sqrt(1.0f + tz);
+        const float s = 0.5f / r;
+        q[0] = (m[2] + m[6]) * s;
+        q[1] = (m[5] + m[7]) * s;
+        q[2] = 0.5f * r;
+        q[3] = (m[3] - m[1]) * s;
+    }
+}
+
+// Batch quaternion -> matrix: quats is count * 4 floats, matrices count * 9.
+// NEON converts four quaternions per iteration.
+inline void quaternionsToMatrices(const float* quats, float* matrices, size_t count) {
+    size_t i = 0;
+
+#ifdef QUFORIA_HAS_NEON
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    const float32x4_t two = vdupq_n_f32(2.0f);
+    for (; i + 4 <= count; i += 4) {
+        const float32x4x4_t q = vld4q_f32(quats + i * 4);  // Deinterleaves x, y, z, w
+        const float32x4_t x = q.val[0];
+        const float32x4_t y = q.val[1];
+        const float32x4_t z = q.val[2];
+        const float32x4_t w = q.val[3];
+
+        const float32x4_t xx = vmulq_f32(x, x);
+        const float32x4_t yy = vmulq_f32(y, y);
+        const float32x4_t zz = vmulq_f32(z, z);
+        const float32x4_t xy = vmulq_f32(x, y);
+        const float32x4_t xz = vmulq_f32(x, z);
+        const float32x4_t yz = vmulq_f32(y, z);
+        const float32x4_t xw = vmulq_f32(x, w);
+        const float32x4_t yw = vmulq_f32(y, w);
+        const float32x4_t zw = vmulq_f32(z, w);
+
+        float lanes[9][4];
+        vst1q_f32(lanes[0], vmlsq_f32(one, two, vaddq_f32(yy, zz)));
+        vst1q_f32(lanes[1], vmulq_f32(two, vsubq_f32(xy, zw)));
+        vst1q_f32(lanes[2], vmulq_f32(two, vaddq_f32(xz, yw)));
+        vst1q_f32(lanes[3], vmulq_f32(two, vaddq_f32(xy, zw)));
+        vst1q_f32(lanes[4], vmlsq_f32(one, two, vaddq_f32(xx, zz)));
+        vst1q_f32(lanes[5], vmulq_f32(two, vsubq_f32(yz, xw)));
+        vst1q_f32(lanes[6], vmulq_f32(two, vsubq_f32(xz, yw)));
+        vst1q_f32(lanes[7], vmulq_f32(two, vaddq_f32(yz, xw)));
+        vst1q_f32(lanes[8], vmlsq_f32(one, two, vaddq_f32(xx, yy)));
+
+        for (int l = 0; l < 4; l++) {
+            float* m = matrices + (i + l) * 9;
+            for (int k = 0; k < 9; k++) {
+                m[k] = lanes[k][l];
+            }
+        }
+    }
+#endif
+
+    for (; i < count; i++) {
+        quaternionToMatrix(quats + i * 4, matrices + i * 9);
+    }
+}
+
+// Batch matrix -> quaternion (same pivoting as matrixToQuaternion, branch-free
+// per lane on NEON)
+inline void matricesToQuaternions(const float* matrices, float* quats, size_t count) {
+    size_t i = 0;
+
+#ifdef QUFORIA_HAS_NEON
+    const float32x4_t half = vdupq_n_f32(0.5f);
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    for (; i + 4 <= count; i += 4) {
+        float lanes[9][4];
+        for (int l = 0; l < 4; l++) {
+            const float* m = matrices + (i + l) * 9;
+            for (int k = 0; k < 9; k++) {
+                lanes[k][l] = m[k];
+            }
+        }
+        float32x4_t m[9];
+        for (int k = 0; k < 9; k++) {
+            m[k] = vld1q_f32(lanes[k]);
+        }
+
+        const float32x4_t tw = vaddq_f32(vaddq_f32(m[0], m[4]), m[8]);
+        const float32x4_t tx = vsubq_f32(vsubq_f32(m[0], m[4]), m[8]);
+        const float32x4_t ty = vsubq_f32(vsubq_f32(m[4], m[0]), m[8]);
+        const float32x4_t tz = vsubq_f32(vsubq_f32(m[8], m[0]), m[4]);
+
+        // Pivot selection, same precedence as the scalar path
+        const uint32x4_t pickW = vandq_u32(vandq_u32(vcgeq_f32(tw, tx), vcgeq_f32(tw, ty)), vcgeq_f32(tw, tz));
+        const uint32x4_t pickX = vbicq_u32(vandq_u32(vcgeq_f32(tx, ty), vcgeq_f32(tx, tz)), pickW);
+        const uint32x4_t pickY = vbicq_u32(vbicq_u32(vcgeq_f32(ty, tz), pickW), pickX);
+
+        float32x4_t t = vbslq_f32(pickW, tw, vbslq_f32(pickX, tx, vbslq_f32(pickY, ty, tz)));
+        t = vaddq_f32(one, t);  // >= 1 for a rotation matrix
+
+        // 1/sqrt(t) with two Newton steps (armv7 has no vector sqrt)
+        float32x4_t rs = vrsqrteq_f32(t);
+        rs = vmulq_f32(rs, vrsqrtsq_f32(vmulq_f32(t, rs), rs));
+        rs = vmulq_f32(rs, vrsqrtsq_f32(vmulq_f32(t, rs), rs));
+
+        const float32x4_t big = vmulq_f32(half, vmulq_f32(t, rs));  // 0.5 * sqrt(t)
+        const float32x4_t s = vmulq_f32(half, rs);                   // 0.5 / sqrt(t)
+
+        const float32x4_t a = vmulq_f32(vsubq_f32(m[7], m[5]), s);  // m21 - m12
+        const float32x4_t b = vmulq_f32(vsubq_f32(m[2], m[6]), s);  // m02 - m20
+        const float32x4_t c = vmulq_f32(vsubq_f32(m[3], m[1]), s);  // m10 - m01
+        const float32x4_t d = vmulq_f32(vaddq_f32(m[1], m[3]), s);  // m01 + m10
+        const float32x4_t e = vmulq_f32(vaddq_f32(m[2], m[6]), s);  // m02 + m20
+        const float32x4_t f = vmulq_f32(vaddq_f32(m[5], m[7]), s);  // m12 + m21
+
+        float32x4x4_t out;
+        out.val[0] = vbslq_f32(pickW, a, vbslq_f32(pickX, big, vbslq_f32(pickY, d, e)));
+        out.val[1] = vbslq_f32(pickW, b, vbslq_f32(pickX, d, vbslq_f32(pickY, big, f)));
+        out.val[2] = vbslq_f32(pickW, c, vbslq_f32(pickX, e, vbslq_f32(pickY, f, big)));
+        out.val[3] = vbslq_f32(pickW, big, vbslq_f32(pickX, a, vbslq_f32(pickY, b, c)));
+        vst4q_f32(quats + i * 4, out);  // Interleaves back to x, y, z, w
+    }
+#endif
+
+    for (; i < count; i++) {
+        matrixToQuaternion(matrices + i * 9, quats + i * 4);
+    }
+}
+
+// =============================================================================
+// Basis Change
+// =============================================================================
+
+template <typename From, typename To>
+struct BasisChange {
+    static_assert(isValidConvention<From>() && isValidConvention<To>(),
+                  "Convention axes must span all three reference axes");
+
+    typedef From Source;
+    typedef To Target;
+
+    // To component i = sign(i) * From component axis(i)
+    static constexpr int axis(int i) {
+        return directionAxis(To::axes[i]) == directionAxis(From::axes[0]) ? 0 :
+               directionAxis(To::axes[i]) == directionAxis(From::axes[1]) ? 1 : 2;
+    }
+
+    static constexpr int sign(int i) {
+        return directionSign(To::axes[i]) * directionSign(From::axes[axis(i)]);
+    }
+
+    // -1 when the conventions differ in handedness
+    static constexpr int determinant() {
+        return handedness<From>() * handedness<To>();
+    }
+
+    static constexpr void position(const float* in, float* out) {
+        out[0] = sign(0) * in[axis(0)];
+        out[1] = sign(1) * in[axis(1)];
+        out[2] = sign(2) * in[axis(2)];
+    }
+
+    // R' = C R C^T
+    static constexpr void rotationMatrix(const float* in, float* out) {
+        for (int r = 0; r < 3; r++) {
+            for (int c = 0; c < 3; c++) {
+                out[r * 3 + c] = (float)(sign(r) * sign(c)) * in[axis(r) * 3 + axis(c)];
+            }
+        }
+    }
+
+    static constexpr void quaternion(const float* in, float* out) {
+        out[0] = (float)(determinant() * sign(0)) * in[axis(0)];
+        out[1] = (float)(determinant() * sign(1)) * in[axis(1)];
+        out[2] = (float)(determinant() * sign(2)) * in[axis(2)];
+        out[3] = in[3];
+    }
+};
+
+/**
+ * Orientation conversion with separate world and body (device axes) basis
+ * changes: R' = Cw R Cb^T. With Cw == Cb this is the plain basis change.
+ *
+ * Computed as (Cw Cb^T)(Cb R Cb^T): the body change is applied to the
+ * quaternion, then the rows of its matrix are permuted by the constant
+ * signed permutation D = Cw Cb^T.
+ */
+template <typename WorldChange, typename BodyChange>
+struct RotationConversion {
+    static_assert(WorldChange::determinant() == BodyChange::determinant(),
+                  "World and body changes must agree in handedness to yield a rotation");
+
+    // Row i of D has its nonzero entry in column rowAxis(i)
+    static constexpr int rowAxis(int i) {
+        return BodyChange::axis(0) == WorldChange::axis(i) ? 0 :
+               BodyChange::axis(1) == WorldChange::axis(i) ? 1 : 2;
+    }
+
+    static constexpr int rowSign(int i) {
+        return WorldChange::sign(i) * BodyChange::sign(rowAxis(i));
+    }
+
+    static constexpr void permuteRows(const float* in, float* out) {
+        for (int r = 0; r < 3; r++) {
+            for (int c = 0; c < 3; c++) {
+                out[r * 3 + c] = (float)rowSign(r) * in[rowAxis(r) * 3 + c];
+            }
+        }
+    }
+
+    static constexpr void matrix(const float* quaternionIn, float* matrixOut) {
+        float q[4] = {};
+        float body[9] = {};
+        BodyChange::quaternion(quaternionIn, q);
+        quaternionToMatrix(q, body);
+        permuteRows(body, matrixOut);
+    }
+
+    // Batch of count quaternions; scratch holds count * 4 floats and
+    // matricesOut count * 9
+    static void matrices(const float* quaternions, size_t count, float* scratch, float* matricesOut) {
+        for (size_t i = 0; i < count; i++) {
+            BodyChange::quaternion(quaternions + i * 4, scratch + i * 4);
+        }
+        quaternionsToMatrices(scratch, matricesOut, count);
+        for (size_t i = 0; i < count; i++) {
+            float body[9];
+            memcpy(body, matricesOut + i * 9, sizeof(body));
+            permuteRows(body, matricesOut + i * 9);
+        }
+    }
+
+    // Inverse of matrix(): undo the row permutation (D^T), then revert the
+    // body change on the quaternion
+    static void inverse(const float* matrixIn, float* quaternionOut) {
+        float body[9];
+        for (int r = 0; r < 3; r++) {
+            for (int c = 0; c < 3; c++) {
+                body[rowAxis(r) * 3 + c] = (float)rowSign(r) * matrixIn[r * 3 + c];
+            }
+        }
+        float q[4];
+        matrixToQuaternion(body, q);
+        BasisChange<typename BodyChange::Target, typename BodyChange::Source>::quaternion(q, quaternionOut);
+    }
+};
+
+// Plain basis change of orientation (world and body share the convention)
+template <typename From, typename To>
+using BasisRotation = RotationConversion<BasisChange<From, To>, BasisChange<From, To>>;
+
+// Fed Quest poses -> Vuforia CV poses. Position is a plain OpenXR -> CV basis
+// change (x, -y, -z). Orientation maps world axes Unity -> CV and device axes
+// Unity -> OpenXR, i.e. diag(1, -1, 1) R diag(1, 1, -1), which is the mapping
+// validated on device (checked against the original conversion in
+// external_tracker.cpp). Anchors use the same mapping so they share the
+// delivered world frame.
+typedef BasisChange<OpenXRConvention, VuforiaCVConvention> PositionToCV;
+typedef RotationConversion<BasisChange<UnityConvention, VuforiaCVConvention>,
+                           BasisChange<UnityConvention, OpenXRConvention>> RotationToCV;
+
+/**
+ * Coordinate system transformation of one fed pose:
+ *
+ * Unity/OpenXR convention:
+ *   X: Right
+ *   Y: Up
+ *   Z: Back (OpenXR) / Forward (Unity)
+ *
+ * Vuforia CV convention:
+ *   X: Right
+ *   Y: Down
+ *   Z: Away from camera (into scene)
+ *   Handedness: Right-handed
+ *
+ * Position: p' = diag(1, -1, -1) p
+ * Rotation: R' = diag(1, -1, 1) R diag(1, 1, -1)
+ *
+ * Streamed batches use PositionToCV and RotationToCV::matrices directly and
+ * must agree with this.
+ */
+constexpr void transformOpenXRToCV(const float* positionIn, const float* rotationIn,
+                                   float* positionOut, float* rotationOut) {
+    PositionToCV::position(positionIn, positionOut);
+    RotationToCV::matrix(rotationIn, rotationOut);
+}
+
+// =============================================================================
+// Compile-Time Checks
+// =============================================================================
+
+struct CoordinateTransformChecks {
+    // A -> B -> C equals A -> C
+    template <typename A, typename B, typename C>
+    static constexpr bool composes() {
+        for (int i = 0; i < 3; i++) {
+            const int via = BasisChange<B, C>::axis(i);
+            if (BasisChange<A, C>::axis(i) != BasisChange<A, B>::axis(via) ||
+                BasisChange<A, C>::sign(i) != BasisChange<B, C>::sign(i) * BasisChange<A, B>::sign(via)) {
+                return false;
+            }
+        }
+        return BasisChange<A, C>::determinant() ==
+               BasisChange<A, B>::determinant() * BasisChange<B, C>::determinant();
+    }
+
+    static constexpr bool nearlyEqual(float a, float b) {
+        return (a - b) < 1e-5f && (b - a) < 1e-5f;
+    }
+
+    // Converting the quaternion and then building the matrix equals
+    // C R C^T of the original matrix
+    template <typename From, typename To>
+    static constexpr bool quaternionMatchesMatrix(float x, float y, float z, float w) {
+        const float q[4] = { x, y, z, w };
+        float m[9] = {};
+        float expected[9] = {};
+        float qOut[4] = {};
+        float actual[9] = {};
+        quaternionToMatrix(q, m);
+        BasisChange<From, To>::rotationMatrix(m, expected);
+        BasisChange<From, To>::quaternion(q, qOut);
+        quaternionToMatrix(qOut, actual);
+        for (int i = 0; i < 9; i++) {
+            if (!nearlyEqual(expected[i], actual[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // The quaternion path of BasisRotation equals C R C^T
+    template <typename From, typename To>
+    static constexpr bool basisRotationMatches(float x, float y, float z, float w) {
+        const float q[4] = { x, y, z, w };
+        float m[9] = {};
+        float expected[9] = {};
+        float actual[9] = {};
+        quaternionToMatrix(q, m);
+        BasisChange<From, To>::rotationMatrix(m, expected);
+        BasisRotation<From, To>::matrix(q, actual);
+        for (int i = 0; i < 9; i++) {
+            if (!nearlyEqual(expected[i], actual[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <typename From, typename To>
+    static constexpr bool quaternionMappingCorrect() {
+        // Unit quaternions with exact float components about each axis and a mix
+        return quaternionMatchesMatrix<From, To>(0.6f, 0.0f, 0.0f, 0.8f) &&
+               quaternionMatchesMatrix<From, To>(0.0f, 0.6f, 0.0f, 0.8f) &&
+               quaternionMatchesMatrix<From, To>(0.0f, 0.0f, 0.6f, 0.8f) &&
+               quaternionMatchesMatrix<From, To>(0.5f, -0.5f, 0.5f, 0.5f) &&
+               quaternionMatchesMatrix<From, To>(0.36f, 0.48f, -0.64f, 0.48f) &&
+               basisRotationMatches<From, To>(0.5f, -0.5f, 0.5f, 0.5f) &&
+               basisRotationMatches<From, To>(0.36f, 0.48f, -0.64f, 0.48f);
+    }
+
+    // Every triple of conventions composes and every pair maps quaternions correctly
+    template <typename... Conventions>
+    struct Set {
+        template <typename A, typename B>
+        static constexpr bool composeThrough() {
+            return (composes<A, B, Conventions>() && ...);
+        }
+
+        template <typename A>
+        static constexpr bool checkFrom() {
+            return ((composeThrough<A, Conventions>() &&
+                     quaternionMappingCorrect<A, Conventions>()) && ...);
+        }
+
+        static constexpr bool consistent() {
+            return (checkFrom<Conventions>() && ...);
+        }
+    };
+};
+
+static_assert(handedness<OpenXRConvention>() == 1, "OpenXR is right-handed");
+static_assert(handedness<UnityConvention>() == -1, "Unity is left-handed");
+static_assert(handedness<VuforiaCVConvention>() == 1, "Vuforia CV is right-handed");
+
+// OpenXR -> CV is a 180 degree turn about X: (x, -y, -z)
+static_assert(BasisChange<OpenXRConvention, VuforiaCVConvention>::axis(0) == 0 &&
+              BasisChange<OpenXRConvention, VuforiaCVConvention>::axis(1) == 1 &&
+              BasisChange<OpenXRConvention, VuforiaCVConvention>::axis(2) == 2 &&
+              BasisChange<OpenXRConvention, VuforiaCVConvention>::sign(0) == 1 &&
+              BasisChange<OpenXRConvention, VuforiaCVConvention>::sign(1) == -1 &&
+              BasisChange<OpenXRConvention, VuforiaCVConvention>::sign(2) == -1 &&
+              BasisChange<OpenXRConvention, VuforiaCVConvention>::determinant() == 1,
+              "OpenXR -> Vuforia CV must be diag(1, -1, -1)");
+
+// Unity -> CV is a mirror of Y: (x, -y, z)
+static_assert(BasisChange<UnityConvention, VuforiaCVConvention>::sign(0) == 1 &&
+              BasisChange<UnityConvention, VuforiaCVConvention>::sign(1) == -1 &&
+              BasisChange<UnityConvention, VuforiaCVConvention>::sign(2) == 1 &&
+              BasisChange<UnityConvention, VuforiaCVConvention>::determinant() == -1,
+              "Unity -> Vuforia CV must be diag(1, -1, 1)");
+
+// Every triple composes, every pair round-trips, and every quaternion mapping
+// agrees with the matrix basis change
+static_assert(CoordinateTransformChecks::Set<OpenXRConvention, UnityConvention, VuforiaCVConvention>::consistent(),
+              "Coordinate conventions are inconsistent");
+
+#endif // QUEST_COORDINATE_TRANSFORM_H
@@ -1,15 +1,41 @@
 #include "external_camera.h"
 #include "vuforia_driver.h"
-#include <android/log.h>
+#include "quforia_log.h"
 #include <chrono>
 #include <thread>
 #include <cstring>
 
 #define LOG_TAG "QUFORIA"
-#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
-#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
-#define LOGD(...) __android_log_print(ANDROID_LOG_DEBUG, LOG_TAG, __VA_ARGS__)
-#define LOGW(...) __android_log_print(ANDROID_LOG_WARN, LOG_TAG, __VA_ARGS__)
+
+// Output formats advertised to Vuforia. RGBA8888 matches the passthrough
+// source layout, so selecting it skips channel repacking entirely. The 4:2:0
+// formats halve the bytes per pixel handed to Vuforia (1.5 vs 3).
+static const VuforiaDriver::PixelFormat SUPPORTED_FORMATS[] = {
+    VuforiaDriver::PixelFormat::RGB888,
+    VuforiaDriver::PixelFormat::RGBA8888,
+    VuforiaDriver::PixelFormat::NV12,
+    VuforiaDriver::PixelFormat::NV21,
+    VuforiaDriver::PixelFormat::YUV420P,
+};
+static const uint32_t NUM_SUPPORTED_FORMATS =
+    sizeof(SUPPORTED_FORMATS) / sizeof(SUPPORTED_FORMATS[0]);
+
+// Resolution ladder relative to the 1280x960 passthrough frame. Lower rungs
+// are produced natively by the ingestion downscaler.
+static const uint32_t BASE_WIDTH = 1280;
+static const uint32_t BASE_HEIGHT = 960;
+static const struct { uint32_t num; uint32_t den; } SUPPORTED_SCALES[] = {
+    { 1, 1 },
+    { 3, 4 },
+    { 1, 2 },
+    { 1, 4 },
+};
+static const uint32_t NUM_SUPPORTED_SCALES =
+    sizeof(SUPPORTED_SCALES) / sizeof(SUPPORTED_SCALES[0]);
+
+// Passthrough frames arrive at 30fps; a faster mode would only repeat them
+static const uint32_t SUPPORTED_FPS[] = { 30 };
+static const uint32_t NUM_SUPPORTED_FPS = sizeof(SUPPORTED_FPS) / sizeof(SUPPORTED_FPS[0]);
 
 QuestExternalCamera::QuestExternalCamera(QuestVuforiaDriver* driver)
     : driver_(driver)
@@ -53,8 +79,8 @@ bool QuestExternalCamera::open() {
         return true;
     }
 
-    // Allocate frame buffer
-    int bufferSize = currentMode_.width * currentMode_.height * 3;  // RGB888
+    // Allocate frame buffer (sized for the widest supported format)
+    int bufferSize = currentMode_.width * currentMode_.height * 4;  // RGBA8888
     frameBuffer_ = new uint8_t[bufferSize];
 
     if (!frameBuffer_) {
@@ -112,16 +138,28 @@ bool QuestExternalCamera::start(VuforiaDriver::CameraMode mode,
         return false;
     }
 
-    // Validate mode (we only support one mode for now)
-    if (mode.width != currentMode_.width ||
-        mode.height != currentMode_.height ||
-        mode.format != currentMode_.format) {
+    // Validate mode against the advertised list
+    bool modeSupported = false;
+    for (uint32_t i = 0; i < getNumSupportedCameraModes(); i++) {
+        VuforiaDriver::CameraMode supported;
+        if (getSupportedCameraMode(i, &supported) &&
+            mode.width == supported.width &&
+            mode.height == supported.height &&
+            mode.fps == supported.fps &&
+            mode.format == supported.format) {
+            modeSupported = true;
+            break;
+        }
+    }
+
+    if (!modeSupported) {
         LOGE("Unsupported camera mode: %ux%u, format=%d",
              mode.width, mode.height, mode.format);
         return false;
     }
 
     currentMode_ = mode;
+    driver_->setOutputMode(mode);
     callback_ = callback;
     isRunning_ = true;
 
@@ -158,24 +196,29 @@ bool QuestExternalCamera::stop() {
 // =============================================================================
 
 uint32_t QuestExternalCamera::getNumSupportedCameraModes() {
-    // We support one camera mode: 1280x960@30fps RGB888
-    return 1;
+    // Every format at every rung of the resolution ladder, at each supplied rate
+    return NUM_SUPPORTED_FORMATS * NUM_SUPPORTED_SCALES * NUM_SUPPORTED_FPS;
 }
 
 bool QuestExternalCamera::getSupportedCameraMode(uint32_t index,
                                                  VuforiaDriver::CameraMode* cameraMode) {
-    if (index != 0 || cameraMode == nullptr) {
+    if (index >= getNumSupportedCameraModes() || cameraMode == nullptr) {
         return false;
     }
 
-    // Return the single supported mode
-    cameraMode->width = 1280;
-    cameraMode->height = 960;
-    cameraMode->fps = 30;
-    cameraMode->format = VuforiaDriver::PixelFormat::RGB888;
+    // index = (format * NUM_SCALES + scale) * NUM_FPS + fps
+    const uint32_t fpsIndex = index % NUM_SUPPORTED_FPS;
+    const uint32_t scaleIndex = (index / NUM_SUPPORTED_FPS) % NUM_SUPPORTED_SCALES;
+    const uint32_t formatIndex = index / (NUM_SUPPORTED_FPS * NUM_SUPPORTED_SCALES);
+
+    cameraMode->width = BASE_WIDTH * SUPPORTED_SCALES[scaleIndex].num / SUPPORTED_SCALES[scaleIndex].den;
+    cameraMode->height = BASE_HEIGHT * SUPPORTED_SCALES[scaleIndex].num / SUPPORTED_SCALES[scaleIndex].den;
+    cameraMode->fps = SUPPORTED_FPS[fpsIndex];
+    cameraMode->format = SUPPORTED_FORMATS[formatIndex];
 
-    LOGD("getSupportedCameraMode(%u): %ux%u@%ufps",
-         index, cameraMode->width, cameraMode->height, cameraMode->fps);
+    LOGD("getSupportedCameraMode(%u): %ux%u@%ufps, format=%d",
+         index, cameraMode->width, cameraMode->height, cameraMode->fps,
+         (int)cameraMode->format);
     return true;
 }
 
@@ -287,57 +330,130 @@ bool QuestExternalCamera::setFocusValue(float focusValue) {
 
 void QuestExternalCamera::frameDeliveryThread() {
     LOGI("Frame delivery thread started");
+    TraceRecorder& trace = driver_->traceRecorder();
+    trace.setThreadName("Frame delivery");
 
     const int targetFPS = currentMode_.fps;
     const auto frameDuration = std::chrono::milliseconds(1000 / targetFPS);
 
     int frameCount = 0;
+    int64_t lastHandledTimestamp = -1;
 
     while (isRunning_) {
         auto frameStartTime = std::chrono::steady_clock::now();
+        TraceScope iteration(trace, "frameDelivery");
+
+        // Frame the driver picks next (committed below once handled)
+        bool sharperOlder = false;
+        auto frameData = driver_->peekFrame(&sharperOlder);
+
+        // Each frame is handled once (delivered, or skipped with its pose
+        // still delivered). The same frame comes back until a newer one is
+        // queued: poll for that instead of delivering it again.
+        if (frameData && frameData->timestamp == lastHandledTimestamp) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            continue;
+        }
 
-        // Acquire latest frame from driver
-        auto frameData = driver_->acquireLatestFrame();
+        bool skip = false;
+        if (frameData) {
+            // Drop frames captured during fast head motion
+            const bool skipForMotion = driver_->shouldSkipFrameForMotion(frameData->timestamp);
 
-        if (frameData && callback_) {
-            // Prepare Vuforia frame structure
-            VuforiaDriver::CameraFrame vuforiaFrame;
-            memset(&vuforiaFrame, 0, sizeof(vuforiaFrame));
+            // Static headset and scene: throttle to the floor rate
+            const bool skipStatic = !skipForMotion && !frameData->lowLight &&
+                                    driver_->shouldSkipStaticFrame(*frameData);
 
-            // Set frame data
-            vuforiaFrame.buffer = frameData->imageData;
-            vuforiaFrame.width = frameData->width;
-            vuforiaFrame.height = frameData->height;
-            vuforiaFrame.stride = frameData->width * 3;  // RGB888: 3 bytes per pixel
-            vuforiaFrame.bufferSize = vuforiaFrame.stride * frameData->height;
-            vuforiaFrame.format = VuforiaDriver::PixelFormat::RGB888;
-            vuforiaFrame.timestamp = frameData->timestamp;
-            vuforiaFrame.exposureTime = 33333333;  // 33.33ms @ 30fps (nanoseconds)
-            vuforiaFrame.intrinsics = frameData->intrinsics;
+            // Too dark to track: the tracker reports INSUFFICIENT_LIGHT instead
+            skip = skipForMotion || skipStatic || frameData->lowLight;
+        }
+        bool delivered = false;
+        bool handled = false;
+
+        if (frameData && callback_ && driver_->poseStreamingEnabled()) {
+            // The tracker streams every pose sample; this frame's own pose is
+            // emitted here and the frame follows it with no streamed pose in
+            // between. Skipped frames still get their pose.
+            std::lock_guard<std::mutex> lock(driver_->poseDeliveryMutex());
+            driver_->deliverFramePose(*frameData);
+            if (!skip) {
+                deliverFrame(*frameData);
+                delivered = true;
+            }
+            handled = true;
+        } else if (frameData && skip) {
+            // Skipped: wait for the next frame at the normal cadence
+            handled = true;
+        } else if (frameData && callback_) {
+            // Late-pose join: the tracker must hand Vuforia this frame's pose first
+            driver_->waitForPoseDelivered(frameData->timestamp);
+            deliverFrame(*frameData);
+            delivered = true;
+            handled = true;
+        } else {
+            // No frame available, wait a bit
+            LOGD("No frame available from driver");
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
 
-            // Deliver frame to Vuforia (pass pointer, not value)
-            callback_->onNewCameraFrame(&vuforiaFrame);
+        if (handled) {
+            // Skipped frames are committed too, so the next pick never goes
+            // back before them
+            driver_->commitPick(*frameData, sharperOlder);
+            lastHandledTimestamp = frameData->timestamp;
+        }
 
+        if (delivered) {
             frameCount++;
             if (frameCount % 30 == 0) {
                 LOGD("Delivered %d frames (latest timestamp: %lld)",
                      frameCount, (long long)frameData->timestamp);
             }
-        } else {
-            // No frame available, wait a bit
-            LOGD("No frame available from driver");
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
         }
 
-        // Sleep to maintain target frame rate
+        // Sleep to maintain target frame rate (both rig cameras are captured
+        // together, so alternating between them stays at the mode rate)
         auto frameEndTime = std::chrono::steady_clock::now();
         auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
             frameEndTime - frameStartTime);
 
         if (elapsed < frameDuration) {
+            TraceScope idle(trace, "idle");
             std::this_thread::sleep_for(frameDuration - elapsed);
         }
     }
 
     LOGI("Frame delivery thread stopped (delivered %d frames)", frameCount);
 }
+
+void QuestExternalCamera::deliverFrame(const CameraFrameData& frameData) {
+    // Prepare Vuforia frame structure
+    VuforiaDriver::CameraFrame vuforiaFrame;
+    memset(&vuforiaFrame, 0, sizeof(vuforiaFrame));
+
+    // Set frame data
+    vuforiaFrame.buffer = frameData.imageData;
+    vuforiaFrame.width = frameData.width;
+    vuforiaFrame.height = frameData.height;
+    vuforiaFrame.stride = frameData.stride;
+    vuforiaFrame.bufferSize = frameData.bufferSize;
+    vuforiaFrame.format = frameData.format;
+    vuforiaFrame.timestamp = frameData.timestamp;
+    vuforiaFrame.exposureTime = 33333333;  // 33.33ms @ 30fps (nanoseconds)
+    vuforiaFrame.intrinsics = frameData.intrinsics;
+
+    PipelineStats& stats = driver_->pipelineStats();
+    const int64_t deliveryStartNs = monotonicNowNs();
+    stats.record(PipelineStage::QUEUE_WAIT, deliveryStartNs - frameData.enqueuedNs);
+
+    // Deliver frame to Vuforia (pass pointer, not value)
+    {
+        TraceScope trace(driver_->traceRecorder(), "onNewCameraFrame", frameData.timestamp);
+        callback_->onNewCameraFrame(&vuforiaFrame);
+    }
+
+    const int64_t deliveryEndNs = monotonicNowNs();
+    stats.record(PipelineStage::VUFORIA_CALLBACK, deliveryEndNs - deliveryStartNs);
+    stats.record(PipelineStage::TOTAL, deliveryEndNs - frameData.timestamp);
+    stats.countFrameDelivered();
+}
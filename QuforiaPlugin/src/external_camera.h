@@ -8,6 +8,7 @@
 
 // Forward declaration
 class QuestVuforiaDriver;
+struct CameraFrameData;
 
 /**
  * ExternalCamera implementation for Meta Quest passthrough camera.
@@ -54,6 +55,9 @@ private:
     // Frame delivery thread
     void frameDeliveryThread();
 
+    // Hand a queued frame to the callback
+    void deliverFrame(const CameraFrameData& frameData);
+
     QuestVuforiaDriver* driver_;
     VuforiaDriver::CameraCallback* callback_;
     VuforiaDriver::CameraMode currentMode_;
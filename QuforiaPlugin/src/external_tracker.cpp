@@ -1,23 +1,28 @@
 #include "external_tracker.h"
 #include "vuforia_driver.h"
-#include <android/log.h>
+#include "coordinate_transform.h"
+#include "quforia_log.h"
 #include <chrono>
 #include <thread>
 #include <cstring>
 #include <cmath>
 
 #define LOG_TAG "QUFORIA"
-#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
-#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
-#define LOGD(...) __android_log_print(ANDROID_LOG_DEBUG, LOG_TAG, __VA_ARGS__)
-#define LOGW(...) __android_log_print(ANDROID_LOG_WARN, LOG_TAG, __VA_ARGS__)
+
+// Pose conversion to the Vuforia CV convention uses PositionToCV and
+// RotationToCV (coordinate_transform.h).
 
 QuestExternalTracker::QuestExternalTracker(QuestVuforiaDriver* driver)
     : driver_(driver)
     , callback_(nullptr)
+    , anchorCallback_(nullptr)
     , isRunning_(false)
     , isOpen_(false)
     , lastPoseTimestamp_(0)
+    , lastPoseCamera_(0)
+    , lastEmittedTimestamp_(0)
+    , framePoseCount_(0)
+    , streamedPoseCount_(0)
 {
     LOGI("QuestExternalTracker constructor");
 }
@@ -82,11 +87,15 @@ bool QuestExternalTracker::start(VuforiaDriver::PoseCallback* cb, VuforiaDriver:
     }
 
     callback_ = cb;
-    // anchorCb is optional and not used (anchor support not implemented)
-    (void)anchorCb;
+    anchorCallback_ = anchorCb;  // Optional: anchors are only reported when set
 
     isRunning_ = true;
     lastPoseTimestamp_ = 0;
+    lastPoseCamera_ = driver_->activeCamera();
+    lastEmittedTimestamp_ = 0;
+    framePoseCount_ = 0;
+    streamedPoseCount_ = 0;
+    driver_->setPoseDeliveryActive(true);
 
     // Start pose delivery thread
     poseThread_ = std::thread(&QuestExternalTracker::poseDeliveryThread, this);
@@ -103,8 +112,9 @@ bool QuestExternalTracker::stop() {
         return true;
     }
 
-    // Signal thread to stop
+    // Signal thread to stop (and release a camera thread waiting on our poses)
     isRunning_ = false;
+    driver_->setPoseDeliveryActive(false);
 
     // Wait for thread to finish
     if (poseThread_.joinable()) {
@@ -112,6 +122,7 @@ bool QuestExternalTracker::stop() {
     }
 
     callback_ = nullptr;
+    anchorCallback_ = nullptr;
     LOGI("Tracker stopped");
     return true;
 }
@@ -119,8 +130,12 @@ bool QuestExternalTracker::stop() {
 bool QuestExternalTracker::resetTracking() {
     LOGI("resetTracking()");
 
-    // Reset tracking state
+    // Reset tracking state; poses report INITIALIZING until tracking settles
     lastPoseTimestamp_ = 0;
+    driver_->resetPoseValidation();
+
+    // Anchors belong to the old world; Unity releases their spatial anchors
+    driver_->anchorStore().clear();
 
     // In a full implementation, this would reset the Quest's tracking system
     // For now, we just reset our internal state
@@ -128,62 +143,85 @@ bool QuestExternalTracker::resetTracking() {
     return true;
 }
 
+// =============================================================================
+// Anchors
+// =============================================================================
+
+bool QuestExternalTracker::isAnchorSupported() {
+    return true;
+}
+
+const char* QuestExternalTracker::createAnchor(VuforiaDriver::AnchorPose* anchorPose) {
+    if (anchorPose == nullptr) {
+        LOGE("createAnchor: pose is null");
+        return nullptr;
+    }
+    return driver_->anchorStore().create(*anchorPose);
+}
+
+bool QuestExternalTracker::removeAnchor(const char* uuid) {
+    if (!driver_->anchorStore().remove(uuid)) {
+        LOGW("removeAnchor: unknown anchor %s", uuid ? uuid : "(null)");
+        return false;
+    }
+    return true;
+}
+
+void QuestExternalTracker::flushAnchorUpdates() {
+    AnchorStore& store = driver_->anchorStore();
+    if (!anchorCallback_ || !store.hasChanges()) {
+        return;
+    }
+
+    // Pauses go first so a relocalization reads as paused -> updated
+    static const VuforiaDriver::AnchorStatus order[] = {
+        VuforiaDriver::AnchorStatus::PAUSED,
+        VuforiaDriver::AnchorStatus::ADDED,
+        VuforiaDriver::AnchorStatus::UPDATED,
+        VuforiaDriver::AnchorStatus::REMOVED
+    };
+    for (const VuforiaDriver::AnchorStatus status : order) {
+        const int count = store.takeChanges(status, anchorBatch_, anchorUuids_, AnchorStore::MAX_ANCHORS);
+        if (count > 0) {
+            anchorCallback_->onAnchorUpdate(anchorBatch_, count, status);
+            LOGD("Anchor update: %d anchors, status %d", count, (int)status);
+        }
+    }
+}
+
 // =============================================================================
 // Pose Delivery Thread
 // =============================================================================
 
 void QuestExternalTracker::poseDeliveryThread() {
     LOGI("Pose delivery thread started");
+    driver_->traceRecorder().setThreadName("Pose delivery");
 
-    int poseCount = 0;
     const auto pollInterval = std::chrono::milliseconds(10);  // Poll every 10ms
+    uint64_t frameSequence = 0;
 
     while (isRunning_) {
         auto pollStartTime = std::chrono::steady_clock::now();
 
-        // Acquire latest frame to get its timestamp
-        auto frameData = driver_->acquireLatestFrame();
-
-        if (frameData && callback_) {
-            int64_t frameTimestamp = frameData->timestamp;
-
-            // Only deliver pose if timestamp is new (avoid duplicates)
-            if (frameTimestamp != lastPoseTimestamp_) {
-                // Acquire pose for this frame's timestamp
-                auto poseData = driver_->acquirePoseForTimestamp(frameTimestamp);
-
-                if (poseData) {
-                    // Transform pose from OpenXR to Vuforia CV convention
-                    float transformedPosition[3];
-                    float transformedRotation[9];  // 3x3 rotation matrix
-
-                    transformOpenXRToCV(poseData->position, poseData->rotation,
-                                       transformedPosition, transformedRotation);
-
-                    // Prepare Vuforia pose structure
-                    VuforiaDriver::Pose vuforiaPose;
-                    vuforiaPose.timestamp = frameTimestamp;
-                    memcpy(vuforiaPose.translationData, transformedPosition, 3 * sizeof(float));
-                    memcpy(vuforiaPose.rotationData, transformedRotation, 9 * sizeof(float));
-                    vuforiaPose.reason = VuforiaDriver::PoseReason::VALID;
-                    vuforiaPose.coordinateSystem = VuforiaDriver::PoseCoordSystem::CAMERA;
-                    vuforiaPose.validity = VuforiaDriver::PoseValidity::VALID;
-
-                    // **CRITICAL:** Deliver pose BEFORE frame
-                    // This is a requirement of the Vuforia Driver Framework
-                    callback_->onNewPose(&vuforiaPose);
-
-                    lastPoseTimestamp_ = frameTimestamp;
-                    poseCount++;
-
-                    if (poseCount % 30 == 0) {
-                        LOGD("Delivered %d poses (latest timestamp: %lld)",
-                             poseCount, (long long)frameTimestamp);
-                    }
-                } else {
-                    LOGD("No pose available for timestamp %lld", (long long)frameTimestamp);
-                }
-            }
+        flushAnchorUpdates();
+
+        if (driver_->poseStreamingEnabled()) {
+            // Tracker-rate delivery; frame poses are emitted by the camera
+            // thread right before each frame. Samples are released as frames
+            // are queued (the horizon only moves then).
+            streamPoses();
+            driver_->waitForNewFrame(&frameSequence,
+                std::chrono::duration_cast<std::chrono::nanoseconds>(pollInterval).count());
+            continue;
+        }
+
+        // Frame the camera thread delivers next (peek only; the camera
+        // thread commits the pick)
+        auto frameData = driver_->peekFrame();
+
+        // Only deliver pose if timestamp is new (avoid duplicates)
+        if (frameData && frameData->timestamp != lastPoseTimestamp_) {
+            deliverFramePose(*frameData);
         }
 
         // Sleep to avoid busy waiting
@@ -192,100 +230,157 @@ void QuestExternalTracker::poseDeliveryThread() {
             pollEndTime - pollStartTime);
 
         if (elapsed < pollInterval) {
-            std::this_thread::sleep_for(pollInterval - elapsed);
+            if (driver_->poseJoinEnabled()) {
+                // Wake as soon as the next frame is queued so the camera
+                // thread is not held for a full poll interval
+                driver_->waitForNewFrame(&frameSequence,
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(pollInterval - elapsed).count());
+            } else {
+                std::this_thread::sleep_for(pollInterval - elapsed);
+            }
         }
     }
 
-    LOGI("Pose delivery thread stopped (delivered %d poses)", poseCount);
+    LOGI("Pose delivery thread stopped (delivered %lld frame poses, %lld streamed poses)",
+         (long long)framePoseCount_.load(), (long long)streamedPoseCount_.load());
 }
 
-// =============================================================================
-// Coordinate System Transformation
-// =============================================================================
+bool QuestExternalTracker::deliverFramePose(const CameraFrameData& frame) {
+    if (!callback_) {
+        return false;
+    }
 
-void QuestExternalTracker::transformOpenXRToCV(const float* positionIn, const float* rotationIn,
-                                               float* positionOut, float* rotationOut) {
-    /**
-     * Coordinate system transformation:
-     *
-     * Unity/OpenXR convention:
-     *   X: Right
-     *   Y: Up
-     *   Z: Back (toward user)
-     *   Handedness: Left-handed
-     *
-     * Vuforia CV convention:
-     *   X: Right
-     *   Y: Down
-     *   Z: Away from camera (into scene)
-     *   Handedness: Right-handed
-     *
-     * Transformation:
-     *   X' = X (unchanged)
-     *   Y' = -Y (flip Y axis: up → down)
-     *   Z' = -Z (flip Z axis: back → forward)
-     */
-
-    // Transform position
-    positionOut[0] = positionIn[0];   // X unchanged
-    positionOut[1] = -positionIn[1];  // Y flipped
-    positionOut[2] = -positionIn[2];  // Z flipped
-
-    // Transform rotation (quaternion to rotation matrix)
-    // Input quaternion: (x, y, z, w)
-    float qx = rotationIn[0];
-    float qy = rotationIn[1];
-    float qz = rotationIn[2];
-    float qw = rotationIn[3];
-
-    // Apply 180-degree rotation around X-axis to flip Y and Z
-    // This is equivalent to: R_cv = R_x(180°) * R_openxr
-    // R_x(180°) = [1, 0, 0; 0, -1, 0; 0, 0, -1]
-
-    // Transform the quaternion
-    // q' = q_x(180°) * q_openxr
-    // q_x(180°) = (1, 0, 0, 0) - represents 180° rotation around X
-    float transformedQuat[4];
-    transformedQuat[0] = qw;   // x' = w (from quaternion multiplication)
-    transformedQuat[1] = -qz;  // y' = -z
-    transformedQuat[2] = -qy;  // z' = -y
-    transformedQuat[3] = qx;   // w' = x
-
-    // Convert transformed quaternion to 3x3 rotation matrix (row-major)
-    quaternionToMatrix(transformedQuat, rotationOut);
+    const int64_t frameTimestamp = frame.timestamp;
+
+    // Acquire pose for this frame's timestamp. With the join enabled, hold
+    // briefly for a sample at or after the frame so it is interpolated; on
+    // timeout, extrapolate instead.
+    PoseData poseData;
+    const bool joined = driver_->waitForBracketingPose(frameTimestamp);
+
+    if (!driver_->acquirePoseForTimestamp(frameTimestamp, &poseData, !joined)) {
+        LOGD("No pose available for timestamp %lld", (long long)frameTimestamp);
+        return false;
+    }
+
+    // Head pose -> pose of the camera that captured the frame
+    driver_->composeCameraPose(frame.cameraId, &poseData);
+
+    // Confidence, lookup gap, relocalization and motion
+    VuforiaDriver::PoseReason reason;
+    VuforiaDriver::PoseValidity validity;
+    driver_->classifyPose(poseData, &reason, &validity);
+
+    // Frames gated for brightness are not delivered; flag their poses unless
+    // the tracker itself is not settled
+    if (frame.lowLight && reason != VuforiaDriver::PoseReason::INITIALIZING &&
+        reason != VuforiaDriver::PoseReason::RELOCALIZING) {
+        reason = VuforiaDriver::PoseReason::INSUFFICIENT_LIGHT;
+        validity = VuforiaDriver::PoseValidity::UNRELIABLE;
+    }
+
+    // **CRITICAL:** Deliver pose BEFORE frame
+    // This is a requirement of the Vuforia Driver Framework
+    float transformedPosition[3];
+    float transformedRotation[9];  // 3x3 rotation matrix
+    transformOpenXRToCV(poseData.position, poseData.rotation,
+                        transformedPosition, transformedRotation);
+    emitPose(transformedPosition, transformedRotation, frameTimestamp, reason, validity);
+    driver_->notifyPoseDelivered(frameTimestamp);
+
+    lastPoseTimestamp_ = frameTimestamp;
+    lastPoseCamera_ = frame.cameraId;
+    const int64_t poseCount = ++framePoseCount_;
+
+    if (poseCount % 30 == 0) {
+        LOGD("Delivered %lld frame poses (latest timestamp: %lld)",
+             (long long)poseCount, (long long)frameTimestamp);
+    }
+    return true;
+}
+
+void QuestExternalTracker::streamPoses() {
+    std::lock_guard<std::mutex> lock(driver_->poseDeliveryMutex());
+    // Samples after the last posed frame follow the camera that captured it
+    streamPosesBefore(driver_->poseStreamHorizon(lastPoseTimestamp_), lastPoseCamera_);
 }
 
-void QuestExternalTracker::quaternionToMatrix(const float* quat, float* matrix) {
-    /**
-     * Convert quaternion (x, y, z, w) to 3x3 rotation matrix (row-major)
-     * Reference: https://www.euclideanspace.com/maths/geometry/rotations/conversions/quaternionToMatrix/
-     */
-
-    float x = quat[0];
-    float y = quat[1];
-    float z = quat[2];
-    float w = quat[3];
-
-    float xx = x * x;
-    float xy = x * y;
-    float xz = x * z;
-    float xw = x * w;
-    float yy = y * y;
-    float yz = y * z;
-    float yw = y * w;
-    float zz = z * z;
-    float zw = z * w;
-
-    // Row-major 3x3 matrix
-    matrix[0] = 1.0f - 2.0f * (yy + zz);  // m00
-    matrix[1] = 2.0f * (xy - zw);         // m01
-    matrix[2] = 2.0f * (xz + yw);         // m02
-
-    matrix[3] = 2.0f * (xy + zw);         // m10
-    matrix[4] = 1.0f - 2.0f * (xx + zz);  // m11
-    matrix[5] = 2.0f * (yz - xw);         // m12
-
-    matrix[6] = 2.0f * (xz - yw);         // m20
-    matrix[7] = 2.0f * (yz + xw);         // m21
-    matrix[8] = 1.0f - 2.0f * (xx + yy);  // m22
+void QuestExternalTracker::streamPosesBefore(int64_t horizon, int cameraId) {
+    if (!callback_) {
+        return;
+    }
+
+    PoseData samples[STREAM_BATCH_SIZE];
+    const uint32_t count = driver_->latestPoseSamples(samples, STREAM_BATCH_SIZE);
+
+    // Samples after the last delivered pose (including frame poses); newer
+    // ones wait until the frame before them has been posed
+    uint32_t first = 0;
+    while (first < count && samples[first].timestamp <= lastEmittedTimestamp_.load()) {
+        first++;
+    }
+    uint32_t end = count;
+    while (end > first && samples[end - 1].timestamp >= horizon) {
+        end--;
+    }
+    const uint32_t pending = end - first;
+    if (pending == 0) {
+        return;
+    }
+
+    for (uint32_t i = first; i < end; i++) {
+        driver_->composeCameraPose(cameraId, &samples[i]);
+    }
+
+    // Convert the whole batch at once (vectorized quaternion -> matrix)
+    float positions[STREAM_BATCH_SIZE * 3];
+    float quaternions[STREAM_BATCH_SIZE * 4];
+    float scratch[STREAM_BATCH_SIZE * 4];
+    float positionsOut[STREAM_BATCH_SIZE * 3];
+    float matricesOut[STREAM_BATCH_SIZE * 9];
+    for (uint32_t i = 0; i < pending; i++) {
+        memcpy(positions + i * 3, samples[first + i].position, 3 * sizeof(float));
+        memcpy(quaternions + i * 4, samples[first + i].rotation, 4 * sizeof(float));
+    }
+    for (uint32_t i = 0; i < pending; i++) {
+        PositionToCV::position(positions + i * 3, positionsOut + i * 3);
+    }
+    RotationToCV::matrices(quaternions, pending, scratch, matricesOut);
+
+    for (uint32_t i = 0; i < pending; i++) {
+        const PoseData& sample = samples[first + i];
+        VuforiaDriver::PoseReason reason;
+        VuforiaDriver::PoseValidity validity;
+        driver_->classifyPose(sample, &reason, &validity);
+        emitPose(positionsOut + i * 3, matricesOut + i * 9, sample.timestamp, reason, validity);
+
+        const int64_t streamed = ++streamedPoseCount_;
+        if (streamed % 300 == 0) {
+            LOGD("Streamed %lld poses between %lld frame poses",
+                 (long long)streamed, (long long)framePoseCount_.load());
+        }
+    }
+}
+
+void QuestExternalTracker::emitPose(const float* position, const float* rotation, int64_t timestamp,
+                                    VuforiaDriver::PoseReason reason,
+                                    VuforiaDriver::PoseValidity validity) {
+    // Prepare Vuforia pose structure
+    VuforiaDriver::Pose vuforiaPose;
+    vuforiaPose.timestamp = timestamp;
+    memcpy(vuforiaPose.translationData, position, 3 * sizeof(float));
+    memcpy(vuforiaPose.rotationData, rotation, 9 * sizeof(float));
+    vuforiaPose.coordinateSystem = VuforiaDriver::PoseCoordSystem::CAMERA;
+    vuforiaPose.reason = reason;
+    vuforiaPose.validity = validity;
+
+    {
+        TraceScope trace(driver_->traceRecorder(), "onNewPose", timestamp);
+        callback_->onNewPose(&vuforiaPose);
+    }
+    driver_->pipelineStats().countPoseDelivered();
+
+    if (timestamp > lastEmittedTimestamp_.load()) {
+        lastEmittedTimestamp_ = timestamp;
+    }
 }
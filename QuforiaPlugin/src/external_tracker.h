@@ -2,12 +2,15 @@
 #define QUEST_EXTERNAL_TRACKER_H
 
 #include <VuforiaEngine/Driver/Driver.h>
+#include "anchor_store.h"
 #include <thread>
 #include <atomic>
 #include <mutex>
 
-// Forward declaration
+// Forward declarations
 class QuestVuforiaDriver;
+struct CameraFrameData;
+struct PoseData;
 
 /**
  * ExternalPositionalDeviceTracker implementation for Meta Quest 6DoF tracking.
@@ -25,25 +28,54 @@ public:
     virtual bool stop() override;
     virtual bool resetTracking() override;
 
+    // Anchors (stored natively, kept in place by Unity spatial anchors)
+    virtual bool isAnchorSupported() override;
+    virtual const char* createAnchor(VuforiaDriver::AnchorPose* anchorPose) override;
+    virtual bool removeAnchor(const char* uuid) override;
+
+    // Deliver the pose for a frame's timestamp. Called from the pose thread,
+    // or from the camera thread (under the driver's pose delivery mutex) when
+    // pose streaming is enabled so the frame can follow immediately.
+    bool deliverFramePose(const CameraFrameData& frame);
+    // Stream the pending samples older than horizon, composed with the
+    // extrinsics of cameraId (caller holds the driver's pose delivery mutex)
+    void streamPosesBefore(int64_t horizon, int cameraId);
+
 private:
     // Pose delivery thread
     void poseDeliveryThread();
 
-    // Coordinate transformation: OpenXR to Vuforia CV convention
-    void transformOpenXRToCV(const float* positionIn, const float* rotationIn,
-                            float* positionOut, float* rotationOut);
+    // Pose streaming: forward every pose sample newer than the last delivered
+    // pose and older than the driver's stream horizon
+    void streamPoses();
+
+    // Hand a pose already in Vuforia CV convention to the callback
+    void emitPose(const float* position, const float* rotation, int64_t timestamp,
+                  VuforiaDriver::PoseReason reason, VuforiaDriver::PoseValidity validity);
+    static const uint32_t STREAM_BATCH_SIZE = 32;  // Covers the hold-back (about a frame interval)
 
-    // Quaternion to rotation matrix conversion
-    void quaternionToMatrix(const float* quat, float* matrix);
+    // Report pending anchor changes, one onAnchorUpdate call per status
+    void flushAnchorUpdates();
 
     QuestVuforiaDriver* driver_;
     VuforiaDriver::PoseCallback* callback_;
+    VuforiaDriver::AnchorCallback* anchorCallback_;
+
+    // Anchor batch scratch (only touched by the pose delivery thread)
+    VuforiaDriver::Anchor anchorBatch_[AnchorStore::MAX_ANCHORS];
+    char anchorUuids_[AnchorStore::MAX_ANCHORS * ANCHOR_UUID_LENGTH];
 
     std::thread poseThread_;
     std::atomic<bool> isRunning_;
     std::atomic<bool> isOpen_;
 
-    int64_t lastPoseTimestamp_;
+    int64_t lastPoseTimestamp_;  // Last frame timestamp a pose was delivered for
+    int lastPoseCamera_;         // Camera that captured that frame
+
+    // Newest timestamp handed to onNewPose (keeps the streamed sequence monotonic)
+    std::atomic<int64_t> lastEmittedTimestamp_;
+    std::atomic<int64_t> framePoseCount_;
+    std::atomic<int64_t> streamedPoseCount_;
 };
 
 #endif // QUEST_EXTERNAL_TRACKER_H
@@ -0,0 +1,364 @@
+#include "frame_converter.h"
+#include <cstring>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define QUFORIA_HAS_NEON 1
+#endif
+
+// =============================================================================
+// Format Helpers
+// =============================================================================
+
+int bytesPerPixel(VuforiaDriver::PixelFormat format) {
+    switch (format) {
+        case VuforiaDriver::PixelFormat::RGB888:
+            return 3;
+        case VuforiaDriver::PixelFormat::RGBA8888:
+            return 4;
+        default:
+            return 0;
+    }
+}
+
+bool isYUV420Format(VuforiaDriver::PixelFormat format) {
+    return format == VuforiaDriver::PixelFormat::NV12 ||
+           format == VuforiaDriver::PixelFormat::NV21 ||
+           format == VuforiaDriver::PixelFormat::YUV420P;
+}
+
+int frameStride(VuforiaDriver::PixelFormat format, int width) {
+    if (isYUV420Format(format)) {
+        return width;  // Y plane stride
+    }
+    return width * bytesPerPixel(format);
+}
+
+uint32_t frameBufferSize(VuforiaDriver::PixelFormat format, int width, int height) {
+    if (isYUV420Format(format)) {
+        // Full-res Y + two quarter-res chroma planes (1.5 bytes per pixel)
+        return (uint32_t)(width * height + 2 * (width / 2) * (height / 2));
+    }
+    return (uint32_t)(width * height * bytesPerPixel(format));
+}
+
+// Source row for a given destination row (handles vertical flip)
+static inline const uint8_t* srcRow(const uint8_t* src, int srcStride, int row, int height, bool flip) {
+    return src + (size_t)(flip ? (height - 1 - row) : row) * srcStride;
+}
+
+// =============================================================================
+// Copy / Repack Kernels
+// =============================================================================
+
+void copyImage(const uint8_t* src, int srcStride,
+               uint8_t* dst, int dstStride,
+               int rowBytes, int height, bool flipVertically) {
+    // Contiguous and unflipped: single copy
+    if (!flipVertically && srcStride == rowBytes && dstStride == rowBytes) {
+        memcpy(dst, src, (size_t)rowBytes * height);
+        return;
+    }
+
+    for (int y = 0; y < height; y++) {
+        memcpy(dst + (size_t)y * dstStride,
+               srcRow(src, srcStride, y, height, flipVertically), rowBytes);
+    }
+}
+
+void convertRGBAToRGB(const uint8_t* src, int srcStride,
+                      uint8_t* dst, int dstStride,
+                      int width, int height, bool flipVertically) {
+    for (int y = 0; y < height; y++) {
+        const uint8_t* s = srcRow(src, srcStride, y, height, flipVertically);
+        uint8_t* d = dst + (size_t)y * dstStride;
+        int x = 0;
+
+#ifdef QUFORIA_HAS_NEON
+        // 16 pixels per iteration: de-interleave 4 channels, re-interleave 3
+        for (; x + 16 <= width; x += 16) {
+            uint8x16x4_t rgba = vld4q_u8(s + x * 4);
+            uint8x16x3_t rgb;
+            rgb.val[0] = rgba.val[0];
+            rgb.val[1] = rgba.val[1];
+            rgb.val[2] = rgba.val[2];
+            vst3q_u8(d + x * 3, rgb);
+        }
+#endif
+
+        for (; x < width; x++) {
+            d[x * 3 + 0] = s[x * 4 + 0];
+            d[x * 3 + 1] = s[x * 4 + 1];
+            d[x * 3 + 2] = s[x * 4 + 2];
+        }
+    }
+}
+
+void convertRGBToRGBA(const uint8_t* src, int srcStride,
+                      uint8_t* dst, int dstStride,
+                      int width, int height, bool flipVertically) {
+    for (int y = 0; y < height; y++) {
+        const uint8_t* s = srcRow(src, srcStride, y, height, flipVertically);
+        uint8_t* d = dst + (size_t)y * dstStride;
+        int x = 0;
+
+#ifdef QUFORIA_HAS_NEON
+        const uint8x16_t alpha = vdupq_n_u8(255);
+        for (; x + 16 <= width; x += 16) {
+            uint8x16x3_t rgb = vld3q_u8(s + x * 3);
+            uint8x16x4_t rgba;
+            rgba.val[0] = rgb.val[0];
+            rgba.val[1] = rgb.val[1];
+            rgba.val[2] = rgb.val[2];
+            rgba.val[3] = alpha;
+            vst4q_u8(d + x * 4, rgba);
+        }
+#endif
+
+        for (; x < width; x++) {
+            d[x * 4 + 0] = s[x * 3 + 0];
+            d[x * 4 + 1] = s[x * 3 + 1];
+            d[x * 4 + 2] = s[x * 3 + 2];
+            d[x * 4 + 3] = 255;
+        }
+    }
+}
+
+// =============================================================================
+// RGB -> YUV 4:2:0 Kernels (BT.601 video range)
+// =============================================================================
+
+static inline uint8_t rgbToY(int r, int g, int b) {
+    return (uint8_t)(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+}
+
+static inline uint8_t rgbToU(int r, int g, int b) {
+    return (uint8_t)(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+}
+
+static inline uint8_t rgbToV(int r, int g, int b) {
+    return (uint8_t)(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+}
+
+#ifdef QUFORIA_HAS_NEON
+// Load 16 pixels as separate R, G, B vectors (alpha discarded)
+template <int BPP>
+static inline uint8x16x3_t loadRGB16(const uint8_t* p);
+
+template <>
+inline uint8x16x3_t loadRGB16<3>(const uint8_t* p) {
+    return vld3q_u8(p);
+}
+
+template <>
+inline uint8x16x3_t loadRGB16<4>(const uint8_t* p) {
+    uint8x16x4_t rgba = vld4q_u8(p);
+    uint8x16x3_t rgb;
+    rgb.val[0] = rgba.val[0];
+    rgb.val[1] = rgba.val[1];
+    rgb.val[2] = rgba.val[2];
+    return rgb;
+}
+
+static inline uint8x16_t lumaNeon(const uint8x16x3_t& rgb) {
+    const uint8x8_t kR = vdup_n_u8(66);
+    const uint8x8_t kG = vdup_n_u8(129);
+    const uint8x8_t kB = vdup_n_u8(25);
+
+    uint16x8_t lo = vmull_u8(vget_low_u8(rgb.val[0]), kR);
+    lo = vmlal_u8(lo, vget_low_u8(rgb.val[1]), kG);
+    lo = vmlal_u8(lo, vget_low_u8(rgb.val[2]), kB);
+    uint16x8_t hi = vmull_u8(vget_high_u8(rgb.val[0]), kR);
+    hi = vmlal_u8(hi, vget_high_u8(rgb.val[1]), kG);
+    hi = vmlal_u8(hi, vget_high_u8(rgb.val[2]), kB);
+
+    uint8x16_t y = vcombine_u8(vrshrn_n_u16(lo, 8), vrshrn_n_u16(hi, 8));
+    return vaddq_u8(y, vdupq_n_u8(16));
+}
+
+// Average each 2x2 block of one channel across two rows (16 -> 8 values)
+static inline int16x8_t average2x2Neon(uint8x16_t row0, uint8x16_t row1) {
+    uint16x8_t sum = vpaddlq_u8(row0);
+    sum = vpadalq_u8(sum, row1);
+    return vreinterpretq_s16_u16(vrshrq_n_u16(sum, 2));
+}
+
+static inline uint8x8_t chromaNeon(int16x8_t r, int16x8_t g, int16x8_t b,
+                                   int16_t kr, int16_t kg, int16_t kb) {
+    int16x8_t acc = vmulq_n_s16(r, kr);
+    acc = vmlaq_n_s16(acc, g, kg);
+    acc = vmlaq_n_s16(acc, b, kb);
+    acc = vrshrq_n_s16(acc, 8);
+    return vqmovun_s16(vaddq_s16(acc, vdupq_n_s16(128)));
+}
+#endif
+
+template <int BPP>
+static void lumaRow(const uint8_t* s, uint8_t* d, int width) {
+    int x = 0;
+
+#ifdef QUFORIA_HAS_NEON
+    for (; x + 16 <= width; x += 16) {
+        vst1q_u8(d + x, lumaNeon(loadRGB16<BPP>(s + x * BPP)));
+    }
+#endif
+
+    for (; x < width; x++) {
+        const uint8_t* p = s + x * BPP;
+        d[x] = rgbToY(p[0], p[1], p[2]);
+    }
+}
+
+template <int BPP>
+static void convertRGBToYUV420Impl(const uint8_t* src, int srcStride,
+                                   uint8_t* dst, VuforiaDriver::PixelFormat dstFormat,
+                                   int width, int height, bool flip) {
+    const int chromaWidth = width / 2;
+    uint8_t* yPlane = dst;
+    uint8_t* chromaPlane = dst + (size_t)width * height;
+    const size_t chromaPlaneSize = (size_t)chromaWidth * (height / 2);
+
+    // Offsets of U and V within the chroma plane(s) and their pixel step
+    const bool semiPlanar = dstFormat != VuforiaDriver::PixelFormat::YUV420P;
+    const int uvStep = semiPlanar ? 2 : 1;
+    const int uvStride = semiPlanar ? width : chromaWidth;
+    uint8_t* uBase = chromaPlane;
+    uint8_t* vBase = chromaPlane;
+    if (dstFormat == VuforiaDriver::PixelFormat::NV12) {
+        vBase = chromaPlane + 1;
+    } else if (dstFormat == VuforiaDriver::PixelFormat::NV21) {
+        uBase = chromaPlane + 1;
+    } else {
+        vBase = chromaPlane + chromaPlaneSize;
+    }
+
+    for (int y = 0; y + 1 < height; y += 2) {
+        const uint8_t* s0 = srcRow(src, srcStride, y, height, flip);
+        const uint8_t* s1 = srcRow(src, srcStride, y + 1, height, flip);
+        uint8_t* y0 = yPlane + (size_t)y * width;
+        uint8_t* y1 = y0 + width;
+        uint8_t* u = uBase + (size_t)(y / 2) * uvStride;
+        uint8_t* v = vBase + (size_t)(y / 2) * uvStride;
+        int x = 0;
+
+#ifdef QUFORIA_HAS_NEON
+        for (; x + 16 <= width; x += 16) {
+            uint8x16x3_t p0 = loadRGB16<BPP>(s0 + x * BPP);
+            uint8x16x3_t p1 = loadRGB16<BPP>(s1 + x * BPP);
+
+            vst1q_u8(y0 + x, lumaNeon(p0));
+            vst1q_u8(y1 + x, lumaNeon(p1));
+
+            int16x8_t r = average2x2Neon(p0.val[0], p1.val[0]);
+            int16x8_t g = average2x2Neon(p0.val[1], p1.val[1]);
+            int16x8_t b = average2x2Neon(p0.val[2], p1.val[2]);
+            uint8x8_t uVals = chromaNeon(r, g, b, -38, -74, 112);
+            uint8x8_t vVals = chromaNeon(r, g, b, 112, -94, -18);
+
+            const int cx = x / 2;
+            if (semiPlanar) {
+                // Interleave into UV (NV12) or VU (NV21) byte pairs
+                uint8x8x2_t uv;
+                uv.val[0] = (dstFormat == VuforiaDriver::PixelFormat::NV12) ? uVals : vVals;
+                uv.val[1] = (dstFormat == VuforiaDriver::PixelFormat::NV12) ? vVals : uVals;
+                vst2_u8(chromaPlane + (size_t)(y / 2) * uvStride + cx * 2, uv);
+            } else {
+                vst1_u8(u + cx, uVals);
+                vst1_u8(v + cx, vVals);
+            }
+        }
+#endif
+
+        for (; x + 1 < width; x += 2) {
+            const uint8_t* a = s0 + x * BPP;
+            const uint8_t* b = a + BPP;
+            const uint8_t* c = s1 + x * BPP;
+            const uint8_t* d = c + BPP;
+
+            y0[x] = rgbToY(a[0], a[1], a[2]);
+            y0[x + 1] = rgbToY(b[0], b[1], b[2]);
+            y1[x] = rgbToY(c[0], c[1], c[2]);
+            y1[x + 1] = rgbToY(d[0], d[1], d[2]);
+
+            int r = (a[0] + b[0] + c[0] + d[0] + 2) >> 2;
+            int g = (a[1] + b[1] + c[1] + d[1] + 2) >> 2;
+            int bl = (a[2] + b[2] + c[2] + d[2] + 2) >> 2;
+
+            const int cx = (x / 2) * uvStep;
+            u[cx] = rgbToU(r, g, bl);
+            v[cx] = rgbToV(r, g, bl);
+        }
+    }
+}
+
+void convertRGBToYUV420(const uint8_t* src, int srcStride, VuforiaDriver::PixelFormat srcFormat,
+                        uint8_t* dst, VuforiaDriver::PixelFormat dstFormat,
+                        int width, int height, bool flipVertically) {
+    if (srcFormat == VuforiaDriver::PixelFormat::RGBA8888) {
+        convertRGBToYUV420Impl<4>(src, srcStride, dst, dstFormat, width, height, flipVertically);
+    } else {
+        convertRGBToYUV420Impl<3>(src, srcStride, dst, dstFormat, width, height, flipVertically);
+    }
+}
+
+void convertRGBToLuma(const uint8_t* src, int srcStride, VuforiaDriver::PixelFormat srcFormat,
+                      uint8_t* dst, int dstStride,
+                      int width, int height, bool flipVertically) {
+    for (int y = 0; y < height; y++) {
+        const uint8_t* s = srcRow(src, srcStride, y, height, flipVertically);
+        uint8_t* d = dst + (size_t)y * dstStride;
+        if (srcFormat == VuforiaDriver::PixelFormat::RGBA8888) {
+            lumaRow<4>(s, d, width);
+        } else {
+            lumaRow<3>(s, d, width);
+        }
+    }
+}
+
+void fillNeutralChroma(uint8_t* dst, int width, int height) {
+    memset(dst + (size_t)width * height, 128, 2 * (size_t)(width / 2) * (height / 2));
+}
+
+// =============================================================================
+// Dispatch
+// =============================================================================
+
+bool convertFrame(const uint8_t* src, int srcStride, VuforiaDriver::PixelFormat srcFormat,
+                  uint8_t* dst, VuforiaDriver::PixelFormat dstFormat,
+                  int width, int height, bool flipVertically, bool grayscaleOnly) {
+    if (srcFormat != VuforiaDriver::PixelFormat::RGB888 &&
+        srcFormat != VuforiaDriver::PixelFormat::RGBA8888) {
+        return false;
+    }
+
+    if (srcFormat == dstFormat) {
+        // Same layout: pass pixels through untouched (row copy only)
+        const int rowBytes = frameStride(dstFormat, width);
+        copyImage(src, srcStride, dst, rowBytes, rowBytes, height, flipVertically);
+        return true;
+    }
+
+    switch (dstFormat) {
+        case VuforiaDriver::PixelFormat::RGB888:
+            convertRGBAToRGB(src, srcStride, dst, frameStride(dstFormat, width),
+                             width, height, flipVertically);
+            return true;
+        case VuforiaDriver::PixelFormat::RGBA8888:
+            convertRGBToRGBA(src, srcStride, dst, frameStride(dstFormat, width),
+                             width, height, flipVertically);
+            return true;
+        case VuforiaDriver::PixelFormat::NV12:
+        case VuforiaDriver::PixelFormat::NV21:
+        case VuforiaDriver::PixelFormat::YUV420P:
+            if (grayscaleOnly) {
+                convertRGBToLuma(src, srcStride, srcFormat, dst, width,
+                                 width, height, flipVertically);
+            } else {
+                convertRGBToYUV420(src, srcStride, srcFormat, dst, dstFormat,
+                                   width, height, flipVertically);
+            }
+            return true;
+        default:
+            return false;
+    }
+}
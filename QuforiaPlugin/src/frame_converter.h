@@ -0,0 +1,70 @@
+#ifndef QUEST_FRAME_CONVERTER_H
+#define QUEST_FRAME_CONVERTER_H
+
+#include <VuforiaEngine/Driver/Driver.h>
+#include <cstdint>
+
+/**
+ * Pixel conversion kernels used during frame ingestion.
+ *
+ * All functions take explicit strides (in bytes) so they can read straight
+ * from the Unity-provided buffer and write into the frame slot handed to
+ * Vuforia. When flipVertically is set, source row 0 is written to the last
+ * destination row, which lets the flip ride along with the copy for free.
+ *
+ * YUV outputs use BT.601 video range with chroma averaged over 2x2 blocks.
+ * Planar/semi-planar buffers are contiguous: Y plane (stride = width)
+ * followed by the chroma plane(s). Width and height must be even.
+ *
+ * NEON paths are used on arm64; a scalar fallback is kept for other targets.
+ */
+
+// Bytes per pixel for the packed formats (0 for planar / unknown formats)
+int bytesPerPixel(VuforiaDriver::PixelFormat format);
+
+// True for the 4:2:0 formats (NV12, NV21, YUV420P)
+bool isYUV420Format(VuforiaDriver::PixelFormat format);
+
+// Row stride of the first plane in bytes
+int frameStride(VuforiaDriver::PixelFormat format, int width);
+
+// Total buffer size for a frame of the given format and size
+uint32_t frameBufferSize(VuforiaDriver::PixelFormat format, int width, int height);
+
+// Row-by-row copy (used for same-format passthrough)
+void copyImage(const uint8_t* src, int srcStride,
+               uint8_t* dst, int dstStride,
+               int rowBytes, int height, bool flipVertically);
+
+// RGBA8888 -> RGB888 (drops alpha)
+void convertRGBAToRGB(const uint8_t* src, int srcStride,
+                      uint8_t* dst, int dstStride,
+                      int width, int height, bool flipVertically);
+
+// RGB888 -> RGBA8888 (alpha set to 255)
+void convertRGBToRGBA(const uint8_t* src, int srcStride,
+                      uint8_t* dst, int dstStride,
+                      int width, int height, bool flipVertically);
+
+// RGB888/RGBA8888 -> NV12, NV21 or YUV420P (Y and chroma in a single pass)
+void convertRGBToYUV420(const uint8_t* src, int srcStride, VuforiaDriver::PixelFormat srcFormat,
+                        uint8_t* dst, VuforiaDriver::PixelFormat dstFormat,
+                        int width, int height, bool flipVertically);
+
+// RGB888/RGBA8888 -> Y plane only (chroma is left untouched)
+void convertRGBToLuma(const uint8_t* src, int srcStride, VuforiaDriver::PixelFormat srcFormat,
+                      uint8_t* dst, int dstStride,
+                      int width, int height, bool flipVertically);
+
+// Fill the chroma plane(s) of a 4:2:0 frame with neutral grey (128)
+void fillNeutralChroma(uint8_t* dst, int width, int height);
+
+// Convert a packed source frame into any supported output format.
+// With grayscaleOnly set, 4:2:0 outputs only get their Y plane written;
+// the caller is responsible for the chroma planes (see fillNeutralChroma).
+// Returns false if the conversion is not supported.
+bool convertFrame(const uint8_t* src, int srcStride, VuforiaDriver::PixelFormat srcFormat,
+                  uint8_t* dst, VuforiaDriver::PixelFormat dstFormat,
+                  int width, int height, bool flipVertically, bool grayscaleOnly);
+
+#endif // QUEST_FRAME_CONVERTER_H
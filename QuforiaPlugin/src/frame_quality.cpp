@@ -0,0 +1,143 @@
+#include "frame_quality.h"
+#include "frame_converter.h"
+#include <cstddef>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define QUFORIA_HAS_NEON 1
+#endif
+
+void FrameQualityAnalyzer::decimateRow(const uint8_t* buffer, VuforiaDriver::PixelFormat format,
+                                       int width, int stride, int y, uint8_t* out) {
+    const uint8_t* row = buffer + (size_t)y * stride;
+    const int outWidth = width / 2;
+    int x = 0;
+
+    if (isYUV420Format(format)) {
+#ifdef QUFORIA_HAS_NEON
+        for (; x + 16 <= outWidth; x += 16) {
+            vst1q_u8(out + x, vld2q_u8(row + x * 2).val[0]);
+        }
+#endif
+        for (; x < outWidth; x++) {
+            out[x] = row[x * 2];
+        }
+        return;
+    }
+
+    // Packed RGB: green channel of every other pixel
+    const int bpp = bytesPerPixel(format);
+#ifdef QUFORIA_HAS_NEON
+    for (; x + 16 <= outWidth; x += 16) {
+        const uint8_t* p = row + x * 2 * bpp;
+        uint8x16_t g0, g1;
+        if (bpp == 4) {
+            g0 = vld4q_u8(p).val[1];
+            g1 = vld4q_u8(p + 64).val[1];
+        } else {
+            g0 = vld3q_u8(p).val[1];
+            g1 = vld3q_u8(p + 48).val[1];
+        }
+        vst1q_u8(out + x, vuzpq_u8(g0, g1).val[0]);
+    }
+#endif
+    for (; x < outWidth; x++) {
+        out[x] = row[x * 2 * bpp + 1];
+    }
+}
+
+float FrameQualityAnalyzer::computeSharpness(const uint8_t* buffer, VuforiaDriver::PixelFormat format,
+                                             int width, int height, int stride) {
+    const int dw = width / 2;
+    const int dh = height / 2;
+    if (dw < 3 || dh < 3) {
+        return 0.0f;
+    }
+
+    rows_.resize((size_t)dw * 3);
+    uint8_t* rows[3] = { rows_.data(), rows_.data() + dw, rows_.data() + 2 * dw };
+    decimateRow(buffer, format, width, stride, 0, rows[0]);
+    decimateRow(buffer, format, width, stride, 2, rows[1]);
+
+    int64_t sum = 0;
+    int64_t sumSq = 0;
+
+    for (int y = 1; y < dh - 1; y++) {
+        decimateRow(buffer, format, width, stride, (y + 1) * 2, rows[2]);
+        const uint8_t* up = rows[0];
+        const uint8_t* mid = rows[1];
+        const uint8_t* down = rows[2];
+        int x = 1;
+
+#ifdef QUFORIA_HAS_NEON
+        // Row partial sums fit int32 lanes (|lap| <= 1020)
+        int32x4_t rowSum = vdupq_n_s32(0);
+        int32x4_t rowSq = vdupq_n_s32(0);
+        for (; x + 8 <= dw - 1; x += 8) {
+            int16x8_t c = vreinterpretq_s16_u16(vshll_n_u8(vld1_u8(mid + x), 2));
+            int16x8_t n = vreinterpretq_s16_u16(vaddl_u8(vld1_u8(mid + x - 1), vld1_u8(mid + x + 1)));
+            n = vaddq_s16(n, vreinterpretq_s16_u16(vaddl_u8(vld1_u8(up + x), vld1_u8(down + x))));
+            int16x8_t lap = vsubq_s16(c, n);
+            rowSum = vpadalq_s16(rowSum, lap);
+            rowSq = vmlal_s16(rowSq, vget_low_s16(lap), vget_low_s16(lap));
+            rowSq = vmlal_s16(rowSq, vget_high_s16(lap), vget_high_s16(lap));
+        }
+        int32_t lanes[4];
+        vst1q_s32(lanes, rowSum);
+        sum += (int64_t)lanes[0] + lanes[1] + lanes[2] + lanes[3];
+        vst1q_s32(lanes, rowSq);
+        sumSq += (int64_t)lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#endif
+
+        for (; x < dw - 1; x++) {
+            const int lap = 4 * mid[x] - mid[x - 1] - mid[x + 1] - up[x] - down[x];
+            sum += lap;
+            sumSq += lap * lap;
+        }
+
+        // Rotate the row window
+        uint8_t* oldest = rows[0];
+        rows[0] = rows[1];
+        rows[1] = rows[2];
+        rows[2] = oldest;
+    }
+
+    const double count = (double)(dw - 2) * (dh - 2);
+    const double mean = sum / count;
+    return (float)(sumSq / count - mean * mean);
+}
+
+float FrameQualityAnalyzer::computeMeanLuma(const uint8_t* buffer, VuforiaDriver::PixelFormat format,
+                                            int width, int height, int stride) {
+    const int dw = width / 2;
+    if (dw < 1 || height < 1) {
+        return 0.0f;
+    }
+
+    rows_.resize((size_t)dw * 3);
+    uint8_t* row = rows_.data();
+    uint64_t sum = 0;
+    int rowCount = 0;
+
+    for (int y = 0; y < height; y += 8) {
+        decimateRow(buffer, format, width, stride, y, row);
+        int x = 0;
+
+#ifdef QUFORIA_HAS_NEON
+        uint32x4_t acc = vdupq_n_u32(0);
+        for (; x + 16 <= dw; x += 16) {
+            acc = vpadalq_u16(acc, vpaddlq_u8(vld1q_u8(row + x)));
+        }
+        uint32_t lanes[4];
+        vst1q_u32(lanes, acc);
+        sum += (uint64_t)lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#endif
+
+        for (; x < dw; x++) {
+            sum += row[x];
+        }
+        rowCount++;
+    }
+
+    return (float)((double)sum / ((double)dw * rowCount));
+}
@@ -0,0 +1,35 @@
+#ifndef QUEST_FRAME_QUALITY_H
+#define QUEST_FRAME_QUALITY_H
+
+#include <VuforiaEngine/Driver/Driver.h>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Per-frame image quality metrics computed at ingestion.
+ *
+ * Metrics run on a 2x decimated luma plane (Y plane for YUV formats, the
+ * green channel for packed RGB) so they cost a small fraction of a frame
+ * conversion. NEON paths are used on arm64.
+ *
+ * Not thread-safe: one instance per ingestion thread (scratch rows are reused).
+ */
+class FrameQualityAnalyzer {
+public:
+    // Variance of the 4-neighbour Laplacian; higher means sharper
+    float computeSharpness(const uint8_t* buffer, VuforiaDriver::PixelFormat format,
+                           int width, int height, int stride);
+
+    // Mean luma (0-255) sampled on every 4th row of the decimated plane
+    float computeMeanLuma(const uint8_t* buffer, VuforiaDriver::PixelFormat format,
+                          int width, int height, int stride);
+
+private:
+    // Decimated luma row (every other pixel) of source row y
+    void decimateRow(const uint8_t* buffer, VuforiaDriver::PixelFormat format,
+                     int width, int stride, int y, uint8_t* out);
+
+    std::vector<uint8_t> rows_;  // 3 decimated rows
+};
+
+#endif // QUEST_FRAME_QUALITY_H
@@ -0,0 +1,326 @@
+#include "frame_scaler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define QUFORIA_HAS_NEON 1
+#endif
+
+// Bilinear weights are 7-bit so both taps fit in a u8 multiply
+static const int WEIGHT_BITS = 7;
+static const int WEIGHT_ONE = 1 << WEIGHT_BITS;
+
+static inline const uint8_t* srcRow(const uint8_t* src, int srcStride, int row, int height, bool flip) {
+    return src + (size_t)(flip ? (height - 1 - row) : row) * srcStride;
+}
+
+// =============================================================================
+// Box Filters (exact 2x / 4x reduction)
+// =============================================================================
+
+template <int BPP>
+static void box2Row(const uint8_t* s0, const uint8_t* s1, uint8_t* d, int dstWidth) {
+    int x = 0;
+
+#ifdef QUFORIA_HAS_NEON
+    // 16 source pixels -> 8 destination pixels
+    for (; x + 8 <= dstWidth; x += 8) {
+        if constexpr (BPP == 4) {
+            uint8x16x4_t a = vld4q_u8(s0 + x * 8);
+            uint8x16x4_t b = vld4q_u8(s1 + x * 8);
+            uint8x8x4_t out;
+            for (int c = 0; c < 4; c++) {
+                out.val[c] = vrshrn_n_u16(vpadalq_u8(vpaddlq_u8(a.val[c]), b.val[c]), 2);
+            }
+            vst4_u8(d + x * 4, out);
+        } else {
+            uint8x16x3_t a = vld3q_u8(s0 + x * 6);
+            uint8x16x3_t b = vld3q_u8(s1 + x * 6);
+            uint8x8x3_t out;
+            for (int c = 0; c < 3; c++) {
+                out.val[c] = vrshrn_n_u16(vpadalq_u8(vpaddlq_u8(a.val[c]), b.val[c]), 2);
+            }
+            vst3_u8(d + x * 3, out);
+        }
+    }
+#endif
+
+    for (; x < dstWidth; x++) {
+        const uint8_t* a = s0 + x * 2 * BPP;
+        const uint8_t* b = s1 + x * 2 * BPP;
+        for (int c = 0; c < BPP; c++) {
+            d[x * BPP + c] = (uint8_t)((a[c] + a[c + BPP] + b[c] + b[c + BPP] + 2) >> 2);
+        }
+    }
+}
+
+template <int BPP>
+static void box4Row(const uint8_t* const s[4], uint8_t* d, int dstWidth) {
+    int x = 0;
+
+#ifdef QUFORIA_HAS_NEON
+    // 32 source pixels -> 8 destination pixels
+    for (; x + 8 <= dstWidth; x += 8) {
+        uint16x8_t lo[BPP];
+        uint16x8_t hi[BPP];
+        for (int c = 0; c < BPP; c++) {
+            lo[c] = vdupq_n_u16(0);
+            hi[c] = vdupq_n_u16(0);
+        }
+
+        // Sum horizontal pairs over 4 rows (2x4 blocks)
+        for (int r = 0; r < 4; r++) {
+            const uint8_t* p = s[r] + x * 4 * BPP;
+            if constexpr (BPP == 4) {
+                uint8x16x4_t a = vld4q_u8(p);
+                uint8x16x4_t b = vld4q_u8(p + 64);
+                for (int c = 0; c < 4; c++) {
+                    lo[c] = vpadalq_u8(lo[c], a.val[c]);
+                    hi[c] = vpadalq_u8(hi[c], b.val[c]);
+                }
+            } else {
+                uint8x16x3_t a = vld3q_u8(p);
+                uint8x16x3_t b = vld3q_u8(p + 48);
+                for (int c = 0; c < 3; c++) {
+                    lo[c] = vpadalq_u8(lo[c], a.val[c]);
+                    hi[c] = vpadalq_u8(hi[c], b.val[c]);
+                }
+            }
+        }
+
+        // Fold adjacent 2x4 sums into 4x4 sums and average
+        uint8x8_t out[BPP];
+        for (int c = 0; c < BPP; c++) {
+            uint16x8_t sum = vcombine_u16(vpadd_u16(vget_low_u16(lo[c]), vget_high_u16(lo[c])),
+                                          vpadd_u16(vget_low_u16(hi[c]), vget_high_u16(hi[c])));
+            out[c] = vrshrn_n_u16(sum, 4);
+        }
+
+        if constexpr (BPP == 4) {
+            uint8x8x4_t o = { { out[0], out[1], out[2], out[3] } };
+            vst4_u8(d + x * 4, o);
+        } else {
+            uint8x8x3_t o = { { out[0], out[1], out[2] } };
+            vst3_u8(d + x * 3, o);
+        }
+    }
+#endif
+
+    for (; x < dstWidth; x++) {
+        for (int c = 0; c < BPP; c++) {
+            int sum = 0;
+            for (int r = 0; r < 4; r++) {
+                const uint8_t* p = s[r] + x * 4 * BPP + c;
+                sum += p[0] + p[BPP] + p[2 * BPP] + p[3 * BPP];
+            }
+            d[x * BPP + c] = (uint8_t)((sum + 8) >> 4);
+        }
+    }
+}
+
+template <int BPP>
+static void box2(const uint8_t* src, int srcStride, int srcHeight,
+                 uint8_t* dst, int dstStride, int dstWidth, int dstHeight, bool flip) {
+    for (int y = 0; y < dstHeight; y++) {
+        box2Row<BPP>(srcRow(src, srcStride, 2 * y, srcHeight, flip),
+                     srcRow(src, srcStride, 2 * y + 1, srcHeight, flip),
+                     dst + (size_t)y * dstStride, dstWidth);
+    }
+}
+
+template <int BPP>
+static void box4(const uint8_t* src, int srcStride, int srcHeight,
+                 uint8_t* dst, int dstStride, int dstWidth, int dstHeight, bool flip) {
+    for (int y = 0; y < dstHeight; y++) {
+        const uint8_t* rows[4];
+        for (int r = 0; r < 4; r++) {
+            rows[r] = srcRow(src, srcStride, 4 * y + r, srcHeight, flip);
+        }
+        box4Row<BPP>(rows, dst + (size_t)y * dstStride, dstWidth);
+    }
+}
+
+// =============================================================================
+// Bilinear (arbitrary ratio)
+// =============================================================================
+
+// Blend two source rows byte-wise: out = (top * (1 - w) + bottom * w)
+static void blendRows(const uint8_t* top, const uint8_t* bottom, uint8_t* out,
+                      int count, uint8_t weight) {
+    int i = 0;
+
+#ifdef QUFORIA_HAS_NEON
+    const uint8x8_t wTop = vdup_n_u8((uint8_t)(WEIGHT_ONE - weight));
+    const uint8x8_t wBottom = vdup_n_u8(weight);
+    for (; i + 16 <= count; i += 16) {
+        uint8x16_t t = vld1q_u8(top + i);
+        uint8x16_t b = vld1q_u8(bottom + i);
+        uint16x8_t lo = vmlal_u8(vmull_u8(vget_low_u8(t), wTop), vget_low_u8(b), wBottom);
+        uint16x8_t hi = vmlal_u8(vmull_u8(vget_high_u8(t), wTop), vget_high_u8(b), wBottom);
+        vst1q_u8(out + i, vcombine_u8(vrshrn_n_u16(lo, WEIGHT_BITS),
+                                      vrshrn_n_u16(hi, WEIGHT_BITS)));
+    }
+#endif
+
+    const int wt = WEIGHT_ONE - weight;
+    for (; i < count; i++) {
+        out[i] = (uint8_t)((top[i] * wt + bottom[i] * weight + WEIGHT_ONE / 2) >> WEIGHT_BITS);
+    }
+}
+
+// Map destination coordinate to (index, 7-bit weight) using pixel centers
+static void buildAxisTable(int srcSize, int dstSize, std::vector<int32_t>& index,
+                           std::vector<uint8_t>& weight) {
+    index.resize(dstSize);
+    weight.resize(dstSize);
+
+    const float ratio = (float)srcSize / dstSize;
+    for (int i = 0; i < dstSize; i++) {
+        float pos = (i + 0.5f) * ratio - 0.5f;
+        pos = std::max(0.0f, std::min(pos, (float)(srcSize - 1)));
+        int i0 = (int)pos;
+        int w = (int)std::lround((pos - i0) * WEIGHT_ONE);
+        if (i0 >= srcSize - 1) {
+            i0 = srcSize - 1;
+            w = 0;
+        } else if (w >= WEIGHT_ONE) {
+            i0++;
+            w = 0;
+        }
+        index[i] = i0;
+        weight[i] = (uint8_t)w;
+    }
+}
+
+FrameScaler::FrameScaler()
+    : srcWidth_(0)
+    , srcHeight_(0)
+    , dstWidth_(0)
+    , dstHeight_(0)
+    , bpp_(0)
+{
+}
+
+void FrameScaler::configureBilinear(int srcWidth, int srcHeight, int dstWidth, int dstHeight, int bpp) {
+    if (srcWidth == srcWidth_ && srcHeight == srcHeight_ &&
+        dstWidth == dstWidth_ && dstHeight == dstHeight_ && bpp == bpp_) {
+        return;
+    }
+
+    buildAxisTable(srcWidth, dstWidth, xOffset_, xWeight_);
+    buildAxisTable(srcHeight, dstHeight, yIndex_, yWeight_);
+
+    // Store byte offsets for the horizontal gather
+    for (int& offset : xOffset_) {
+        offset *= bpp;
+    }
+
+    rowBuffer_.resize((size_t)srcWidth * bpp);
+
+    srcWidth_ = srcWidth;
+    srcHeight_ = srcHeight;
+    dstWidth_ = dstWidth;
+    dstHeight_ = dstHeight;
+    bpp_ = bpp;
+}
+
+template <int BPP>
+static void bilinear(const uint8_t* src, int srcStride, int srcWidth, int srcHeight,
+                     uint8_t* dst, int dstStride, int dstWidth, int dstHeight, bool flip,
+                     const int32_t* xOffset, const uint8_t* xWeight,
+                     const int32_t* yIndex, const uint8_t* yWeight, uint8_t* rowBuffer) {
+    const int lastOffset = (srcWidth - 1) * BPP;
+
+    for (int y = 0; y < dstHeight; y++) {
+        const int y0 = yIndex[y];
+        const uint8_t* top = srcRow(src, srcStride, y0, srcHeight, flip);
+        const uint8_t* row = top;
+
+        // Vertical pass (vectorized) unless the row lands exactly on a source row
+        if (yWeight[y] != 0) {
+            const uint8_t* bottom = srcRow(src, srcStride, y0 + 1, srcHeight, flip);
+            blendRows(top, bottom, rowBuffer, srcWidth * BPP, yWeight[y]);
+            row = rowBuffer;
+        }
+
+        // Horizontal pass (table-driven gather)
+        uint8_t* d = dst + (size_t)y * dstStride;
+        for (int x = 0; x < dstWidth; x++) {
+            const int o0 = xOffset[x];
+            const int o1 = std::min(o0 + BPP, lastOffset);
+            const int w1 = xWeight[x];
+            const int w0 = WEIGHT_ONE - w1;
+            for (int c = 0; c < BPP; c++) {
+                d[x * BPP + c] = (uint8_t)((row[o0 + c] * w0 + row[o1 + c] * w1 +
+                                            WEIGHT_ONE / 2) >> WEIGHT_BITS);
+            }
+        }
+    }
+}
+
+// =============================================================================
+// Dispatch
+// =============================================================================
+
+void FrameScaler::scale(const uint8_t* src, int srcStride, int srcWidth, int srcHeight,
+                        uint8_t* dst, int dstStride, int dstWidth, int dstHeight,
+                        int bpp, bool flipVertically) {
+    const bool is4 = (bpp == 4);
+
+    if (srcWidth == dstWidth * 2 && srcHeight == dstHeight * 2) {
+        if (is4) {
+            box2<4>(src, srcStride, srcHeight, dst, dstStride, dstWidth, dstHeight, flipVertically);
+        } else {
+            box2<3>(src, srcStride, srcHeight, dst, dstStride, dstWidth, dstHeight, flipVertically);
+        }
+        return;
+    }
+
+    if (srcWidth == dstWidth * 4 && srcHeight == dstHeight * 4) {
+        if (is4) {
+            box4<4>(src, srcStride, srcHeight, dst, dstStride, dstWidth, dstHeight, flipVertically);
+        } else {
+            box4<3>(src, srcStride, srcHeight, dst, dstStride, dstWidth, dstHeight, flipVertically);
+        }
+        return;
+    }
+
+    configureBilinear(srcWidth, srcHeight, dstWidth, dstHeight, bpp);
+    if (is4) {
+        bilinear<4>(src, srcStride, srcWidth, srcHeight, dst, dstStride, dstWidth, dstHeight,
+                    flipVertically, xOffset_.data(), xWeight_.data(),
+                    yIndex_.data(), yWeight_.data(), rowBuffer_.data());
+    } else {
+        bilinear<3>(src, srcStride, srcWidth, srcHeight, dst, dstStride, dstWidth, dstHeight,
+                    flipVertically, xOffset_.data(), xWeight_.data(),
+                    yIndex_.data(), yWeight_.data(), rowBuffer_.data());
+    }
+}
+
+// =============================================================================
+// Intrinsics
+// =============================================================================
+
+VuforiaDriver::CameraIntrinsics scaleIntrinsics(const VuforiaDriver::CameraIntrinsics& intrinsics,
+                                                int fromWidth, int fromHeight,
+                                                int toWidth, int toHeight) {
+    VuforiaDriver::CameraIntrinsics scaled = intrinsics;
+    if (fromWidth <= 0 || fromHeight <= 0 ||
+        (fromWidth == toWidth && fromHeight == toHeight)) {
+        return scaled;
+    }
+
+    const float sx = (float)toWidth / fromWidth;
+    const float sy = (float)toHeight / fromHeight;
+
+    // Principal point is scaled about pixel centers, so (cx + 0.5) maps exactly
+    scaled.focalLengthX = intrinsics.focalLengthX * sx;
+    scaled.focalLengthY = intrinsics.focalLengthY * sy;
+    scaled.principalPointX = (intrinsics.principalPointX + 0.5f) * sx - 0.5f;
+    scaled.principalPointY = (intrinsics.principalPointY + 0.5f) * sy - 0.5f;
+
+    // Distortion coefficients are in normalized coordinates (scale-invariant)
+    return scaled;
+}
@@ -0,0 +1,53 @@
+#ifndef QUEST_FRAME_SCALER_H
+#define QUEST_FRAME_SCALER_H
+
+#include <VuforiaEngine/Driver/Driver.h>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Downscaler for packed RGB888/RGBA8888 frames.
+ *
+ * Exact 2x and 4x reductions use a box filter; any other ratio (e.g. 3/4)
+ * falls back to fixed-point bilinear with precomputed column tables.
+ * Tables and the row scratch buffer are rebuilt only when the geometry
+ * changes, so per-frame cost is just the filter pass.
+ *
+ * Not thread-safe: one instance per ingestion thread.
+ */
+class FrameScaler {
+public:
+    FrameScaler();
+
+    // Scale src (srcWidth x srcHeight) into dst (dstWidth x dstHeight).
+    // bpp is 3 or 4. flipVertically reads source rows bottom-up.
+    void scale(const uint8_t* src, int srcStride, int srcWidth, int srcHeight,
+               uint8_t* dst, int dstStride, int dstWidth, int dstHeight,
+               int bpp, bool flipVertically);
+
+private:
+    void configureBilinear(int srcWidth, int srcHeight, int dstWidth, int dstHeight, int bpp);
+
+    // Cached geometry for the bilinear tables
+    int srcWidth_;
+    int srcHeight_;
+    int dstWidth_;
+    int dstHeight_;
+    int bpp_;
+
+    // Per destination column: left source byte offset and 7-bit right weight
+    std::vector<int32_t> xOffset_;
+    std::vector<uint8_t> xWeight_;
+    // Per destination row: top source row and 7-bit bottom weight
+    std::vector<int32_t> yIndex_;
+    std::vector<uint8_t> yWeight_;
+    // Vertically blended source row
+    std::vector<uint8_t> rowBuffer_;
+};
+
+// Rescale intrinsics calibrated at (fromWidth x fromHeight) to (toWidth x toHeight)
+VuforiaDriver::CameraIntrinsics scaleIntrinsics(const VuforiaDriver::CameraIntrinsics& intrinsics,
+                                                int fromWidth, int fromHeight,
+                                                int toWidth, int toHeight);
+
+#endif // QUEST_FRAME_SCALER_H
@@ -0,0 +1,456 @@
+#include "luma_normalizer.h"
+#include "frame_converter.h"
+#include "quforia_log.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define QUFORIA_HAS_NEON 1
+#endif
+
+#define LOG_TAG "QUFORIA"
+
+// =============================================================================
+// Histogram
+// =============================================================================
+
+// Approximate luma (R + 2G + B) / 4 for one packed row
+static void lumaRowApprox(const uint8_t* row, int bpp, int width, uint8_t* out) {
+    int x = 0;
+
+#ifdef QUFORIA_HAS_NEON
+    for (; x + 16 <= width; x += 16) {
+        uint8x16_t r, g, b;
+        if (bpp == 4) {
+            uint8x16x4_t p = vld4q_u8(row + x * 4);
+            r = p.val[0]; g = p.val[1]; b = p.val[2];
+        } else {
+            uint8x16x3_t p = vld3q_u8(row + x * 3);
+            r = p.val[0]; g = p.val[1]; b = p.val[2];
+        }
+        vst1q_u8(out + x, vhaddq_u8(vhaddq_u8(r, b), g));
+    }
+#endif
+
+    for (; x < width; x++) {
+        const uint8_t* p = row + x * bpp;
+        out[x] = (uint8_t)((((p[0] + p[2]) >> 1) + p[1]) >> 1);
+    }
+}
+
+void computeLumaHistogram(const uint8_t* buffer, VuforiaDriver::PixelFormat format,
+                          int width, int height, int stride, int step, uint32_t histogram[256]) {
+    // Four interleaved sub-histograms avoid back-to-back increments of the same bin
+    uint32_t sub[4][256];
+    memset(sub, 0, sizeof(sub));
+
+    const bool planar = isYUV420Format(format);
+    const int bpp = bytesPerPixel(format);
+
+    // Packed rows: luma of the sampled pixels only, a chunk at a time
+    static const int CHUNK = 256;
+    uint8_t samples[CHUNK];
+
+    for (int y = 0; y < height; y += step) {
+        const uint8_t* row = buffer + (size_t)y * stride;
+        const int rowSamples = (width + step - 1) / step;
+
+        for (int s0 = 0; s0 < rowSamples; s0 += CHUNK) {
+            const int n = std::min(CHUNK, rowSamples - s0);
+            const uint8_t* luma;
+            int lumaStep;
+            if (planar) {
+                luma = row + (size_t)s0 * step;
+                lumaStep = step;
+            } else {
+                const uint8_t* pixels = row + (size_t)s0 * step * bpp;
+                if (step == 1) {
+                    lumaRowApprox(pixels, bpp, n, samples);
+                } else {
+                    for (int i = 0; i < n; i++) {
+                        const uint8_t* p = pixels + (size_t)i * step * bpp;
+                        samples[i] = (uint8_t)((((p[0] + p[2]) >> 1) + p[1]) >> 1);
+                    }
+                }
+                luma = samples;
+                lumaStep = 1;
+            }
+
+            int i = 0;
+            for (; i + 4 <= n; i += 4) {
+                sub[0][luma[i * lumaStep]]++;
+                sub[1][luma[(i + 1) * lumaStep]]++;
+                sub[2][luma[(i + 2) * lumaStep]]++;
+                sub[3][luma[(i + 3) * lumaStep]]++;
+            }
+            for (; i < n; i++) {
+                sub[0][luma[i * lumaStep]]++;
+            }
+        }
+    }
+
+    for (int i = 0; i < 256; i++) {
+        histogram[i] = sub[0][i] + sub[1][i] + sub[2][i] + sub[3][i];
+    }
+}
+
+// =============================================================================
+// LUT Application
+// =============================================================================
+
+#if defined(QUFORIA_HAS_NEON) && defined(__aarch64__)
+// 256-entry lookup as four 64-byte table lookups (out-of-range lanes keep
+// the previous result)
+static inline uint8x16_t lookup256(const uint8x16x4_t table[4], uint8x16_t idx) {
+    const uint8x16_t k64 = vdupq_n_u8(64);
+    uint8x16_t r = vqtbl4q_u8(table[0], idx);
+    idx = vsubq_u8(idx, k64);
+    r = vqtbx4q_u8(r, table[1], idx);
+    idx = vsubq_u8(idx, k64);
+    r = vqtbx4q_u8(r, table[2], idx);
+    idx = vsubq_u8(idx, k64);
+    return vqtbx4q_u8(r, table[3], idx);
+}
+#endif
+
+static void applyLut(uint8_t* data, int count, const uint8_t lut[256]) {
+    int i = 0;
+
+#if defined(QUFORIA_HAS_NEON) && defined(__aarch64__)
+    const uint8x16x4_t table[4] = {
+        vld1q_u8_x4(lut), vld1q_u8_x4(lut + 64), vld1q_u8_x4(lut + 128), vld1q_u8_x4(lut + 192)
+    };
+    for (; i + 16 <= count; i += 16) {
+        vst1q_u8(data + i, lookup256(table, vld1q_u8(data + i)));
+    }
+#endif
+
+    for (; i < count; i++) {
+        data[i] = lut[data[i]];
+    }
+}
+
+// RGBA row: color channels only, alpha is left untouched
+static void applyLutRgba(uint8_t* data, int width, const uint8_t lut[256]) {
+    int x = 0;
+
+#if defined(QUFORIA_HAS_NEON) && defined(__aarch64__)
+    const uint8x16x4_t table[4] = {
+        vld1q_u8_x4(lut), vld1q_u8_x4(lut + 64), vld1q_u8_x4(lut + 128), vld1q_u8_x4(lut + 192)
+    };
+    for (; x + 16 <= width; x += 16) {
+        uint8x16x4_t p = vld4q_u8(data + x * 4);
+        p.val[0] = lookup256(table, p.val[0]);
+        p.val[1] = lookup256(table, p.val[1]);
+        p.val[2] = lookup256(table, p.val[2]);
+        vst4q_u8(data + x * 4, p);
+    }
+#endif
+
+    for (; x < width; x++) {
+        uint8_t* p = data + x * 4;
+        p[0] = lut[p[0]];
+        p[1] = lut[p[1]];
+        p[2] = lut[p[2]];
+    }
+}
+
+// CLAHE tile blending: 7-bit weights, so a blended pair fits in 16 bits
+static const int BLEND_BITS = 7;
+static const int BLEND_ONE = 1 << BLEND_BITS;
+
+// out = a * (1 - w) + b * w for a whole 256-entry LUT (w in 1/BLEND_ONE)
+static void blendLuts(const uint8_t* a, const uint8_t* b, int w, uint8_t* out) {
+    int i = 0;
+
+#ifdef QUFORIA_HAS_NEON
+    const uint8x8_t wb = vdup_n_u8((uint8_t)w);
+    const uint8x8_t wa = vdup_n_u8((uint8_t)(BLEND_ONE - w));
+    for (; i + 16 <= 256; i += 16) {
+        const uint8x16_t va = vld1q_u8(a + i);
+        const uint8x16_t vb = vld1q_u8(b + i);
+        const uint16x8_t lo = vmlal_u8(vmull_u8(vget_low_u8(va), wa), vget_low_u8(vb), wb);
+        const uint16x8_t hi = vmlal_u8(vmull_u8(vget_high_u8(va), wa), vget_high_u8(vb), wb);
+        vst1q_u8(out + i, vcombine_u8(vrshrn_n_u16(lo, BLEND_BITS), vrshrn_n_u16(hi, BLEND_BITS)));
+    }
+#endif
+
+    for (; i < 256; i++) {
+        out[i] = (uint8_t)((a[i] * (BLEND_ONE - w) + b[i] * w + BLEND_ONE / 2) >> BLEND_BITS);
+    }
+}
+
+// Remap count bytes through two LUTs blended per byte by weight (the right
+// LUT's share). RGBA spans start on a pixel and keep their alpha. scratch
+// holds count bytes: one table is live per pass.
+static void blendLutSpan(uint8_t* data, int count, int bpp, const uint8_t* left,
+                         const uint8_t* right, const uint8_t* weight, uint8_t* scratch) {
+    int i = 0;
+
+#if defined(QUFORIA_HAS_NEON) && defined(__aarch64__)
+    const int vectorEnd = count & ~15;
+    {
+        const uint8x16x4_t table[4] = {
+            vld1q_u8_x4(left), vld1q_u8_x4(left + 64), vld1q_u8_x4(left + 128), vld1q_u8_x4(left + 192)
+        };
+        for (; i < vectorEnd; i += 16) {
+            vst1q_u8(scratch + i, lookup256(table, vld1q_u8(data + i)));
+        }
+    }
+    {
+        static const uint8_t ALPHA_MASK[16] = { 0, 0, 0, 0xFF, 0, 0, 0, 0xFF,
+                                                0, 0, 0, 0xFF, 0, 0, 0, 0xFF };
+        const uint8x16_t keep = bpp == 4 ? vld1q_u8(ALPHA_MASK) : vdupq_n_u8(0);
+        const uint8x16_t one = vdupq_n_u8((uint8_t)BLEND_ONE);
+        const uint8x16x4_t table[4] = {
+            vld1q_u8_x4(right), vld1q_u8_x4(right + 64), vld1q_u8_x4(right + 128), vld1q_u8_x4(right + 192)
+        };
+        for (i = 0; i < vectorEnd; i += 16) {
+            const uint8x16_t v = vld1q_u8(data + i);
+            const uint8x16_t l = vld1q_u8(scratch + i);
+            const uint8x16_t r = lookup256(table, v);
+            const uint8x16_t wr = vld1q_u8(weight + i);
+            const uint8x16_t wl = vsubq_u8(one, wr);
+            const uint16x8_t lo = vmlal_u8(vmull_u8(vget_low_u8(l), vget_low_u8(wl)),
+                                           vget_low_u8(r), vget_low_u8(wr));
+            const uint16x8_t hi = vmlal_u8(vmull_u8(vget_high_u8(l), vget_high_u8(wl)),
+                                           vget_high_u8(r), vget_high_u8(wr));
+            const uint8x16_t blended = vcombine_u8(vrshrn_n_u16(lo, BLEND_BITS),
+                                                   vrshrn_n_u16(hi, BLEND_BITS));
+            vst1q_u8(data + i, vbslq_u8(keep, v, blended));
+        }
+    }
+#else
+    (void)scratch;
+#endif
+
+    // i is a multiple of 16 here, so RGBA pixels stay aligned
+    const int step = bpp == 4 ? 4 : 1;
+    const int channels = bpp == 4 ? 3 : 1;
+    for (; i < count; i += step) {
+        for (int c = 0; c < channels; c++) {
+            const uint8_t v = data[i + c];
+            const int w = weight[i + c];
+            data[i + c] = (uint8_t)((left[v] * (BLEND_ONE - w) + right[v] * w +
+                                     BLEND_ONE / 2) >> BLEND_BITS);
+        }
+    }
+}
+
+// =============================================================================
+// LumaNormalizer
+// =============================================================================
+
+LumaNormalizer::LumaNormalizer()
+    : mode_(NormalizationMode::OFF)
+    , darkThreshold_(80)
+    , maxGain_(3.0f)
+    , claheWidth_(0)
+    , claheBpp_(0)
+{
+    for (int i = 0; i < 256; i++) {
+        lut_[i] = (uint8_t)i;
+    }
+}
+
+void LumaNormalizer::setConfig(NormalizationMode mode, int darkThreshold, float maxGain) {
+    std::lock_guard<std::mutex> lock(configMutex_);
+
+    mode_ = mode;
+    darkThreshold_ = std::max(0, std::min(darkThreshold, 256));
+    if (maxGain >= 1.0f) {
+        maxGain_ = maxGain;
+    }
+
+    LOGI("Luma normalization: mode=%d, dark threshold=%d, max gain=%.2f",
+         (int)mode_, darkThreshold_, maxGain_);
+}
+
+NormalizationMode LumaNormalizer::mode() {
+    std::lock_guard<std::mutex> lock(configMutex_);
+    return mode_;
+}
+
+void LumaNormalizer::buildStretchLut(const uint32_t histogram[256], uint32_t total, float maxGain) {
+    // 1st / 99th percentile as black / white points
+    const uint32_t loCount = total / 100;
+    const uint32_t hiCount = total - total / 100;
+    int lo = 0;
+    int hi = 255;
+    uint32_t cumulative = 0;
+    for (int i = 0; i < 256; i++) {
+        cumulative += histogram[i];
+        if (cumulative <= loCount) {
+            lo = i;
+        }
+        if (cumulative >= hiCount) {
+            hi = i;
+            break;
+        }
+    }
+
+    // Brighten only: with the gain capped the stretch line can fall below
+    // the identity (e.g. 255 -> (255 - lo) * gain), so keep the larger of the two
+    const float gain = std::min(maxGain, 255.0f / std::max(1, hi - lo));
+    for (int i = 0; i < 256; i++) {
+        int v = (int)((i - lo) * gain + 0.5f);
+        lut_[i] = (uint8_t)std::max(i, std::min(v, 255));
+    }
+}
+
+void LumaNormalizer::configureClahe(int width, int bpp) {
+    if (width == claheWidth_ && bpp == claheBpp_) {
+        return;
+    }
+    claheWidth_ = width;
+    claheBpp_ = bpp;
+
+    // Per column: left tile of the blend pair and the right tile's weight,
+    // expanded to every byte of the pixel
+    const int tileWidth = (width + CLAHE_TILES_X - 1) / CLAHE_TILES_X;
+    colTile_.resize(width);
+    byteWeight_.resize((size_t)width * bpp);
+    for (int x = 0; x < width; x++) {
+        float fx = (x + 0.5f) / tileWidth - 0.5f;
+        fx = std::max(0.0f, std::min(fx, (float)(CLAHE_TILES_X - 1)));
+        colTile_[x] = std::min((int)fx, CLAHE_TILES_X - 2);
+        const uint8_t weight = (uint8_t)((fx - colTile_[x]) * BLEND_ONE + 0.5f);
+        memset(&byteWeight_[(size_t)x * bpp], weight, bpp);
+    }
+    blendScratch_.resize((size_t)width * bpp);
+    rowLuts_.resize(CLAHE_TILES_X * 256);
+    tileLuts_.resize(CLAHE_TILES_X * CLAHE_TILES_Y * 256);
+}
+
+void LumaNormalizer::applyClahe(uint8_t* buffer, VuforiaDriver::PixelFormat format,
+                                int width, int height, int stride, float maxGain) {
+    const bool planar = isYUV420Format(format);
+    const int bpp = planar ? 1 : bytesPerPixel(format);
+    const int tileWidth = (width + CLAHE_TILES_X - 1) / CLAHE_TILES_X;
+    const int tileHeight = (height + CLAHE_TILES_Y - 1) / CLAHE_TILES_Y;
+
+    configureClahe(width, bpp);
+
+    // Per-tile clipped histogram -> CDF -> LUT. maxGain is the clip limit
+    // relative to a flat histogram, which bounds the local contrast gain.
+    for (int ty = 0; ty < CLAHE_TILES_Y; ty++) {
+        for (int tx = 0; tx < CLAHE_TILES_X; tx++) {
+            const int x0 = tx * tileWidth;
+            const int y0 = ty * tileHeight;
+            const int w = std::min(tileWidth, width - x0);
+            const int h = std::min(tileHeight, height - y0);
+            uint8_t* tileLut = &tileLuts_[(ty * CLAHE_TILES_X + tx) * 256];
+
+            uint32_t histogram[256];
+            computeLumaHistogram(buffer + (size_t)y0 * stride + (size_t)x0 * bpp,
+                                 format, w, h, stride, 2, histogram);
+
+            uint32_t total = 0;
+            for (int i = 0; i < 256; i++) {
+                total += histogram[i];
+            }
+            if (total == 0) {
+                for (int i = 0; i < 256; i++) {
+                    tileLut[i] = (uint8_t)i;
+                }
+                continue;
+            }
+
+            const uint32_t clip = std::max<uint32_t>(1, (uint32_t)(maxGain * total / 256));
+            uint32_t excess = 0;
+            for (int i = 0; i < 256; i++) {
+                if (histogram[i] > clip) {
+                    excess += histogram[i] - clip;
+                    histogram[i] = clip;
+                }
+            }
+            const uint32_t bonus = excess / 256;
+
+            uint32_t cumulative = 0;
+            for (int i = 0; i < 256; i++) {
+                cumulative += histogram[i] + bonus;
+                tileLut[i] = (uint8_t)std::min<uint32_t>(255, cumulative * 255 / total);
+            }
+        }
+    }
+
+    // Bilinear blend of the four nearest tile LUTs: vertically once per row
+    // (one LUT per tile column), then horizontally per byte across each run
+    // of columns sharing a tile pair
+    for (int y = 0; y < height; y++) {
+        float fy = (y + 0.5f) / tileHeight - 0.5f;
+        fy = std::max(0.0f, std::min(fy, (float)(CLAHE_TILES_Y - 1)));
+        const int ty = std::min((int)fy, CLAHE_TILES_Y - 2);
+        const int wy = (int)((fy - ty) * BLEND_ONE + 0.5f);
+        for (int tx = 0; tx < CLAHE_TILES_X; tx++) {
+            blendLuts(&tileLuts_[(ty * CLAHE_TILES_X + tx) * 256],
+                      &tileLuts_[((ty + 1) * CLAHE_TILES_X + tx) * 256],
+                      wy, &rowLuts_[tx * 256]);
+        }
+
+        uint8_t* row = buffer + (size_t)y * stride;
+        for (int x = 0; x < width;) {
+            const int tx = colTile_[x];
+            int end = x + 1;
+            while (end < width && colTile_[end] == tx) {
+                end++;
+            }
+            blendLutSpan(row + (size_t)x * bpp, (end - x) * bpp, bpp,
+                         &rowLuts_[tx * 256], &rowLuts_[(tx + 1) * 256],
+                         &byteWeight_[(size_t)x * bpp], blendScratch_.data());
+            x = end;
+        }
+    }
+}
+
+bool LumaNormalizer::process(uint8_t* buffer, VuforiaDriver::PixelFormat format,
+                             int width, int height, int stride) {
+    NormalizationMode mode;
+    int darkThreshold;
+    float maxGain;
+    {
+        std::lock_guard<std::mutex> lock(configMutex_);
+        mode = mode_;
+        darkThreshold = darkThreshold_;
+        maxGain = maxGain_;
+    }
+
+    if (mode == NormalizationMode::OFF) {
+        return false;
+    }
+
+    // Sampled histogram (every 4th pixel of every 4th row) to decide and fit
+    uint32_t histogram[256];
+    computeLumaHistogram(buffer, format, width, height, stride, 4, histogram);
+
+    uint64_t total = 0;
+    uint64_t sum = 0;
+    for (int i = 0; i < 256; i++) {
+        total += histogram[i];
+        sum += (uint64_t)histogram[i] * i;
+    }
+    if (total == 0 || (int)(sum / total) >= darkThreshold) {
+        return false;
+    }
+
+    if (mode == NormalizationMode::CLAHE) {
+        applyClahe(buffer, format, width, height, stride, maxGain);
+        return true;
+    }
+
+    buildStretchLut(histogram, (uint32_t)total, maxGain);
+
+    // Y plane only for YUV; color channels only for packed RGB (never alpha)
+    const int bpp = bytesPerPixel(format);
+    const int rowBytes = isYUV420Format(format) ? width : width * bpp;
+    for (int y = 0; y < height; y++) {
+        uint8_t* row = buffer + (size_t)y * stride;
+        if (!isYUV420Format(format) && bpp == 4) {
+            applyLutRgba(row, width, lut_);
+        } else {
+            applyLut(row, rowBytes, lut_);
+        }
+    }
+    return true;
+}
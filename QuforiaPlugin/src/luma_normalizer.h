@@ -0,0 +1,71 @@
+#ifndef QUEST_LUMA_NORMALIZER_H
+#define QUEST_LUMA_NORMALIZER_H
+
+#include <VuforiaEngine/Driver/Driver.h>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/**
+ * Low-light luminance normalization applied to delivered frames.
+ */
+enum class NormalizationMode : int32_t {
+    OFF = 0,      ///< Frames are delivered as captured
+    STRETCH = 1,  ///< Global contrast stretch (1st-99th percentile -> full range)
+    CLAHE = 2     ///< Tile-based contrast-limited adaptive histogram equalization
+};
+
+// Luma histogram of a delivered frame, sampled every `step` pixels/rows.
+// YUV formats read the Y plane; RGB formats use (R + 2G + B) / 4.
+void computeLumaHistogram(const uint8_t* buffer, VuforiaDriver::PixelFormat format,
+                          int width, int height, int stride, int step, uint32_t histogram[256]);
+
+/**
+ * Brightens dim frames before delivery to speed up target acquisition.
+ *
+ * Only frames whose mean luma is below the dark threshold are touched. The
+ * remap is applied in place to the Y plane (YUV formats) or to the colour
+ * channels (RGB formats) via a 256-entry LUT (NEON table lookup on arm64).
+ * STRETCH costs one sampled histogram and one LUT pass; CLAHE additionally
+ * builds a LUT per tile and blends the four nearest tiles per pixel.
+ *
+ * Not thread-safe for process(); configuration may be changed from any thread.
+ */
+class LumaNormalizer {
+public:
+    LumaNormalizer();
+
+    void setConfig(NormalizationMode mode, int darkThreshold, float maxGain);
+    NormalizationMode mode();
+
+    // Normalize in place. Returns true if the frame was modified.
+    bool process(uint8_t* buffer, VuforiaDriver::PixelFormat format,
+                 int width, int height, int stride);
+
+private:
+    void buildStretchLut(const uint32_t histogram[256], uint32_t total, float maxGain);
+    void applyClahe(uint8_t* buffer, VuforiaDriver::PixelFormat format,
+                    int width, int height, int stride, float maxGain);
+    void configureClahe(int width, int bpp);
+
+    static const int CLAHE_TILES_X = 8;
+    static const int CLAHE_TILES_Y = 8;
+
+    std::mutex configMutex_;
+    NormalizationMode mode_;
+    int darkThreshold_;
+    float maxGain_;
+
+    uint8_t lut_[256];
+    std::vector<uint8_t> tileLuts_;  // CLAHE_TILES_X * CLAHE_TILES_Y * 256
+
+    // CLAHE blend tables and scratch, rebuilt only when the width or format changes
+    int claheWidth_;
+    int claheBpp_;
+    std::vector<int32_t> colTile_;       // Per column: left tile of the blend pair
+    std::vector<uint8_t> byteWeight_;    // Per byte: 7-bit weight of the right tile
+    std::vector<uint8_t> rowLuts_;       // CLAHE_TILES_X * 256, blended for the current row
+    std::vector<uint8_t> blendScratch_;  // One row of left-tile lookups
+};
+
+#endif // QUEST_LUMA_NORMALIZER_H
@@ -0,0 +1,117 @@
+#include "pipeline_stats.h"
+#include <algorithm>
+#include <cmath>
+
+// =============================================================================
+// LatencyHistogram
+// =============================================================================
+
+LatencyHistogram::LatencyHistogram() {
+    reset();
+}
+
+int LatencyHistogram::bucketFor(uint64_t micros) {
+    if (micros < 8) {
+        return (int)micros;
+    }
+    const int msb = 63 - __builtin_clzll(micros);
+    const int bucket = (msb - 2) * 8 + (int)((micros >> (msb - 3)) & 7);
+    return std::min(bucket, BUCKETS - 1);
+}
+
+uint64_t LatencyHistogram::bucketLowerBound(int bucket) {
+    if (bucket < 8) {
+        return (uint64_t)bucket;
+    }
+    const int msb = bucket / 8 + 2;
+    return (uint64_t)(8 + bucket % 8) << (msb - 3);
+}
+
+void LatencyHistogram::record(int64_t durationNs) {
+    const uint64_t micros = durationNs > 0 ? (uint64_t)durationNs / 1000 : 0;
+    counts_[bucketFor(micros)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void LatencyHistogram::percentiles(const double* quantiles, int count, int64_t* out,
+                                   int64_t* samples) const {
+    uint32_t counts[BUCKETS];
+    uint64_t total = 0;
+    for (int i = 0; i < BUCKETS; i++) {
+        counts[i] = counts_[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+    if (samples) *samples = (int64_t)total;
+
+    for (int q = 0; q < count; q++) {
+        out[q] = 0;
+        if (total == 0) {
+            continue;
+        }
+        // Smallest bucket holding at least quantile * total samples
+        const uint64_t rank = std::max<uint64_t>(1, (uint64_t)std::ceil(quantiles[q] * (double)total));
+        uint64_t seen = 0;
+        for (int i = 0; i < BUCKETS; i++) {
+            seen += counts[i];
+            if (seen >= rank) {
+                const uint64_t lower = bucketLowerBound(i);
+                const uint64_t upper = i + 1 < BUCKETS ? bucketLowerBound(i + 1) : lower + lower / 8;
+                out[q] = (int64_t)((lower + upper) * 1000 / 2);
+                break;
+            }
+        }
+    }
+}
+
+void LatencyHistogram::reset() {
+    for (int i = 0; i < BUCKETS; i++) {
+        counts_[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+// =============================================================================
+// PipelineStats
+// =============================================================================
+
+PipelineStats::PipelineStats()
+    : framesFed_(0)
+    , framesDelivered_(0)
+    , posesFed_(0)
+    , posesDelivered_(0)
+    , startNs_(monotonicNowNs())
+{
+}
+
+void PipelineStats::record(PipelineStage stage, int64_t durationNs) {
+    const int index = (int)stage;
+    if (index < 0 || index >= (int)PipelineStage::COUNT) {
+        return;
+    }
+    stages_[index].record(durationNs);
+}
+
+void PipelineStats::snapshot(int64_t* values) const {
+    static const double QUANTILES[3] = {0.50, 0.95, 0.99};
+
+    for (int stage = 0; stage < (int)PipelineStage::COUNT; stage++) {
+        int64_t* out = values + stage * VALUES_PER_STAGE;
+        stages_[stage].percentiles(QUANTILES, 3, out + 1, out);
+    }
+
+    int64_t* counters = values + (int)PipelineStage::COUNT * VALUES_PER_STAGE;
+    counters[0] = framesFed_.load(std::memory_order_relaxed);
+    counters[1] = framesDelivered_.load(std::memory_order_relaxed);
+    counters[2] = posesFed_.load(std::memory_order_relaxed);
+    counters[3] = posesDelivered_.load(std::memory_order_relaxed);
+    counters[4] = monotonicNowNs() - startNs_.load(std::memory_order_relaxed);
+}
+
+void PipelineStats::reset() {
+    for (int stage = 0; stage < (int)PipelineStage::COUNT; stage++) {
+        stages_[stage].reset();
+    }
+    framesFed_ = 0;
+    framesDelivered_ = 0;
+    posesFed_ = 0;
+    posesDelivered_ = 0;
+    startNs_ = monotonicNowNs();
+}
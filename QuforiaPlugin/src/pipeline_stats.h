@@ -0,0 +1,92 @@
+#ifndef QUEST_PIPELINE_STATS_H
+#define QUEST_PIPELINE_STATS_H
+
+#include "clock_domain.h"
+#include <atomic>
+#include <cstdint>
+
+/**
+ * Fixed-bucket latency histogram.
+ *
+ * Buckets are log-linear over microseconds: 8 buckets per power of two, so
+ * every bucket spans at most 12.5% of its value, from 1us up to about a minute
+ * (longer samples land in the last bucket). Recording is one relaxed atomic
+ * add, so any thread may record without locking; percentiles are read from
+ * a snapshot of the counts and report the bucket midpoint.
+ */
+class LatencyHistogram {
+public:
+    static const int BUCKETS = 192;
+
+    LatencyHistogram();
+
+    void record(int64_t durationNs);
+    // Durations at the given quantiles (0-1), 0 when empty
+    void percentiles(const double* quantiles, int count, int64_t* out, int64_t* samples) const;
+    void reset();
+
+private:
+    static int bucketFor(uint64_t micros);
+    static uint64_t bucketLowerBound(int bucket);
+
+    std::atomic<uint32_t> counts_[BUCKETS];
+};
+
+/**
+ * Stages timed for every frame, from capture to Vuforia.
+ */
+enum class PipelineStage : int32_t {
+    UNITY_SUBMIT = 0,      ///< Capture (frame timestamp) -> feedCameraFrame entry
+    CONVERT = 1,           ///< Ingest: crop, scale, format conversion, quality metrics
+    QUEUE_WAIT = 2,        ///< Queued -> picked by the delivery thread
+    POSE_LOOKUP = 3,       ///< Pose history lookup / prediction
+    VUFORIA_CALLBACK = 4,  ///< onNewCameraFrame duration
+    TOTAL = 5,             ///< Capture -> onNewCameraFrame returned
+    COUNT = 6
+};
+
+/**
+ * Per-stage latency histograms and throughput counters for the frame and
+ * pose pipeline. Lock-free and cheap enough to stay enabled in production.
+ */
+class PipelineStats {
+public:
+    // Per stage: [samples, p50, p95, p99] (ns), then the counters:
+    // [frames fed, frames delivered, poses fed, poses delivered, elapsed ns]
+    static const int VALUES_PER_STAGE = 4;
+    static const int VALUE_COUNT = (int)PipelineStage::COUNT * VALUES_PER_STAGE + 5;
+
+    PipelineStats();
+
+    void record(PipelineStage stage, int64_t durationNs);
+    void countFrameFed() { framesFed_.fetch_add(1, std::memory_order_relaxed); }
+    void countFrameDelivered() { framesDelivered_.fetch_add(1, std::memory_order_relaxed); }
+    void countPoseFed() { posesFed_.fetch_add(1, std::memory_order_relaxed); }
+    void countPoseDelivered() { posesDelivered_.fetch_add(1, std::memory_order_relaxed); }
+
+    void snapshot(int64_t* values) const;
+    void reset();
+
+private:
+    LatencyHistogram stages_[(int)PipelineStage::COUNT];
+    std::atomic<int64_t> framesFed_;
+    std::atomic<int64_t> framesDelivered_;
+    std::atomic<int64_t> posesFed_;
+    std::atomic<int64_t> posesDelivered_;
+    std::atomic<int64_t> startNs_;
+};
+
+// Records the duration of the enclosing scope into a stage
+class StageTimer {
+public:
+    StageTimer(PipelineStats& stats, PipelineStage stage)
+        : stats_(stats), stage_(stage), startNs_(monotonicNowNs()) {}
+    ~StageTimer() { stats_.record(stage_, monotonicNowNs() - startNs_); }
+
+private:
+    PipelineStats& stats_;
+    PipelineStage stage_;
+    int64_t startNs_;
+};
+
+#endif // QUEST_PIPELINE_STATS_H
@@ -0,0 +1,287 @@
+#include "pose_ring.h"
+#include "coordinate_transform.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+void interpolatePose(const PoseData& a, const PoseData& b, float t, PoseData* out) {
+    out->timestamp = a.timestamp + (int64_t)((b.timestamp - a.timestamp) * (double)t);
+
+    for (int i = 0; i < 3; i++) {
+        out->position[i] = a.position[i] + (b.position[i] - a.position[i]) * t;
+    }
+
+    // Shortest-arc slerp (q and -q are the same rotation)
+    float dot = 0.0f;
+    for (int i = 0; i < 4; i++) {
+        dot += a.rotation[i] * b.rotation[i];
+    }
+    const float sign = dot < 0.0f ? -1.0f : 1.0f;
+    dot = std::fabs(dot);
+
+    float wa;
+    float wb;
+    if (dot > 0.9995f) {
+        // Nearly identical: normalized lerp avoids dividing by sin(~0)
+        wa = 1.0f - t;
+        wb = t;
+    } else {
+        const float theta = std::acos(dot);
+        const float sinTheta = std::sin(theta);
+        wa = std::sin((1.0f - t) * theta) / sinTheta;
+        wb = std::sin(t * theta) / sinTheta;
+    }
+
+    float norm = 0.0f;
+    for (int i = 0; i < 4; i++) {
+        out->rotation[i] = wa * a.rotation[i] + wb * sign * b.rotation[i];
+        norm += out->rotation[i] * out->rotation[i];
+    }
+    norm = norm > 0.0f ? 1.0f / std::sqrt(norm) : 1.0f;
+    for (int i = 0; i < 4; i++) {
+        out->rotation[i] *= norm;
+    }
+
+    out->angularVelocity = b.angularVelocity;
+    out->linearVelocity = b.linearVelocity;
+
+    // A span across a relocalization jump is not a real trajectory
+    out->confidence = std::min(a.confidence, b.confidence);
+    out->initializing = a.initializing || b.initializing;
+    out->relocalizing = a.relocalizing || b.relocalizing;
+}
+
+bool predictPose(const PoseData* history, uint32_t count, int64_t timestamp,
+                 PredictionModel model, PoseData* out) {
+    if (count < 2) {
+        return false;
+    }
+
+    const PoseData& p0 = history[count - 2];
+    const PoseData& p1 = history[count - 1];
+    const int64_t dtNs = p1.timestamp - p0.timestamp;
+    if (dtNs <= 0) {
+        return false;
+    }
+
+    const float dt = dtNs / 1e9f;
+    const float h = (timestamp - p1.timestamp) / 1e9f;
+
+    *out = p1;
+    out->timestamp = timestamp;
+
+    // Position: constant velocity, optionally plus the acceleration seen
+    // across the last three samples
+    float velocity[3];
+    for (int i = 0; i < 3; i++) {
+        velocity[i] = (p1.position[i] - p0.position[i]) / dt;
+    }
+    float acceleration[3] = { 0.0f, 0.0f, 0.0f };
+    if (model == PredictionModel::CONSTANT_ACCELERATION && count >= 3) {
+        const PoseData& pm = history[count - 3];
+        const int64_t dtPrevNs = p0.timestamp - pm.timestamp;
+        if (dtPrevNs > 0) {
+            const float dtPrev = dtPrevNs / 1e9f;
+            const float dtMid = 0.5f * (dt + dtPrev);
+            for (int i = 0; i < 3; i++) {
+                const float prevVelocity = (p0.position[i] - pm.position[i]) / dtPrev;
+                acceleration[i] = (velocity[i] - prevVelocity) / dtMid;
+            }
+        }
+    }
+    for (int i = 0; i < 3; i++) {
+        // The finite difference is the velocity half an interval back
+        const float v = velocity[i] + acceleration[i] * 0.5f * dt;
+        out->position[i] = p1.position[i] + v * h + 0.5f * acceleration[i] * h * h;
+    }
+
+    // Orientation: apply the last inter-sample rotation scaled to the horizon
+    // q = (q1 * q0^-1)^(h / dt) * q1
+    const float q0Inverse[4] = { -p0.rotation[0], -p0.rotation[1], -p0.rotation[2], p0.rotation[3] };
+    float delta[4];
+    multiplyQuaternion(p1.rotation, q0Inverse, delta);
+    if (delta[3] < 0.0f) {
+        for (int i = 0; i < 4; i++) {
+            delta[i] = -delta[i];
+        }
+    }
+
+    const float sinHalf = std::sqrt(delta[0] * delta[0] + delta[1] * delta[1] + delta[2] * delta[2]);
+    if (sinHalf > 1e-6f) {
+        const float angle = 2.0f * std::atan2(sinHalf, delta[3]) * (h / dt);
+        const float s = std::sin(0.5f * angle) / sinHalf;
+        const float step[4] = { delta[0] * s, delta[1] * s, delta[2] * s, std::cos(0.5f * angle) };
+        multiplyQuaternion(step, p1.rotation, out->rotation);
+    }
+
+    out->predicted = true;
+    out->gapNs = timestamp - p1.timestamp;
+    return true;
+}
+
+const uint32_t PoseRing::CAPACITY;
+
+PoseRing::PoseRing()
+    : sequence_(0)
+    , head_(0)
+    , count_(0)
+{
+}
+
+bool PoseRing::push(const PoseData& pose) {
+    std::lock_guard<std::mutex> lock(writeMutex_);
+
+    if (count_ > 0 && pose.timestamp <= samples_[(uint32_t)(head_ - 1) & MASK].timestamp) {
+        return false;
+    }
+
+    const uint32_t seq = sequence_.load(std::memory_order_relaxed);
+    sequence_.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    samples_[(uint32_t)head_ & MASK] = pose;
+    head_++;
+    count_ = std::min(count_ + 1, CAPACITY);
+
+    sequence_.store(seq + 2, std::memory_order_release);
+    return true;
+}
+
+bool PoseRing::sample(int64_t timestamp, int64_t toleranceNs, PoseData* out) const {
+    for (;;) {
+        const uint32_t seq = sequence_.load(std::memory_order_acquire);
+        if (seq & 1) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        const uint64_t head = head_;
+        const uint32_t count = std::min(count_, CAPACITY);
+        bool found = false;
+        PoseData before;
+        PoseData after;
+        bool bracketed = false;
+
+        if (count > 0) {
+            // First sample with timestamp >= requested
+            uint32_t lo = 0;
+            uint32_t hi = count;
+            while (lo < hi) {
+                const uint32_t mid = (lo + hi) / 2;
+                if (at(head, count, mid).timestamp < timestamp) {
+                    lo = mid + 1;
+                } else {
+                    hi = mid;
+                }
+            }
+
+            if (lo == 0) {
+                before = at(head, count, 0);             // Older than the history
+            } else if (lo == count) {
+                before = at(head, count, count - 1);     // Newer than the history
+            } else {
+                before = at(head, count, lo - 1);
+                after = at(head, count, lo);
+                bracketed = true;
+            }
+            found = true;
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence_.load(std::memory_order_relaxed) != seq) {
+            continue;  // Raced with a write: retry
+        }
+
+        if (!found) {
+            return false;
+        }
+
+        if (!bracketed) {
+            if (std::llabs(before.timestamp - timestamp) > toleranceNs) {
+                return false;
+            }
+            *out = before;
+            out->gapNs = std::llabs(before.timestamp - timestamp);
+            return true;
+        }
+
+        // Interpolate only when at least one bracketing sample is close
+        if (std::min(timestamp - before.timestamp, after.timestamp - timestamp) > toleranceNs) {
+            return false;
+        }
+        const int64_t span = after.timestamp - before.timestamp;
+        const float t = span > 0 ? (float)((double)(timestamp - before.timestamp) / span) : 0.0f;
+        interpolatePose(before, after, t, out);
+        out->timestamp = timestamp;
+        out->gapNs = std::min(timestamp - before.timestamp, after.timestamp - timestamp);
+        out->predicted = false;
+        out->unreliable = false;
+        return true;
+    }
+}
+
+bool PoseRing::latest(PoseData* out) const {
+    for (;;) {
+        const uint32_t seq = sequence_.load(std::memory_order_acquire);
+        if (seq & 1) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        const uint64_t head = head_;
+        const bool found = count_ > 0;
+        if (found) {
+            *out = samples_[(uint32_t)(head - 1) & MASK];
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence_.load(std::memory_order_relaxed) == seq) {
+            return found;
+        }
+    }
+}
+
+uint32_t PoseRing::latestSamples(PoseData* out, uint32_t maxCount) const {
+    for (;;) {
+        const uint32_t seq = sequence_.load(std::memory_order_acquire);
+        if (seq & 1) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        const uint64_t head = head_;
+        const uint32_t count = std::min(std::min(count_, CAPACITY), maxCount);
+        for (uint32_t i = 0; i < count; i++) {
+            out[i] = samples_[(uint32_t)(head - count + i) & MASK];
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence_.load(std::memory_order_relaxed) == seq) {
+            return count;
+        }
+    }
+}
+
+uint32_t PoseRing::size() const {
+    for (;;) {
+        const uint32_t seq = sequence_.load(std::memory_order_acquire);
+        const uint32_t count = count_;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (!(seq & 1) && sequence_.load(std::memory_order_relaxed) == seq) {
+            return count;
+        }
+    }
+}
+
+void PoseRing::clear() {
+    std::lock_guard<std::mutex> lock(writeMutex_);
+
+    const uint32_t seq = sequence_.load(std::memory_order_relaxed);
+    sequence_.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    head_ = 0;
+    count_ = 0;
+
+    sequence_.store(seq + 2, std::memory_order_release);
+}
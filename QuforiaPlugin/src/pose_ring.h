@@ -0,0 +1,101 @@
+#ifndef QUEST_POSE_RING_H
+#define QUEST_POSE_RING_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+// Pose data structure for 6DoF tracking
+struct PoseData {
+    int64_t timestamp;  // Nanoseconds
+    float position[3];   // World space position (x, y, z)
+    float rotation[4];   // Quaternion (x, y, z, w)
+    float angularVelocity;  // rad/s relative to the previous sample
+    float linearVelocity;   // m/s relative to the previous sample
+
+    // Per-sample quality, set when the sample is fed
+    float confidence;   // Tracker confidence from Unity [0, 1]
+    bool initializing;  // Tracking has not settled since start/reset
+    bool relocalizing;  // Within the settle period after a jump or tracking loss
+
+    // Set by lookups
+    int64_t gapNs;      // Distance to the nearest real sample
+    bool predicted;     // Extrapolated past the newest sample
+    bool unreliable;    // Quality not guaranteed (reported as PoseValidity::UNRELIABLE)
+
+    PoseData()
+        : timestamp(0), angularVelocity(0.0f), linearVelocity(0.0f)
+        , confidence(1.0f), initializing(false), relocalizing(false)
+        , gapNs(0), predicted(false), unreliable(false) {
+        position[0] = position[1] = position[2] = 0.0f;
+        rotation[0] = rotation[1] = rotation[2] = 0.0f;
+        rotation[3] = 1.0f;  // Identity quaternion
+    }
+};
+
+// Interpolate between two poses: lerp on position, slerp on rotation.
+// Quality is the worse of the two samples.
+void interpolatePose(const PoseData& a, const PoseData& b, float t, PoseData* out);
+
+/**
+ * Motion model used to extrapolate past the newest pose sample.
+ */
+enum class PredictionModel : int32_t {
+    CONSTANT_VELOCITY = 0,     ///< Last linear and angular velocity held
+    CONSTANT_ACCELERATION = 1  ///< Linear acceleration from the last 3 samples (angular velocity held)
+};
+
+// Extrapolate history (oldest first, count >= 2) to timestamp
+bool predictPose(const PoseData* history, uint32_t count, int64_t timestamp,
+                 PredictionModel model, PoseData* out);
+
+/**
+ * Fixed-capacity pose history ordered by timestamp.
+ *
+ * Samples live in a flat array; writers are serialized by a mutex and publish
+ * through a sequence counter (seqlock), so readers never take a lock and never
+ * block the feeding thread. A reader that races with a write simply retries.
+ *
+ * Lookups binary-search the ring (O(log n)) and interpolate between the two
+ * samples bracketing the requested timestamp. Samples that do not advance the
+ * newest timestamp are dropped, which keeps the ring sorted.
+ */
+class PoseRing {
+public:
+    static const uint32_t CAPACITY = 128;  // ~1.4s at 90Hz
+
+    PoseRing();
+
+    // Returns false if the sample was older than the newest one and was dropped
+    bool push(const PoseData& pose);
+
+    // Pose at timestamp: interpolated between bracketing samples, or the
+    // nearest sample when outside the history. Fails if the nearest sample is
+    // further than toleranceNs away.
+    bool sample(int64_t timestamp, int64_t toleranceNs, PoseData* out) const;
+
+    // Most recent sample
+    bool latest(PoseData* out) const;
+
+    // Up to maxCount most recent samples, oldest first. Returns the number copied.
+    uint32_t latestSamples(PoseData* out, uint32_t maxCount) const;
+
+    uint32_t size() const;
+    void clear();
+
+private:
+    static const uint32_t MASK = CAPACITY - 1;
+
+    // Logical index i (0 = oldest) of a ring holding count samples ending at head
+    const PoseData& at(uint64_t head, uint32_t count, uint32_t i) const {
+        return samples_[(uint32_t)(head - count + i) & MASK];
+    }
+
+    std::mutex writeMutex_;
+    std::atomic<uint32_t> sequence_;  // Odd while a write is in progress
+    uint64_t head_;                   // Total samples written
+    uint32_t count_;
+    PoseData samples_[CAPACITY];
+};
+
+#endif // QUEST_POSE_RING_H
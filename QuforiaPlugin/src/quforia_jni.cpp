@@ -1,11 +1,8 @@
-#include <android/log.h>
 #include <cstring>
 #include "vuforia_driver.h"
+#include "quforia_log.h"
 
 #define LOG_TAG "QUFORIA"
-#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
-#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
-#define LOGD(...) __android_log_print(ANDROID_LOG_DEBUG, LOG_TAG, __VA_ARGS__)
 
 /**
  * Unity P/Invoke Bridge
@@ -62,6 +59,611 @@ bool nativeFeedDevicePose(float* position, float* rotation, long long timestamp)
     return true;
 }
 
+/**
+ * Feed device pose with the tracker's confidence in [0, 1]
+ * (drives pose validity classification)
+ */
+bool nativeFeedDevicePoseWithConfidence(float* position, float* rotation, float confidence,
+                                        long long timestamp) {
+
+    if (!g_driverInstance) {
+        LOGE("Driver not initialized");
+        return false;
+    }
+
+    if (!position || !rotation) {
+        LOGE("Null position or rotation");
+        return false;
+    }
+
+    g_driverInstance->feedDevicePose(position, rotation, timestamp, confidence);
+    return true;
+}
+
+/**
+ * Configure pose validity classification
+ * Poses below minConfidence or further than maxGapMs from a real sample are
+ * UNRELIABLE; jumps larger than jumpDistance (m) / jumpAngleDeg between
+ * consecutive samples start RELOCALIZING; faster rotation than
+ * maxAngularVelocityDeg (deg/s) is EXCESSIVE_MOTION
+ */
+bool nativeSetPoseValidation(bool enabled, float minConfidence, int maxGapMs, float jumpDistance,
+                             float jumpAngleDeg, float maxAngularVelocityDeg, int settleMs) {
+
+    if (!g_driverInstance) {
+        LOGE("Driver not initialized");
+        return false;
+    }
+
+    g_driverInstance->setPoseValidation(enabled, minConfidence, maxGapMs, jumpDistance,
+                                        jumpAngleDeg, maxAngularVelocityDeg, settleMs);
+    return true;
+}
+
+/**
+ * Get pose validity stats:
+ * [classified, unreliable, initializing, relocalizing, excessiveMotion, relocalizations]
+ */
+bool nativeGetPoseValidityStats(long long* stats, int length) {
+
+    if (!g_driverInstance) {
+        LOGE("Driver not initialized");
+        return false;
+    }
+
+    if (!stats || length < 6) {
+        LOGE("Invalid stats array");
+        return false;
+    }
+
+    int64_t values[6] = { 0, 0, 0, 0, 0, 0 };
+    g_driverInstance->getPoseValidityStats(&values[0], &values[1], &values[2],
+                                           &values[3], &values[4], &values[5]);
+    for (int i = 0; i < 6; i++) {
+        stats[i] = values[i];
+    }
+    return true;
+}
+
+/**
+ * Look up the device pose at a timestamp from the driver's pose history
+ * (same convention as fed: OpenXR position + quaternion)
+ * pose: [px, py, pz, qx, qy, qz, qw]
+ */
+bool nativeGetPoseAt(long long timestamp, float* pose, int length) {
+
+    if (!g_driverInstance) {
+        LOGE("Driver not initialized");
+        return false;
+    }
+
+    if (!pose || length < 7) {
+        LOGE("Invalid pose array");
+        return false;
+    }
+
+    PoseData poseData;
+    if (!g_driverInstance->queryPose(timestamp, &poseData)) {
+        return false;
+    }
+
+    memcpy(pose, poseData.position, 3 * sizeof(float));
+    memcpy(pose + 3, poseData.rotation, 4 * sizeof(float));
+    return true;
+}
+
+/**
+ * Set the pose lookup tolerance: a frame gets a pose only if a pose sample
+ * lies within toleranceMs of its timestamp (default 50ms)
+ */
+bool nativeSetPoseTolerance(int toleranceMs) {
+
+    if (!g_driverInstance) {
+        LOGE("Driver not initialized");
+        return false;
+    }
+
+    g_driverInstance->setPoseTolerance(toleranceMs);
+    return true;
+}
+
+/**
+ * Configure pose prediction for frames newer than the newest pose sample
+ * model: 0 = constant velocity, 1 = constant acceleration
+ * Poses are extrapolated up to maxHorizonMs and flagged unreliable beyond
+ * unreliableHorizonMs
+ */
+bool nativeSetPosePrediction(bool enabled, int model, int maxHorizonMs, int unreliableHorizonMs) {
+
+    if (!g_driverInstance) {
+        LOGE("Driver not initialized");
+        return false;
+    }
+
+    if (model < (int)PredictionModel::CONSTANT_VELOCITY ||
+        model > (int)PredictionModel::CONSTANT_ACCELERATION) {
+        LOGE("Invalid prediction model: %d", model);
+        return false;
+    }
+
+    g_driverInstance->setPosePrediction(enabled, (PredictionModel)model, maxHorizonMs,
+                                        unreliableHorizonMs);
+    return true;
+}
+
+/**
+ * Get pose prediction stats: [lookups, predicted, avgHorizonUs, maxHorizonUs]
+ */
+bool nativeGetPosePredictionStats(long long* stats, int length) {
+
+    if (!g_driverInstance) {
+        LOGE("Driver not initialized");
+        return false;
+    }
+
+    if (!stats || length < 4) {
+        LOGE("Invalid stats array");
+        return false;
+    }
+
+    int64_t lookups = 0;
+    int64_t predicted = 0;
+    int64_t totalHorizonNs = 0;
+    int64_t maxHorizonNs = 0;
+    g_driverInstance->getPosePredictionStats(&lookups, &predicted, &totalHorizonNs, &maxHorizonNs);
+
+    stats[0] = lookups;
+    stats[1] = predicted;
+    stats[2] = predicted > 0 ? totalHorizonNs / predicted / 1000 : 0;
+    stats[3] = maxHorizonNs / 1000;
+    return true;
+}
+
+/**
+ * Configure the late-pose join: a frame is held up to timeoutMs for a pose
+ * sample at or after its timestamp, then its pose is delivered before it.
+ * On timeout the pose is extrapolated.
+ */
+bool nativeSetPoseJoin(bool enabled, int timeoutMs) {
+
+    if (!g_driverInstance) {
+        LOGE("Driver not initialized");
+        return false;
+    }
+
+    if (timeoutMs < 0) {
+        LOGE("Invalid pose join timeout: %d ms", timeoutMs);
+        return false;
+    }
+
+    g_driverInstance->setPoseJoin(enabled, timeoutMs);
+    return true;
+}
+
+/**
+ * Get late-pose join stats: [joins, waits, timeouts, avgWaitUs, orderTimeouts]
+ */
+bool nativeGetPoseJoinStats(long long* stats, int length) {
+
+    if (!g_driverInstance) {
+        LOGE("Driver not initialized");
+        return false;
+    }
+
+    if (!stats || length < 5) {
+        LOGE("Invalid stats array");
+        return false;
+    }
+
+    int64_t joins = 0;
+    int64_t waits = 0;
+    int64_t timeouts = 0;
+    int64_t totalWaitNs = 0;
+    int64_t orderTimeouts = 0;
+    g_driverInstance->getPoseJoinStats(&joins, &waits, &timeouts, &totalWaitNs, &orderTimeouts);
+
+    stats[0] = joins;
+    stats[1] = waits;
+    stats[2] = timeouts;
+    stats[3] = waits > 0 ? totalWaitNs / waits / 1000 : 0;
+    stats[4] = orderTimeouts;
+    return true;
+}
+
+/**
+ * Forward every pose sample to Vuforia at tracker rate; each frame's own pose
+ * is still delivered immediately before the frame
+ */
+bool nativeSetPoseStreaming(bool enabled) {
+
+    if (!g_driverInstance) {
+        LOGE("Driver not initialized");
+        return false;
+    }
+
+    g_driverInstance->setPoseStreaming(enabled);
+    return true;
+}
+
+/**
+ * Set a rig camera's extrinsics relative to the head (head-local position and
+ * rotation quaternion x, y, z, w). Once set, fed poses are head poses and the
+ * camera pose is composed natively.
+ */
+bool nativeSetCameraExtrinsics(int cameraId, float* position, float* rotation) {
+
+    if (!g_driverInstance) {
+        LOGE("Driver not initialized");
+        return false;
+    }
+
+    if (!position || !rotation) {
+        LOGE("Null position or rotation");
+        return false;
+    }
+
+    return g_driverInstance->setCameraExtrinsics(cameraId, position, rotation);
+}
+
+/**
+ * Clear all rig extrinsics (fed poses are camera poses again)
+ */
+bool nativeClearCameraExtrinsics() {
+
+    if (!g_driverInstance) {
+        LOGE("Driver not initialized");
+        return false;
+    }
+
+    g_driverInstance->clearCameraExtrinsics();
+    return true;
+}
+
+/**
+ * Select the rig camera that subsequently fed frames come from
+ */
+bool nativeSetActiveCamera(int cameraId) {
+
+    if (!g_driverInstance) {
+        LOGE("Driver not initialized");
+        return false;
+    }
+
+    return g_driverInstance->setActiveCamera(cameraId);
+}
+
+/**
+ * Set intrinsics for one rig camera (stereo ingestion): same layout as
+ * nativeSetCameraIntrinsics
+ */
+bool nativeSetCameraIntrinsicsForCamera(int cameraId, float* intrinsics, int length) {
+
+    if (!g_driverInstance) {
+        LOGE("Driver not initialized");
+        return false;
+    }
+
+    if (!intrinsics || length < 14) {
+        LOGE("Invalid intrinsics array (%d elements)", length);
+        return false;
+    }
+
+    return g_driverInstance->setCameraIntrinsics(intrinsics, cameraId);
+}
+
+/**
+ * Select which rig camera's frames are delivered when both are fed
+ * policy: 0 = active camera, 1 = alternate, 2 = best camera
+ */
+bool nativeSetStereoPolicy(int policy) {
+
+    if (!g_driverInstance) {
+        LOGE("Driver not initialized");
+        return false;
+    }
+
+    if (policy < (int)StereoPolicy::ACTIVE_CAMERA || policy > (int)StereoPolicy::BEST_CAMERA) {
+        LOGE("Invalid stereo policy %d", policy);
+        return false;
+    }
+
+    g_driverInstance->setStereoPolicy((StereoPolicy)policy);
+    return true;
+}
+
+/**
+ * Report how well a rig camera currently sees the tracked target [0, 1]
+ * (drives the best-camera stereo policy)
+ */
+bool nativeSetCameraTargetScore(int cameraId, float score) {
+
+    if (!g_driverInstance) {
+        LOGE("Driver not initialized");
+        return false;
+    }
+
+    return g_driverInstance->setCameraTargetScore(cameraId, score);
+}
+
+/**
+ * Get stereo delivery stats: [camera 0 picks, camera 1 picks, camera switches]
+ */
+bool nativeGetStereoStats(long long* stats, int length) {
+
+    if (!g_driverInstance) {
+        LOGE("Driver not initialized");
+        return false;
+    }
+
+    if (!stats || length < QuestVuforiaDriver::MAX_RIG_CAMERAS + 1) {
+        LOGE("Invalid stats array");
+        return false;
+    }
+
+    int64_t picks[QuestVuforiaDriver::MAX_RIG_CAMERAS];
+    int64_t switches = 0;
+    g_driverInstance->getStereoStats(picks, &switches);
+
+    for (int i = 0; i < QuestVuforiaDriver::MAX_RIG_CAMERAS; i++) {
+        stats[i] = picks[i];
+    }
+    stats[QuestVuforiaDriver::MAX_RIG_CAMERAS] = switches;
+    return true;
+}
+
+/**
+ * Declare the clock of fed and queried timestamps; the driver stamps them into
+ * CLOCK_MONOTONIC (0 = CLOCK_MONOTONIC, 1 = CLOCK_REALTIME,
+ * 2 = other clock with estimated offset/drift, 3 = arrival time)
+ */
+bool nativeSetClockDomain(int domain) {
+
+    if (!g_driverInstance) {
+        LOGE("Driver not initialized");
+        return false;
+    }
+
+    if (domain < 0 || domain > (int)ClockDomain::ARRIVAL) {
+        LOGE("Invalid clock domain: %d", domain);
+        return false;
+    }
+
+    g_driverInstance->setClockDomain((ClockDomain)domain);
+    return true;
+}
+
+/**
+ * Get clock mapping statistics
+ * stats: [offsetNs, driftPpb, resyncs, samples, avgFrameAgeNs]
+ */
+bool nativeGetClockStats(long long* stats, int length) {
+
+    if (!g_driverInstance) {
+        LOGE("Driver not initialized");
+        return false;
+    }
+
+    if (!stats || length < 5) {
+        LOGE("Invalid stats array");
+        return false;
+    }
+
+    int64_t values[5] = {0};
+    g_driverInstance->getClockStats(&values[0], &values[1], &values[2], &values[3], &values[4]);
+
+    for (int i = 0; i < 5; i++) {
+        stats[i] = values[i];
+    }
+    return true;
+}
+
+/**
+ * Get per-stage pipeline latency and throughput
+ * stats: for each stage (Unity submit, convert, queue wait, pose lookup,
+ * Vuforia callback, total): [samples, p50Ns, p95Ns, p99Ns]; then
+ * [framesFed, framesDelivered, posesFed, posesDelivered, elapsedNs]
+ */
+bool nativeGetPipelineStats(long long* stats, int length) {
+
+    if (!g_driverInstance) {
+        LOGE("Driver not initialized");
+        return false;
+    }
+
+    if (!stats || length < PipelineStats::VALUE_COUNT) {
+        LOGE("Invalid stats array");
+        return false;
+    }
+
+    int64_t values[PipelineStats::VALUE_COUNT];
+    g_driverInstance->pipelineStats().snapshot(values);
+
+    for (int i = 0; i < PipelineStats::VALUE_COUNT; i++) {
+        stats[i] = values[i];
+    }
+    return true;
+}
+
+/**
+ * Restart pipeline latency histograms and throughput counters
+ */
+bool nativeResetPipelineStats() {
+
+    if (!g_driverInstance) {
+        LOGE("Driver not initialized");
+        return false;
+    }
+
+    g_driverInstance->pipelineStats().reset();
+    return true;
+}
+
+/**
+ * Start or stop recording the pipeline timeline (starting begins a new capture)
+ */
+bool nativeSetTraceEnabled(bool enabled) {
+
+    if (!g_driverInstance) {
+        LOGE("Driver not initialized");
+        return false;
+    }
+
+    g_driverInstance->traceRecorder().setEnabled(enabled);
+    return true;
+}
+
+/**
+ * Write the recorded timeline to path as Chrome trace-event JSON
+ * (chrome://tracing, Perfetto); recording continues
+ * count: number of events written
+ */
+bool nativeDumpTrace(const char* path, int* count) {
+
+    if (!g_driverInstance) {
+        LOGE("Driver not initialized");
+        return false;
+    }
+
+    if (!path) {
+        LOGE("Null trace path");
+        return false;
+    }
+
+    const int written = g_driverInstance->traceRecorder().dump(path);
+    if (count) {
+        *count = written;
+    }
+    return written >= 0;
+}
+
+/**
+ * Set the lowest native log level written to logcat
+ * (3 = debug, 4 = info, 5 = warn, 6 = error; levels compiled out stay out).
+ * Works before the driver is initialized.
+ */
+bool nativeSetLogLevel(int level) {
+
+    if (level < ANDROID_LOG_DEBUG || level > ANDROID_LOG_ERROR) {
+        LOGE("Invalid log level: %d", level);
+        return false;
+    }
+
+    AsyncLog::setLevel(level);
+    return true;
+}
+
+/**
+ * Get native logging stats: [messages written, messages dropped (ring full)]
+ */
+bool nativeGetLogStats(long long* stats, int length) {
+
+    if (!stats || length < 2) {
+        LOGE("Invalid stats array");
+        return false;
+    }
+
+    int64_t written = 0;
+    int64_t dropped = 0;
+    AsyncLog::getStats(&written, &dropped);
+
+    stats[0] = written;
+    stats[1] = dropped;
+    return true;
+}
+
+/**
+ * Take anchors Vuforia created since the last call so Unity can back them with
+ * spatial anchors. uuids: 37 bytes per anchor (NUL-terminated), poses: 7 floats
+ * per anchor (position x, y, z + rotation x, y, z, w, fed pose convention).
+ */
+bool nativeGetCreatedAnchors(unsigned char* uuids, float* poses, int maxAnchors, int* count) {
+
+    if (!g_driverInstance) {
+        LOGE("Driver not initialized");
+        return false;
+    }
+
+    if (!uuids || !poses || !count || maxAnchors < 0) {
+        LOGE("Invalid anchor arrays");
+        return false;
+    }
+
+    *count = g_driverInstance->anchorStore().takeCreated((char*)uuids, poses, maxAnchors);
+    return true;
+}
+
+/**
+ * Report the current poses of the spatial anchors backing native anchors, all
+ * in one call so a relocalization is reported to Vuforia as one batch.
+ * Same layout as nativeGetCreatedAnchors; known[i] is set to 0 for anchors
+ * Vuforia has removed (their spatial anchors can be released).
+ */
+bool nativeUpdateAnchors(unsigned char* uuids, float* poses, int* known, int count) {
+
+    if (!g_driverInstance) {
+        LOGE("Driver not initialized");
+        return false;
+    }
+
+    if (!uuids || !poses || !known || count < 0) {
+        LOGE("Invalid anchor arrays");
+        return false;
+    }
+
+    AnchorStore& store = g_driverInstance->anchorStore();
+    for (int i = 0; i < count; i++) {
+        char* uuid = (char*)uuids + i * ANCHOR_UUID_LENGTH;
+        uuid[ANCHOR_UUID_LENGTH - 1] = '\0';
+        known[i] = store.update(uuid, poses + i * 7) ? 1 : 0;
+    }
+    return true;
+}
+
+/**
+ * The spatial anchor backing a native anchor was lost; Vuforia is told the
+ * anchor was removed
+ */
+bool nativeDropAnchor(const char* uuid) {
+
+    if (!g_driverInstance) {
+        LOGE("Driver not initialized");
+        return false;
+    }
+
+    if (!uuid) {
+        LOGE("Null anchor uuid");
+        return false;
+    }
+
+    return g_driverInstance->anchorStore().drop(uuid);
+}
+
+/**
+ * Get anchor stats: [live anchors, onAnchorUpdate batches, anchors reported]
+ */
+bool nativeGetAnchorStats(long long* stats, int length) {
+
+    if (!g_driverInstance) {
+        LOGE("Driver not initialized");
+        return false;
+    }
+
+    if (!stats || length < 3) {
+        LOGE("Invalid stats array");
+        return false;
+    }
+
+    int64_t anchors = 0;
+    int64_t batches = 0;
+    int64_t notified = 0;
+    g_driverInstance->anchorStore().getStats(&anchors, &batches, &notified);
+
+    stats[0] = anchors;
+    stats[1] = batches;
+    stats[2] = notified;
+    return true;
+}
+
 /**
  * Feed camera frame to the Vuforia Driver
  */
@@ -78,7 +680,313 @@ bool nativeFeedCameraFrame(unsigned char* imageData, int width, int height,
         return false;
     }
 
-    g_driverInstance->feedCameraFrame(imageData, width, height, intrinsics, timestamp);
+    g_driverInstance->feedCameraFrame(imageData, width, height,
+                                      VuforiaDriver::PixelFormat::RGB888, false,
+                                      intrinsics, timestamp);
+    return true;
+}
+
+/**
+ * Feed an RGBA32 camera frame (PassthroughCameraAccess layout) to the Vuforia Driver.
+ * Channel repacking and the optional vertical flip happen natively, so Unity
+ * can hand over the passthrough pixels without touching them.
+ */
+bool nativeFeedCameraFrameRGBA(unsigned char* imageData, int width, int height, bool flipVertically,
+                               float* intrinsics, int intrinsicsLength, long long timestamp) {
+
+    if (!g_driverInstance) {
+        LOGE("Driver not initialized");
+        return false;
+    }
+
+    if (!imageData) {
+        LOGE("Null image data");
+        return false;
+    }
+
+    if (intrinsics && intrinsicsLength < 14) {
+        LOGE("Invalid intrinsics array (%d elements)", intrinsicsLength);
+        return false;
+    }
+
+    g_driverInstance->feedCameraFrame(imageData, width, height,
+                                      VuforiaDriver::PixelFormat::RGBA8888, flipVertically,
+                                      intrinsics, timestamp);
+    return true;
+}
+
+/**
+ * Feed an RGBA32 frame captured by a specific rig camera (stereo ingestion).
+ * Intrinsics set for that camera take precedence over the per-frame array.
+ */
+bool nativeFeedCameraFrameRGBAForCamera(int cameraId, unsigned char* imageData, int width, int height,
+                                        bool flipVertically, float* intrinsics, int intrinsicsLength,
+                                        long long timestamp) {
+
+    if (!g_driverInstance) {
+        LOGE("Driver not initialized");
+        return false;
+    }
+
+    if (!imageData) {
+        LOGE("Null image data");
+        return false;
+    }
+
+    if (cameraId < 0 || cameraId >= QuestVuforiaDriver::MAX_RIG_CAMERAS) {
+        LOGE("Invalid camera %d", cameraId);
+        return false;
+    }
+
+    if (intrinsics && intrinsicsLength < 14) {
+        LOGE("Invalid intrinsics array (%d elements)", intrinsicsLength);
+        return false;
+    }
+
+    g_driverInstance->feedCameraFrame(imageData, width, height,
+                                      VuforiaDriver::PixelFormat::RGBA8888, flipVertically,
+                                      intrinsics, timestamp, cameraId);
+    return true;
+}
+
+/**
+ * Set digital crop/zoom window (normalized to the source frame, top-left origin)
+ * upscale: scale the window back up to the camera mode size
+ */
+bool nativeSetCropWindow(bool enabled, float x, float y, float width, float height, bool upscale) {
+
+    if (!g_driverInstance) {
+        LOGE("Driver not initialized");
+        return false;
+    }
+
+    g_driverInstance->setCropWindow(enabled, x, y, width, height, upscale);
+    return true;
+}
+
+/**
+ * Enable native lens undistortion (uses distortion coefficients d0-d7 from the
+ * intrinsics; delivered frames then carry zero distortion)
+ */
+bool nativeSetUndistortionEnabled(bool enabled) {
+
+    if (!g_driverInstance) {
+        LOGE("Driver not initialized");
+        return false;
+    }
+
+    g_driverInstance->setUndistortionEnabled(enabled);
+    return true;
+}
+
+/**
+ * Configure low-light normalization of delivered frames
+ * mode: 0 = off, 1 = contrast stretch, 2 = CLAHE
+ * Only frames with mean luma below darkThreshold (0-255) are brightened;
+ * maxGain caps the contrast gain (global for stretch, clip limit for CLAHE)
+ */
+bool nativeSetLowLightNormalization(int mode, int darkThreshold, float maxGain) {
+
+    if (!g_driverInstance) {
+        LOGE("Driver not initialized");
+        return false;
+    }
+
+    g_driverInstance->setLowLightNormalization(mode, darkThreshold, maxGain);
+    return true;
+}
+
+/**
+ * Enable luma-only delivery for NV12/NV21/YUV420P modes
+ * (chroma planes are filled with neutral grey once and reused)
+ */
+bool nativeSetGrayscaleOnly(bool enabled) {
+
+    if (!g_driverInstance) {
+        LOGE("Driver not initialized");
+        return false;
+    }
+
+    g_driverInstance->setGrayscaleOnly(enabled);
+    return true;
+}
+
+/**
+ * Configure adaptive output resolution
+ * reducedScale: fraction of the mode size used once a target is locked
+ * holdMs: how long tracking must be stable before reducing
+ */
+bool nativeSetAdaptiveResolution(bool enabled, float reducedScale, int holdMs) {
+
+    if (!g_driverInstance) {
+        LOGE("Driver not initialized");
+        return false;
+    }
+
+    g_driverInstance->setAdaptiveResolution(enabled, reducedScale, holdMs);
+    return true;
+}
+
+/**
+ * Report target tracking status (0 = searching, 1 = tracked, 2 = extended)
+ */
+bool nativeSetTrackingStatus(int status) {
+
+    if (!g_driverInstance) {
+        LOGE("Driver not initialized");
+        return false;
+    }
+
+    if (status < (int)TrackingStatus::SEARCHING || status > (int)TrackingStatus::EXTENDED) {
+        LOGE("Invalid tracking status: %d", status);
+        return false;
+    }
+
+    g_driverInstance->setTrackingStatus((TrackingStatus)status);
+    return true;
+}
+
+/**
+ * Get adaptive resolution metrics: [msAtFull, msAtReduced, switchCount]
+ */
+bool nativeGetAdaptiveResolutionStats(long long* stats, int length) {
+
+    if (!g_driverInstance) {
+        LOGE("Driver not initialized");
+        return false;
+    }
+
+    if (!stats || length < 3) {
+        LOGE("Invalid stats array");
+        return false;
+    }
+
+    int64_t fullNs = 0;
+    int64_t reducedNs = 0;
+    int switchCount = 0;
+    g_driverInstance->getAdaptiveResolutionStats(&fullNs, &reducedNs, &switchCount);
+
+    stats[0] = fullNs / 1000000;
+    stats[1] = reducedNs / 1000000;
+    stats[2] = switchCount;
+    return true;
+}
+
+/**
+ * Configure motion-based frame skipping
+ * Frames whose pose shows angular velocity above maxAngularVelocity (deg/s) or
+ * linear velocity above maxLinearVelocity (m/s) are not delivered; at most
+ * maxConsecutiveSkips frames in a row are dropped
+ */
+bool nativeSetMotionSkipping(bool enabled, float maxAngularVelocity, float maxLinearVelocity,
+                             int maxConsecutiveSkips) {
+
+    if (!g_driverInstance) {
+        LOGE("Driver not initialized");
+        return false;
+    }
+
+    g_driverInstance->setMotionSkipping(enabled, maxAngularVelocity, maxLinearVelocity,
+                                        maxConsecutiveSkips);
+    return true;
+}
+
+/**
+ * Get motion skipping counters: [framesEvaluated, framesSkipped]
+ */
+bool nativeGetMotionSkipStats(long long* stats, int length) {
+
+    if (!g_driverInstance) {
+        LOGE("Driver not initialized");
+        return false;
+    }
+
+    if (!stats || length < 2) {
+        LOGE("Invalid stats array");
+        return false;
+    }
+
+    int64_t evaluated = 0;
+    int64_t skipped = 0;
+    g_driverInstance->getMotionSkipStats(&evaluated, &skipped);
+
+    stats[0] = evaluated;
+    stats[1] = skipped;
+    return true;
+}
+
+/**
+ * Configure static-scene throttling
+ * While the luma thumbnail differs by less than lumaThreshold (mean abs diff,
+ * 0-255) and the headset moved less than translationThreshold (m) /
+ * rotationThreshold (deg), frames are delivered at no more than floorFps
+ */
+bool nativeSetSceneChangeGating(bool enabled, float lumaThreshold, float translationThreshold,
+                                float rotationThreshold, float floorFps) {
+
+    if (!g_driverInstance) {
+        LOGE("Driver not initialized");
+        return false;
+    }
+
+    g_driverInstance->setSceneChangeGating(enabled, lumaThreshold, translationThreshold,
+                                           rotationThreshold, floorFps);
+    return true;
+}
+
+/**
+ * Get static-scene throttling counters: [framesEvaluated, framesSkipped]
+ */
+bool nativeGetSceneChangeStats(long long* stats, int length) {
+
+    if (!g_driverInstance) {
+        LOGE("Driver not initialized");
+        return false;
+    }
+
+    if (!stats || length < 2) {
+        LOGE("Invalid stats array");
+        return false;
+    }
+
+    int64_t evaluated = 0;
+    int64_t skipped = 0;
+    g_driverInstance->getSceneChangeStats(&evaluated, &skipped);
+
+    stats[0] = evaluated;
+    stats[1] = skipped;
+    return true;
+}
+
+/**
+ * Configure brightness gating
+ * Frames whose mean luma (0-255) is below minMeanLuma are not delivered and
+ * their poses are reported with PoseReason::INSUFFICIENT_LIGHT
+ */
+bool nativeSetBrightnessGating(bool enabled, int minMeanLuma) {
+
+    if (!g_driverInstance) {
+        LOGE("Driver not initialized");
+        return false;
+    }
+
+    g_driverInstance->setBrightnessGating(enabled, minMeanLuma);
+    return true;
+}
+
+/**
+ * Configure best-of-N frame selection
+ * When enabled, the sharpest queued frame no older than windowMs behind the
+ * newest one is delivered instead of always the newest
+ */
+bool nativeSetFrameSelection(bool enabled, int windowMs) {
+
+    if (!g_driverInstance) {
+        LOGE("Driver not initialized");
+        return false;
+    }
+
+    g_driverInstance->setFrameSelection(enabled, windowMs);
     return true;
 }
 
@@ -0,0 +1,328 @@
+#include "quforia_log.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+std::atomic<int> AsyncLog::runtimeLevel_(ANDROID_LOG_DEBUG);
+
+void LogRecord::addString(const char* value) {
+    Arg& arg = args[argCount++];
+    arg.type = ArgType::STRING;
+    if (value == nullptr) {
+        value = "(null)";
+    }
+
+    // Truncate to the space left (always NUL-terminated)
+    arg.offset = stringsUsed;
+    const uint32_t space = stringsUsed < (uint32_t)STRING_SPACE ? STRING_SPACE - stringsUsed : 0;
+    if (space == 0) {
+        arg.offset = STRING_SPACE - 1;
+        strings[STRING_SPACE - 1] = '\0';
+        return;
+    }
+    const size_t length = strnlen(value, space - 1);
+    memcpy(strings + stringsUsed, value, length);
+    strings[stringsUsed + length] = '\0';
+    stringsUsed += (uint32_t)length + 1;
+}
+
+// =============================================================================
+// Writer (ring + background formatting thread)
+// =============================================================================
+
+struct AsyncLogWriter {
+    typedef AsyncLog::Slot Slot;
+
+    Slot ring[AsyncLog::RING_SIZE];
+    std::atomic<uint64_t> enqueuePosition;
+    uint64_t dequeuePosition;  // Consumer side, guarded by consumeMutex
+    std::mutex consumeMutex;
+
+    std::atomic<int64_t> written;
+    std::atomic<int64_t> dropped;
+    int64_t droppedReported;
+
+    // Drain interval: starts short, doubles while the ring stays empty
+    static const int MIN_POLL_MS = 5;
+    static const int MAX_POLL_MS = 100;
+
+    AsyncLogWriter()
+        : enqueuePosition(0)
+        , dequeuePosition(0)
+        , written(0)
+        , dropped(0)
+        , droppedReported(0)
+    {
+        for (int i = 0; i < AsyncLog::RING_SIZE; i++) {
+            ring[i].sequence.store((uint64_t)i, std::memory_order_relaxed);
+        }
+        // Never joined: the writer lives until the process exits
+        std::thread(&AsyncLogWriter::run, this).detach();
+    }
+
+    Slot* claim() {
+        uint64_t position = enqueuePosition.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = ring[position & (AsyncLog::RING_SIZE - 1)];
+            const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+            const int64_t difference = (int64_t)sequence - (int64_t)position;
+            if (difference == 0) {
+                if (enqueuePosition.compare_exchange_weak(position, position + 1,
+                                                          std::memory_order_relaxed)) {
+                    slot.position = position;
+                    return &slot;
+                }
+            } else if (difference < 0) {
+                // Full: the writer thread is behind, never wait for it
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return nullptr;
+            } else {
+                position = enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void publish(Slot* slot) {
+        slot->sequence.store(slot->position + 1, std::memory_order_release);
+    }
+
+    // Format and write every published record; returns how many were written
+    int drain() {
+        std::lock_guard<std::mutex> lock(consumeMutex);
+
+        int count = 0;
+        char line[1024];
+        for (;;) {
+            Slot& slot = ring[dequeuePosition & (AsyncLog::RING_SIZE - 1)];
+            if (slot.sequence.load(std::memory_order_acquire) != dequeuePosition + 1) {
+                break;
+            }
+            format(slot.record, line, sizeof(line));
+            __android_log_write(slot.record.level, slot.record.tag, line);
+            slot.sequence.store(dequeuePosition + AsyncLog::RING_SIZE, std::memory_order_release);
+            dequeuePosition++;
+            count++;
+        }
+        written.fetch_add(count, std::memory_order_relaxed);
+
+        const int64_t droppedNow = dropped.load(std::memory_order_relaxed);
+        if (droppedNow != droppedReported) {
+            snprintf(line, sizeof(line), "Log ring full: %lld messages dropped (%lld total)",
+                     (long long)(droppedNow - droppedReported), (long long)droppedNow);
+            __android_log_write(ANDROID_LOG_WARN, "QUFORIA", line);
+            droppedReported = droppedNow;
+        }
+        return count;
+    }
+
+    void run() {
+        // Producers never signal (no syscalls on the logging path); poll
+        // instead, backing off while idle and snapping back on new records
+        int intervalMs = MIN_POLL_MS;
+        for (;;) {
+            if (drain() > 0) {
+                intervalMs = MIN_POLL_MS;
+            } else {
+                intervalMs = intervalMs * 2 < MAX_POLL_MS ? intervalMs * 2 : MAX_POLL_MS;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(intervalMs));
+        }
+    }
+
+    static void format(const LogRecord& record, char* out, size_t size);
+};
+
+static void flushAtExit() {
+    AsyncLog::flush();
+}
+
+static AsyncLogWriter& writer() {
+    // Started on first use and never destroyed, so log calls from static
+    // destructors and threads still running at exit stay safe. Pending
+    // records are flushed at exit and by vuforiaDriver_deinit
+    static AsyncLogWriter* instance = [] {
+        AsyncLogWriter* created = new AsyncLogWriter();
+        std::atexit(flushAtExit);
+        return created;
+    }();
+    return *instance;
+}
+
+static int64_t intValue(const LogRecord::Arg& arg) {
+    switch (arg.type) {
+    case LogRecord::ArgType::DOUBLE: return (int64_t)arg.d;
+    case LogRecord::ArgType::POINTER: return (int64_t)(uintptr_t)arg.p;
+    case LogRecord::ArgType::STRING: return 0;
+    default: return arg.i;
+    }
+}
+
+static double doubleValue(const LogRecord::Arg& arg) {
+    switch (arg.type) {
+    case LogRecord::ArgType::DOUBLE: return arg.d;
+    case LogRecord::ArgType::UINT: return (double)arg.u;
+    case LogRecord::ArgType::INT: return (double)arg.i;
+    default: return 0.0;
+    }
+}
+
+// Deferred printf: each conversion is formatted on its own with the stored
+// argument, length modifiers rewritten to match the 64-bit storage
+void AsyncLogWriter::format(const LogRecord& record, char* out, size_t size) {
+    size_t used = 0;
+    int argIndex = 0;
+    const char* p = record.format;
+
+    auto append = [&](const char* text, size_t length) {
+        const size_t room = size - 1 - used;
+        length = length < room ? length : room;
+        memcpy(out + used, text, length);
+        used += length;
+    };
+    auto nextArg = [&]() -> const LogRecord::Arg* {
+        return argIndex < record.argCount ? &record.args[argIndex++] : nullptr;
+    };
+
+    while (*p && used < size - 1) {
+        if (*p != '%') {
+            const char* literal = p;
+            while (*p && *p != '%') p++;
+            append(literal, (size_t)(p - literal));
+            continue;
+        }
+        if (p[1] == '%') {
+            append("%", 1);
+            p += 2;
+            continue;
+        }
+
+        // %[flags][width][.precision][length]conversion
+        char spec[48];
+        size_t specLength = 0;
+        spec[specLength++] = *p++;
+        while (*p && strchr("-+ #0", *p) && specLength < 20) spec[specLength++] = *p++;
+        if (*p == '*') {
+            const LogRecord::Arg* width = nextArg();
+            specLength += snprintf(spec + specLength, 12, "%d", width ? (int)intValue(*width) : 0);
+            p++;
+        }
+        while (*p >= '0' && *p <= '9' && specLength < 30) spec[specLength++] = *p++;
+        if (*p == '.') {
+            spec[specLength++] = *p++;
+            if (*p == '*') {
+                const LogRecord::Arg* precision = nextArg();
+                specLength += snprintf(spec + specLength, 12, "%d", precision ? (int)intValue(*precision) : 0);
+                p++;
+            }
+            while (*p >= '0' && *p <= '9' && specLength < 42) spec[specLength++] = *p++;
+        }
+        int lengthBits = 32;
+        while (*p && strchr("hljztLq", *p)) {
+            if (*p == 'h') lengthBits = lengthBits == 16 ? 8 : 16;
+            else lengthBits = 64;
+            p++;
+        }
+        const char conversion = *p ? *p++ : '\0';
+
+        const LogRecord::Arg* arg = nextArg();
+        if (arg == nullptr) {
+            append("(missing)", 9);
+            continue;
+        }
+
+        char value[256];
+        int length = 0;
+        switch (conversion) {
+        case 'd':
+        case 'i': {
+            int64_t v = intValue(*arg);
+            if (lengthBits == 32) v = (int32_t)v;
+            else if (lengthBits == 16) v = (int16_t)v;
+            else if (lengthBits == 8) v = (int8_t)v;
+            memcpy(spec + specLength, "ll", 2);
+            spec[specLength + 2] = conversion;
+            spec[specLength + 3] = '\0';
+            length = snprintf(value, sizeof(value), spec, (long long)v);
+            break;
+        }
+        case 'u':
+        case 'x':
+        case 'X':
+        case 'o': {
+            uint64_t v = (uint64_t)intValue(*arg);
+            if (lengthBits < 64) v &= (1ull << lengthBits) - 1;
+            memcpy(spec + specLength, "ll", 2);
+            spec[specLength + 2] = conversion;
+            spec[specLength + 3] = '\0';
+            length = snprintf(value, sizeof(value), spec, (unsigned long long)v);
+            break;
+        }
+        case 'c':
+            spec[specLength] = 'c';
+            spec[specLength + 1] = '\0';
+            length = snprintf(value, sizeof(value), spec, (int)intValue(*arg));
+            break;
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+            spec[specLength] = conversion;
+            spec[specLength + 1] = '\0';
+            length = snprintf(value, sizeof(value), spec, doubleValue(*arg));
+            break;
+        case 's':
+            spec[specLength] = 's';
+            spec[specLength + 1] = '\0';
+            length = snprintf(value, sizeof(value), spec,
+                              arg->type == LogRecord::ArgType::STRING ? record.strings + arg->offset : "?");
+            break;
+        case 'p':
+            length = snprintf(value, sizeof(value), "%p",
+                              arg->type == LogRecord::ArgType::POINTER ? arg->p : nullptr);
+            break;
+        default:
+            // Unknown conversion: keep the spec as written
+            spec[specLength] = conversion;
+            spec[specLength + 1] = '\0';
+            length = snprintf(value, sizeof(value), "%s", spec);
+            break;
+        }
+        if (length > 0) {
+            append(value, (size_t)length < sizeof(value) ? (size_t)length : sizeof(value) - 1);
+        }
+    }
+    out[used] = '\0';
+}
+
+// =============================================================================
+// AsyncLog
+// =============================================================================
+
+void AsyncLog::setLevel(int level) {
+    runtimeLevel_ = level;
+}
+
+AsyncLog::Slot* AsyncLog::claim() {
+    return writer().claim();
+}
+
+void AsyncLog::publish(Slot* slot) {
+    writer().publish(slot);
+}
+
+void AsyncLog::flush() {
+    writer().drain();
+}
+
+void AsyncLog::getStats(int64_t* written, int64_t* dropped) {
+    AsyncLogWriter& instance = writer();
+    if (written) *written = instance.written.load();
+    if (dropped) *dropped = instance.dropped.load();
+}
@@ -0,0 +1,191 @@
+#ifndef QUEST_QUFORIA_LOG_H
+#define QUEST_QUFORIA_LOG_H
+
+#include <android/log.h>
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+// android_LogPriority values (the enum itself is not visible to the preprocessor)
+#define QUFORIA_LOG_DEBUG 3
+#define QUFORIA_LOG_INFO 4
+#define QUFORIA_LOG_WARN 5
+#define QUFORIA_LOG_ERROR 6
+
+// Lowest level compiled in; set per build type in CMakeLists.txt
+#ifndef QUFORIA_LOG_LEVEL
+#define QUFORIA_LOG_LEVEL QUFORIA_LOG_DEBUG
+#endif
+
+/**
+ * Log call captured without formatting: the format pointer (a literal) and
+ * the raw arguments. Strings are copied into the record (truncated to
+ * STRING_SPACE in total); everything else is stored as a 64-bit value.
+ */
+struct LogRecord {
+    static const int MAX_ARGS = 16;
+    static const int STRING_SPACE = 160;
+
+    enum class ArgType : uint8_t { INT, UINT, DOUBLE, STRING, POINTER };
+
+    struct Arg {
+        ArgType type;
+        union {
+            int64_t i;
+            uint64_t u;
+            double d;
+            const void* p;
+            uint32_t offset;  // STRING: start in strings
+        };
+    };
+
+    int level;
+    const char* tag;
+    const char* format;
+    int argCount;
+    Arg args[MAX_ARGS];
+    uint32_t stringsUsed;
+    char strings[STRING_SPACE];
+
+    void addString(const char* value);
+
+    // By value: printf arguments are scalars, and binding a reference would
+    // require a definition for every static const member passed to a log call
+    template <typename T>
+    void add(T value) {
+        typedef typename std::decay<T>::type Value;
+        if (argCount >= MAX_ARGS) {
+            return;
+        }
+        if constexpr (std::is_same<Value, char*>::value || std::is_same<Value, const char*>::value) {
+            addString(value);
+            return;
+        } else {
+            Arg& arg = args[argCount++];
+            if constexpr (std::is_floating_point<Value>::value) {
+                arg.type = ArgType::DOUBLE;
+                arg.d = (double)value;
+            } else if constexpr (std::is_pointer<Value>::value) {
+                arg.type = ArgType::POINTER;
+                arg.p = (const void*)value;
+            } else if constexpr (std::is_enum<Value>::value) {
+                arg.type = ArgType::INT;
+                arg.i = (int64_t)value;
+            } else if constexpr (std::is_signed<Value>::value) {
+                arg.type = ArgType::INT;
+                arg.i = (int64_t)value;
+            } else {
+                arg.type = ArgType::UINT;
+                arg.u = (uint64_t)value;
+            }
+        }
+    }
+
+    void addAll() {}
+
+    template <typename T, typename... Rest>
+    void addAll(T value, Rest... rest) {
+        add(value);
+        addAll(rest...);
+    }
+};
+
+/**
+ * Asynchronous logcat writer.
+ *
+ * LOGD/LOGI/LOGW/LOGE calls below QUFORIA_LOG_LEVEL compile out completely
+ * (their arguments are still type-checked). Enabled calls check the runtime
+ * level, then fill a LogRecord in a bounded lock-free ring (multi-producer,
+ * per-slot sequence numbers); nothing is formatted at the call site. A
+ * background thread formats the records and writes them to logcat, so
+ * logging is cheap under locks and on the frame path. A full ring drops the
+ * record (counted and reported later) instead of blocking.
+ */
+class AsyncLog {
+public:
+    static const int RING_SIZE = 512;  // Power of two
+
+    static bool enabled(int level) {
+        return level >= runtimeLevel_.load(std::memory_order_relaxed);
+    }
+    static void setLevel(int level);
+    static int level() { return runtimeLevel_.load(); }
+
+    template <typename... Args>
+    static void write(int level, const char* tag, const char* format, Args... args) {
+        Slot* slot = claim();
+        if (slot == nullptr) {
+            return;
+        }
+        LogRecord& record = slot->record;
+        record.level = level;
+        record.tag = tag;
+        record.format = format;
+        record.argCount = 0;
+        record.stringsUsed = 0;
+        record.addAll(args...);
+        publish(slot);
+    }
+
+    // Format every pending record now (also done at exit and driver deinit)
+    static void flush();
+    static void getStats(int64_t* written, int64_t* dropped);
+
+    // Compile-time printf checking for the deferred format
+    __attribute__((format(printf, 1, 2))) static void checkFormat(const char*, ...) {}
+
+private:
+    friend struct AsyncLogWriter;
+
+    // Bounded queue slot: sequence == position when free for that position,
+    // position + 1 once published
+    struct Slot {
+        std::atomic<uint64_t> sequence;
+        uint64_t position;
+        LogRecord record;
+    };
+
+    static Slot* claim();
+    static void publish(Slot* slot);
+
+    static std::atomic<int> runtimeLevel_;
+};
+
+#define QUFORIA_LOG(level, ...)                                 \
+    do {                                                        \
+        if (false) AsyncLog::checkFormat(__VA_ARGS__);          \
+        if (AsyncLog::enabled(level)) {                         \
+            AsyncLog::write(level, LOG_TAG, __VA_ARGS__);       \
+        }                                                       \
+    } while (0)
+
+#define QUFORIA_LOG_DISABLED(...)                               \
+    do {                                                        \
+        if (false) AsyncLog::checkFormat(__VA_ARGS__);          \
+    } while (0)
+
+#if QUFORIA_LOG_LEVEL <= QUFORIA_LOG_DEBUG
+#define LOGD(...) QUFORIA_LOG(ANDROID_LOG_DEBUG, __VA_ARGS__)
+#else
+#define LOGD(...) QUFORIA_LOG_DISABLED(__VA_ARGS__)
+#endif
+
+#if QUFORIA_LOG_LEVEL <= QUFORIA_LOG_INFO
+#define LOGI(...) QUFORIA_LOG(ANDROID_LOG_INFO, __VA_ARGS__)
+#else
+#define LOGI(...) QUFORIA_LOG_DISABLED(__VA_ARGS__)
+#endif
+
+#if QUFORIA_LOG_LEVEL <= QUFORIA_LOG_WARN
+#define LOGW(...) QUFORIA_LOG(ANDROID_LOG_WARN, __VA_ARGS__)
+#else
+#define LOGW(...) QUFORIA_LOG_DISABLED(__VA_ARGS__)
+#endif
+
+#if QUFORIA_LOG_LEVEL <= QUFORIA_LOG_ERROR
+#define LOGE(...) QUFORIA_LOG(ANDROID_LOG_ERROR, __VA_ARGS__)
+#else
+#define LOGE(...) QUFORIA_LOG_DISABLED(__VA_ARGS__)
+#endif
+
+#endif // QUEST_QUFORIA_LOG_H
@@ -0,0 +1,180 @@
+#include "scene_change.h"
+#include "frame_converter.h"
+#include "quforia_log.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define QUFORIA_HAS_NEON 1
+#endif
+
+#define LOG_TAG "QUFORIA"
+
+static const int SAMPLES_PER_AXIS = 4;
+
+void computeLumaThumbnail(const uint8_t* buffer, VuforiaDriver::PixelFormat format,
+                          int width, int height, int stride, uint8_t* thumbnail) {
+    const bool planar = isYUV420Format(format);
+    const int bpp = planar ? 1 : bytesPerPixel(format);
+
+    // Sample positions within the frame, shared by every row/column of cells
+    int xs[SCENE_THUMB_WIDTH * SAMPLES_PER_AXIS];
+    int ys[SCENE_THUMB_HEIGHT * SAMPLES_PER_AXIS];
+    for (int i = 0; i < SCENE_THUMB_WIDTH * SAMPLES_PER_AXIS; i++) {
+        xs[i] = std::min(width - 1, (int)((i + 0.5f) * width / (SCENE_THUMB_WIDTH * SAMPLES_PER_AXIS)));
+    }
+    for (int i = 0; i < SCENE_THUMB_HEIGHT * SAMPLES_PER_AXIS; i++) {
+        ys[i] = std::min(height - 1, (int)((i + 0.5f) * height / (SCENE_THUMB_HEIGHT * SAMPLES_PER_AXIS)));
+    }
+
+    for (int ty = 0; ty < SCENE_THUMB_HEIGHT; ty++) {
+        uint32_t sums[SCENE_THUMB_WIDTH] = {0};
+
+        for (int sy = 0; sy < SAMPLES_PER_AXIS; sy++) {
+            const uint8_t* row = buffer + (size_t)ys[ty * SAMPLES_PER_AXIS + sy] * stride;
+            for (int tx = 0; tx < SCENE_THUMB_WIDTH; tx++) {
+                for (int sx = 0; sx < SAMPLES_PER_AXIS; sx++) {
+                    const uint8_t* p = row + xs[tx * SAMPLES_PER_AXIS + sx] * bpp;
+                    // Y plane directly; (R + 2G + B) / 4 for packed RGB
+                    sums[tx] += planar ? p[0] : (p[0] + 2 * p[1] + p[2]) >> 2;
+                }
+            }
+        }
+
+        for (int tx = 0; tx < SCENE_THUMB_WIDTH; tx++) {
+            thumbnail[ty * SCENE_THUMB_WIDTH + tx] =
+                (uint8_t)(sums[tx] / (SAMPLES_PER_AXIS * SAMPLES_PER_AXIS));
+        }
+    }
+}
+
+float thumbnailDifference(const uint8_t* a, const uint8_t* b) {
+    uint32_t total = 0;
+    int i = 0;
+
+#ifdef QUFORIA_HAS_NEON
+    uint32x4_t acc = vdupq_n_u32(0);
+    for (; i + 16 <= SCENE_THUMB_SIZE; i += 16) {
+        uint8x16_t diff = vabdq_u8(vld1q_u8(a + i), vld1q_u8(b + i));
+        acc = vpadalq_u16(acc, vpaddlq_u8(diff));
+    }
+    uint32_t lanes[4];
+    vst1q_u32(lanes, acc);
+    total = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#endif
+
+    for (; i < SCENE_THUMB_SIZE; i++) {
+        total += (uint32_t)std::abs(a[i] - b[i]);
+    }
+    return (float)total / SCENE_THUMB_SIZE;
+}
+
+SceneChangeDetector::SceneChangeDetector()
+    : enabled_(false)
+    , lumaThreshold_(2.0f)
+    , translationThreshold_(0.005f)
+    , rotationThreshold_(0.01f)
+    , floorIntervalNs_(200000000)  // 5fps
+    , hasReference_(false)
+    , referenceHasPose_(false)
+    , lastDeliveredNs_(0)
+    , framesEvaluated_(0)
+    , framesSkipped_(0)
+{
+    memset(referenceThumbnail_, 0, sizeof(referenceThumbnail_));
+    memset(referencePosition_, 0, sizeof(referencePosition_));
+    memset(referenceRotation_, 0, sizeof(referenceRotation_));
+}
+
+void SceneChangeDetector::setConfig(bool enabled, float lumaThreshold, float translationThreshold,
+                                    float rotationThresholdRad, float floorFps) {
+    std::lock_guard<std::mutex> lock(configMutex_);
+
+    if (lumaThreshold >= 0.0f) {
+        lumaThreshold_ = lumaThreshold;
+    }
+    if (translationThreshold >= 0.0f) {
+        translationThreshold_ = translationThreshold;
+    }
+    if (rotationThresholdRad >= 0.0f) {
+        rotationThreshold_ = rotationThresholdRad;
+    }
+    if (floorFps > 0.0f) {
+        floorIntervalNs_ = (int64_t)(1e9f / floorFps);
+    }
+    enabled_ = enabled;
+
+    LOGI("Scene change gating %s (luma=%.1f, translation=%.3f m, rotation=%.3f rad, floor=%.1f fps)",
+         enabled ? "enabled" : "disabled", lumaThreshold_, translationThreshold_,
+         rotationThreshold_, 1e9f / floorIntervalNs_);
+}
+
+bool SceneChangeDetector::shouldDeliver(const uint8_t* thumbnail, const float* position,
+                                        const float* rotation, int64_t nowNs) {
+    float lumaThreshold;
+    float translationThreshold;
+    float rotationThreshold;
+    int64_t floorIntervalNs;
+    {
+        std::lock_guard<std::mutex> lock(configMutex_);
+        lumaThreshold = lumaThreshold_;
+        translationThreshold = translationThreshold_;
+        rotationThreshold = rotationThreshold_;
+        floorIntervalNs = floorIntervalNs_;
+    }
+
+    framesEvaluated_++;
+
+    bool changed = !hasReference_ ||
+                   thumbnailDifference(thumbnail, referenceThumbnail_) > lumaThreshold;
+
+    // Pose delta since the last delivered frame (missing pose counts as motion)
+    const bool hasPose = position != nullptr && rotation != nullptr;
+    if (!changed) {
+        if (!hasPose || !referenceHasPose_) {
+            changed = true;
+        } else {
+            const float dx = position[0] - referencePosition_[0];
+            const float dy = position[1] - referencePosition_[1];
+            const float dz = position[2] - referencePosition_[2];
+            float dot = 0.0f;
+            for (int i = 0; i < 4; i++) {
+                dot += rotation[i] * referenceRotation_[i];
+            }
+            const float angle = 2.0f * std::acos(std::min(1.0f, std::fabs(dot)));
+            changed = std::sqrt(dx * dx + dy * dy + dz * dz) > translationThreshold ||
+                      angle > rotationThreshold;
+        }
+    }
+
+    // Static: hold back until the floor interval has elapsed
+    if (!changed && nowNs - lastDeliveredNs_ < floorIntervalNs) {
+        int64_t skipped = ++framesSkipped_;
+        if (skipped % 100 == 0) {
+            LOGD("Scene static: %lld of %lld frames skipped",
+                 (long long)skipped, (long long)framesEvaluated_.load());
+        }
+        return false;
+    }
+
+    // The reference only moves on real changes, so slow drift still adds up
+    if (changed) {
+        memcpy(referenceThumbnail_, thumbnail, SCENE_THUMB_SIZE);
+        referenceHasPose_ = hasPose;
+        if (hasPose) {
+            memcpy(referencePosition_, position, sizeof(referencePosition_));
+            memcpy(referenceRotation_, rotation, sizeof(referenceRotation_));
+        }
+        hasReference_ = true;
+    }
+    lastDeliveredNs_ = nowNs;
+    return true;
+}
+
+void SceneChangeDetector::getStats(int64_t* evaluated, int64_t* skipped) {
+    if (evaluated) *evaluated = framesEvaluated_.load();
+    if (skipped) *skipped = framesSkipped_.load();
+}
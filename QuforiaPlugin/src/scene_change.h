@@ -0,0 +1,67 @@
+#ifndef QUEST_SCENE_CHANGE_H
+#define QUEST_SCENE_CHANGE_H
+
+#include <VuforiaEngine/Driver/Driver.h>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+// Luma thumbnail used for frame-to-frame change detection
+static const int SCENE_THUMB_WIDTH = 32;
+static const int SCENE_THUMB_HEIGHT = 24;
+static const int SCENE_THUMB_SIZE = SCENE_THUMB_WIDTH * SCENE_THUMB_HEIGHT;
+
+// Downsample a delivered frame to a SCENE_THUMB_WIDTH x SCENE_THUMB_HEIGHT luma
+// thumbnail (each cell averages a 4x4 grid of samples)
+void computeLumaThumbnail(const uint8_t* buffer, VuforiaDriver::PixelFormat format,
+                          int width, int height, int stride, uint8_t* thumbnail);
+
+// Mean absolute difference between two thumbnails (0-255)
+float thumbnailDifference(const uint8_t* a, const uint8_t* b);
+
+/**
+ * Throttles delivery while the headset and the scene are both static.
+ *
+ * A frame counts as unchanged when its thumbnail differs from the last
+ * delivered one by less than the luma threshold and the headset has moved
+ * less than the translation/rotation thresholds since then. Unchanged frames
+ * are delivered at no more than the floor rate; the first changed frame is
+ * delivered immediately, restoring the full camera rate.
+ *
+ * shouldDeliver() is called from the camera delivery thread only.
+ */
+class SceneChangeDetector {
+public:
+    SceneChangeDetector();
+
+    void setConfig(bool enabled, float lumaThreshold, float translationThreshold,
+                   float rotationThresholdRad, float floorFps);
+    bool enabled() const { return enabled_.load(); }
+
+    // position/rotation may be null when no pose is known for the frame
+    bool shouldDeliver(const uint8_t* thumbnail, const float* position,
+                       const float* rotation, int64_t nowNs);
+
+    void getStats(int64_t* evaluated, int64_t* skipped);
+
+private:
+    std::mutex configMutex_;
+    std::atomic<bool> enabled_;
+    float lumaThreshold_;
+    float translationThreshold_;  // meters
+    float rotationThreshold_;     // radians
+    int64_t floorIntervalNs_;
+
+    // Last delivered frame
+    bool hasReference_;
+    uint8_t referenceThumbnail_[SCENE_THUMB_SIZE];
+    bool referenceHasPose_;
+    float referencePosition_[3];
+    float referenceRotation_[4];
+    int64_t lastDeliveredNs_;
+
+    std::atomic<int64_t> framesEvaluated_;
+    std::atomic<int64_t> framesSkipped_;
+};
+
+#endif // QUEST_SCENE_CHANGE_H
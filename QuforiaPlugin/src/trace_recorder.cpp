@@ -0,0 +1,233 @@
+#include "trace_recorder.h"
+#include "quforia_log.h"
+#include <algorithm>
+#include <cstdio>
+#include <mutex>
+#include <unistd.h>
+#include <vector>
+
+#define LOG_TAG "QUFORIA"
+
+std::atomic<uint64_t> TraceRecorder::nextId_(1);
+
+// Recorders still alive, so a thread exiting after its recorder is gone
+// leaves the freed ring alone
+struct RecorderRegistry {
+    std::mutex mutex;
+    std::vector<const TraceRecorder*> live;
+};
+
+static RecorderRegistry& registry() {
+    static RecorderRegistry instance;
+    return instance;
+}
+
+// Ring claimed by the calling thread (for one recorder), given back at exit
+struct ThreadSlotCache {
+    uint64_t recorderId;
+    TraceRecorder::ThreadBuffer* buffer;
+
+    ~ThreadSlotCache() {
+        if (buffer) {
+            TraceRecorder::releaseThreadBuffer(recorderId, buffer);
+        }
+    }
+};
+static thread_local ThreadSlotCache t_slot = {0, nullptr};
+static thread_local const char* t_threadName = nullptr;
+
+TraceRecorder::TraceRecorder()
+    : id_(nextId_.fetch_add(1))
+    , enabled_(false)
+    , captureStartNs_(0)
+    , droppedThreads_(0)
+{
+    for (int i = 0; i < MAX_THREADS; i++) {
+        threads_[i].claimed = false;
+        threads_[i].tid = 0;
+        threads_[i].name = nullptr;
+        threads_[i].events = nullptr;
+        threads_[i].head = 0;
+        threads_[i].first = 0;
+    }
+
+    RecorderRegistry& recorders = registry();
+    std::lock_guard<std::mutex> lock(recorders.mutex);
+    recorders.live.push_back(this);
+}
+
+TraceRecorder::~TraceRecorder() {
+    {
+        RecorderRegistry& recorders = registry();
+        std::lock_guard<std::mutex> lock(recorders.mutex);
+        recorders.live.erase(std::remove(recorders.live.begin(), recorders.live.end(), this),
+                             recorders.live.end());
+    }
+    for (int i = 0; i < MAX_THREADS; i++) {
+        delete[] threads_[i].events.load();
+    }
+}
+
+void TraceRecorder::setEnabled(bool enabled) {
+    if (enabled && !enabled_.load()) {
+        captureStartNs_ = monotonicNowNs();
+    }
+    enabled_ = enabled;
+    LOGI("Trace recording %s", enabled ? "started" : "stopped");
+}
+
+void TraceRecorder::setThreadName(const char* name) {
+    t_threadName = name;
+    if (t_slot.recorderId == id_ && t_slot.buffer) {
+        t_slot.buffer->name = name;
+    }
+}
+
+TraceRecorder::ThreadBuffer* TraceRecorder::threadBuffer() {
+    if (t_slot.recorderId == id_) {
+        return t_slot.buffer;
+    }
+    if (t_slot.buffer) {
+        // Switching recorders: give the other one its ring back
+        releaseThreadBuffer(t_slot.recorderId, t_slot.buffer);
+    }
+
+    // First event from this thread: claim a never-used ring, else one given
+    // back by an exited thread (keeps exited threads in dumps for longer)
+    ThreadBuffer* claimed = nullptr;
+    for (int pass = 0; pass < 2 && !claimed; pass++) {
+        for (int i = 0; i < MAX_THREADS && !claimed; i++) {
+            ThreadBuffer& buffer = threads_[i];
+            bool expected = false;
+            if ((pass == 1 || buffer.tid.load() == 0) &&
+                buffer.claimed.compare_exchange_strong(expected, true)) {
+                claimed = &buffer;
+            }
+        }
+    }
+    if (claimed) {
+        claimed->first = claimed->head.load();
+        claimed->name = t_threadName;
+        claimed->tid.store((int)gettid(), std::memory_order_release);
+    } else {
+        droppedThreads_++;
+    }
+
+    t_slot.recorderId = id_;
+    t_slot.buffer = claimed;
+    return claimed;
+}
+
+void TraceRecorder::releaseThreadBuffer(uint64_t recorderId, ThreadBuffer* buffer) {
+    RecorderRegistry& recorders = registry();
+    std::lock_guard<std::mutex> lock(recorders.mutex);
+    for (const TraceRecorder* recorder : recorders.live) {
+        if (recorder->id_ == recorderId) {
+            buffer->claimed.store(false, std::memory_order_release);
+            return;
+        }
+    }
+}
+
+void TraceRecorder::record(const char* name, char phase, int64_t arg) {
+    if (!enabled_.load(std::memory_order_relaxed)) {
+        return;
+    }
+    ThreadBuffer* buffer = threadBuffer();
+    if (!buffer) {
+        return;
+    }
+
+    // The ring is allocated by its thread on its first event
+    Event* ring = buffer->events.load(std::memory_order_relaxed);
+    if (ring == nullptr) {
+        ring = new Event[EVENTS_PER_THREAD];
+        buffer->events.store(ring, std::memory_order_release);
+    }
+
+    // Single writer per ring: fill the slot, then publish it
+    const uint64_t head = buffer->head.load(std::memory_order_relaxed);
+    Event& event = ring[head % EVENTS_PER_THREAD];
+    event.name = name;
+    event.timestampNs = monotonicNowNs();
+    event.arg = arg;
+    event.phase = phase;
+    buffer->head.store(head + 1, std::memory_order_release);
+}
+
+int TraceRecorder::dump(const char* path) {
+    if (path == nullptr) {
+        LOGE("Trace dump: no path");
+        return -1;
+    }
+    FILE* file = fopen(path, "w");
+    if (file == nullptr) {
+        LOGE("Trace dump: cannot open %s", path);
+        return -1;
+    }
+
+    const int pid = (int)getpid();
+    const int64_t startNs = captureStartNs_.load();
+    std::vector<Event> events;
+    int written = 0;
+
+    fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    fprintf(file, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":0,\"args\":{\"name\":\"Quforia\"}}", pid);
+
+    for (int i = 0; i < MAX_THREADS; i++) {
+        ThreadBuffer& buffer = threads_[i];
+        const int tid = buffer.tid.load();
+        const Event* ring = buffer.events.load(std::memory_order_acquire);
+        if (tid == 0 || ring == nullptr) {
+            continue;
+        }
+
+        // Copy the ring while its thread keeps writing, then drop whatever the
+        // writer may have overwritten during the copy
+        // Events from before the current (or last) owner claimed the ring
+        // belong to an earlier thread and are left out
+        const uint64_t head = buffer.head.load(std::memory_order_acquire);
+        const uint64_t first = std::max(buffer.first.load(),
+            head > (uint64_t)EVENTS_PER_THREAD ? head - EVENTS_PER_THREAD : 0);
+        events.clear();
+        for (uint64_t n = first; n < head; n++) {
+            events.push_back(ring[n % EVENTS_PER_THREAD]);
+        }
+        const uint64_t headAfter = buffer.head.load(std::memory_order_acquire);
+        const uint64_t overwritten = headAfter > (uint64_t)EVENTS_PER_THREAD ?
+            headAfter - EVENTS_PER_THREAD : 0;
+        const size_t skip = (size_t)std::min<uint64_t>(
+            overwritten > first ? overwritten - first : 0, events.size());
+
+        const char* name = buffer.name.load();
+        if (name) {
+            fprintf(file, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                    pid, tid, name);
+        }
+
+        for (size_t e = skip; e < events.size(); e++) {
+            const Event& event = events[e];
+            if (event.timestampNs < startNs) {
+                continue;
+            }
+            fprintf(file, ",\n{\"name\":\"%s\",\"ph\":\"%c\",\"pid\":%d,\"tid\":%d,\"ts\":%.3f",
+                    event.name, event.phase, pid, tid, event.timestampNs / 1000.0);
+            if (event.arg >= 0) {
+                fprintf(file, ",\"args\":{\"value\":%lld}", (long long)event.arg);
+            }
+            fprintf(file, "}");
+            written++;
+        }
+    }
+
+    fprintf(file, "\n]}\n");
+    const bool ok = fclose(file) == 0;
+    if (!ok) {
+        LOGE("Trace dump: write to %s failed", path);
+        return -1;
+    }
+
+    LOGI("Trace dump: %d events written to %s (%lld threads not traced)",
+         written, path, (long long)droppedThreads_.load());
+    return written;
+}
@@ -0,0 +1,97 @@
+#ifndef QUEST_TRACE_RECORDER_H
+#define QUEST_TRACE_RECORDER_H
+
+#include "clock_domain.h"
+#include <atomic>
+#include <cstdint>
+
+/**
+ * Timeline recorder for the native pipeline, dumped as Chrome trace-event
+ * JSON (opens in chrome://tracing and Perfetto).
+ *
+ * Each thread that records claims its own ring of events on its first event
+ * while recording is enabled, so recording never takes a lock: a thread
+ * writes an event into its ring and publishes it by advancing the ring head.
+ * A thread gives its ring back when it exits; the ring keeps its events (and
+ * stays in dumps) until another thread claims it. The dump reads every ring
+ * while recording continues and keeps only events that were not overwritten
+ * during the copy. Rings keep the most recent EVENTS_PER_THREAD events.
+ *
+ * Disabled, a trace point costs one relaxed atomic load. Event names must be
+ * string literals (only the pointer is stored).
+ */
+class TraceRecorder {
+public:
+    static const int MAX_THREADS = 16;
+    static const int EVENTS_PER_THREAD = 16384;
+
+    TraceRecorder();
+    ~TraceRecorder();
+
+    // Enabling starts a new capture (earlier events are left out of dumps)
+    void setEnabled(bool enabled);
+    bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    // Label the calling thread in the timeline (name must be a literal).
+    // Does not claim a ring: the name is attached on the thread's first event
+    void setThreadName(const char* name);
+
+    void begin(const char* name, int64_t arg = -1) { record(name, 'B', arg); }
+    void end(const char* name) { record(name, 'E', -1); }
+
+    // Write the capture to path; returns the number of events written, -1 on error
+    int dump(const char* path);
+
+private:
+    struct Event {
+        const char* name;
+        int64_t timestampNs;
+        int64_t arg;  // Shown as args.value when >= 0
+        char phase;
+    };
+
+    struct ThreadBuffer {
+        std::atomic<bool> claimed;   // Owned by a live thread
+        std::atomic<int> tid;        // Last owner, 0 = never used
+        std::atomic<const char*> name;
+        std::atomic<Event*> events;  // Allocated on the first event ever written
+        std::atomic<uint64_t> head;  // Events ever written
+        std::atomic<uint64_t> first; // head when the last owner claimed the ring
+    };
+
+    friend struct ThreadSlotCache;
+
+    void record(const char* name, char phase, int64_t arg);
+    ThreadBuffer* threadBuffer();
+
+    // Thread exit: hand the ring back if its recorder still exists
+    static void releaseThreadBuffer(uint64_t recorderId, ThreadBuffer* buffer);
+
+    static std::atomic<uint64_t> nextId_;
+    const uint64_t id_;  // Tells recorders apart in the thread-local cache
+
+    std::atomic<bool> enabled_;
+    std::atomic<int64_t> captureStartNs_;
+    ThreadBuffer threads_[MAX_THREADS];
+    std::atomic<int64_t> droppedThreads_;
+};
+
+/**
+ * Begin/end pair around the enclosing scope.
+ */
+class TraceScope {
+public:
+    TraceScope(TraceRecorder& recorder, const char* name, int64_t arg = -1)
+        : recorder_(recorder.enabled() ? &recorder : nullptr), name_(name) {
+        if (recorder_) recorder_->begin(name_, arg);
+    }
+    ~TraceScope() {
+        if (recorder_) recorder_->end(name_);
+    }
+
+private:
+    TraceRecorder* recorder_;
+    const char* name_;
+};
+
+#endif // QUEST_TRACE_RECORDER_H
@@ -0,0 +1,225 @@
+#include "undistortion.h"
+#include "quforia_log.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define QUFORIA_HAS_NEON 1
+#endif
+
+#define LOG_TAG "QUFORIA"
+
+static const int WEIGHT_BITS = 7;
+static const int WEIGHT_ONE = 1 << WEIGHT_BITS;
+
+// Fill for pixels that map outside the source: black, opaque for 4 bpp
+// (alpha is the last byte of the pixel, the top byte of a little-endian word)
+static const uint32_t OPAQUE_BLACK = 0xFF000000u;
+
+static bool hasDistortion(const VuforiaDriver::CameraIntrinsics& intrinsics) {
+    for (int i = 0; i < 8; i++) {
+        if (intrinsics.distortionCoefficients[i] != 0.0f) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool sameIntrinsics(const VuforiaDriver::CameraIntrinsics& a,
+                           const VuforiaDriver::CameraIntrinsics& b) {
+    return memcmp(&a, &b, sizeof(VuforiaDriver::CameraIntrinsics)) == 0;
+}
+
+UndistortionMap::UndistortionMap()
+    : width_(0)
+    , height_(0)
+    , bpp_(0)
+    , srcStride_(0)
+    , flip_(false)
+    , active_(false)
+    , rebuildCount_(0)
+{
+}
+
+bool UndistortionMap::configure(const VuforiaDriver::CameraIntrinsics& intrinsics,
+                                int width, int height, int bpp, int srcStride,
+                                bool flipVertically) {
+    if (!hasDistortion(intrinsics) || intrinsics.focalLengthX <= 0.0f ||
+        intrinsics.focalLengthY <= 0.0f || width < 2 || height < 2) {
+        active_ = false;
+        return false;
+    }
+
+    if (active_ && width == width_ && height == height_ && bpp == bpp_ &&
+        srcStride == srcStride_ && flipVertically == flip_ &&
+        sameIntrinsics(intrinsics, intrinsics_)) {
+        return true;
+    }
+
+    intrinsics_ = intrinsics;
+    width_ = width;
+    height_ = height;
+    bpp_ = bpp;
+    srcStride_ = srcStride;
+    flip_ = flipVertically;
+    rebuild();
+    active_ = true;
+    return true;
+}
+
+void UndistortionMap::rebuild() {
+    const float fx = intrinsics_.focalLengthX;
+    const float fy = intrinsics_.focalLengthY;
+    const float cx = intrinsics_.principalPointX;
+    const float cy = intrinsics_.principalPointY;
+    const float* d = intrinsics_.distortionCoefficients;
+    const float k1 = d[0], k2 = d[1], p1 = d[2], p2 = d[3];
+    const float k3 = d[4], k4 = d[5], k5 = d[6], k6 = d[7];
+
+    table_.resize((size_t)width_ * height_);
+
+    for (int v = 0; v < height_; v++) {
+        const float y = (v - cy) / fy;
+        for (int u = 0; u < width_; u++) {
+            const float x = (u - cx) / fx;
+
+            // Project the ideal ray through the lens model
+            const float r2 = x * x + y * y;
+            const float r4 = r2 * r2;
+            const float r6 = r4 * r2;
+            const float radial = (1.0f + k1 * r2 + k2 * r4 + k3 * r6) /
+                                 (1.0f + k4 * r2 + k5 * r4 + k6 * r6);
+            const float xd = x * radial + 2.0f * p1 * x * y + p2 * (r2 + 2.0f * x * x);
+            const float yd = y * radial + p1 * (r2 + 2.0f * y * y) + 2.0f * p2 * x * y;
+
+            float su = fx * xd + cx;
+            float sv = fy * yd + cy;
+
+            Entry& e = table_[(size_t)v * width_ + u];
+            e.reserved = 0;
+
+            // Anything within half a pixel of the border still samples the edge
+            if (!(su >= -0.5f && sv >= -0.5f && su <= width_ - 0.5f && sv <= height_ - 0.5f)) {
+                e.offset = -1;
+                e.wx = 0;
+                e.wy = 0;
+                continue;
+            }
+            su = std::max(0.0f, std::min(su, (float)(width_ - 1)));
+            sv = std::max(0.0f, std::min(sv, (float)(height_ - 1)));
+
+            // Keep the 2x2 footprint inside the image on the last row/column
+            int x0 = std::min((int)su, width_ - 2);
+            int y0 = std::min((int)sv, height_ - 2);
+            int wx = (int)std::lround((su - x0) * WEIGHT_ONE);
+            int wy = (int)std::lround((sv - y0) * WEIGHT_ONE);
+
+            const int row = flip_ ? (height_ - 1 - y0) : y0;
+            e.offset = row * srcStride_ + x0 * bpp_;
+            e.wx = (uint8_t)std::min(wx, WEIGHT_ONE);
+            e.wy = (uint8_t)std::min(wy, WEIGHT_ONE);
+        }
+    }
+
+    rebuildCount_++;
+    LOGI("Undistortion map rebuilt: %dx%d, bpp=%d (rebuild #%d)",
+         width_, height_, bpp_, rebuildCount_);
+}
+
+static inline uint8_t blendTap(int t00, int t01, int t10, int t11, int wx, int wy) {
+    const int top = t00 * (WEIGHT_ONE - wx) + t01 * wx;
+    const int bottom = t10 * (WEIGHT_ONE - wx) + t11 * wx;
+    const int half = 1 << (2 * WEIGHT_BITS - 1);
+    return (uint8_t)((top * (WEIGHT_ONE - wy) + bottom * wy + half) >> (2 * WEIGHT_BITS));
+}
+
+void UndistortionMap::apply(const uint8_t* src, uint8_t* dst, int dstStride) const {
+    if (!active_) {
+        return;
+    }
+
+    const int rowStep = flip_ ? -srcStride_ : srcStride_;
+    const int bpp = bpp_;
+
+    for (int v = 0; v < height_; v++) {
+        const Entry* e = &table_[(size_t)v * width_];
+        uint8_t* d = dst + (size_t)v * dstStride;
+        int u = 0;
+
+#ifdef QUFORIA_HAS_NEON
+        if (bpp == 4) {
+            // 4 pixels per iteration: gather the 4 taps as 32-bit words, then
+            // blend all 16 channel bytes at once
+            for (; u + 4 <= width_; u += 4) {
+                uint32_t t00[4], t01[4], t10[4], t11[4], wx[4], wy[4];
+                for (int i = 0; i < 4; i++) {
+                    const Entry& entry = e[u + i];
+                    if (entry.offset < 0) {
+                        t00[i] = t01[i] = t10[i] = t11[i] = OPAQUE_BLACK;
+                        wx[i] = wy[i] = 0;
+                        continue;
+                    }
+                    const uint8_t* p = src + entry.offset;
+                    memcpy(&t00[i], p, 4);
+                    memcpy(&t01[i], p + 4, 4);
+                    memcpy(&t10[i], p + rowStep, 4);
+                    memcpy(&t11[i], p + rowStep + 4, 4);
+                    wx[i] = entry.wx * 0x01010101u;
+                    wy[i] = entry.wy * 0x01010101u;
+                }
+
+                const uint8x16_t wxv = vreinterpretq_u8_u32(vld1q_u32(wx));
+                const uint8x16_t wyv = vreinterpretq_u8_u32(vld1q_u32(wy));
+                const uint8x16_t one = vdupq_n_u8(WEIGHT_ONE);
+                const uint8x16_t iwx = vsubq_u8(one, wxv);
+                const uint8x16_t iwy = vsubq_u8(one, wyv);
+
+                const uint8x16_t a = vreinterpretq_u8_u32(vld1q_u32(t00));
+                const uint8x16_t b = vreinterpretq_u8_u32(vld1q_u32(t01));
+                const uint8x16_t c = vreinterpretq_u8_u32(vld1q_u32(t10));
+                const uint8x16_t dd = vreinterpretq_u8_u32(vld1q_u32(t11));
+
+                // Horizontal blend of top and bottom rows
+                uint8x16_t top = vcombine_u8(
+                    vrshrn_n_u16(vmlal_u8(vmull_u8(vget_low_u8(a), vget_low_u8(iwx)),
+                                          vget_low_u8(b), vget_low_u8(wxv)), WEIGHT_BITS),
+                    vrshrn_n_u16(vmlal_u8(vmull_u8(vget_high_u8(a), vget_high_u8(iwx)),
+                                          vget_high_u8(b), vget_high_u8(wxv)), WEIGHT_BITS));
+                uint8x16_t bottom = vcombine_u8(
+                    vrshrn_n_u16(vmlal_u8(vmull_u8(vget_low_u8(c), vget_low_u8(iwx)),
+                                          vget_low_u8(dd), vget_low_u8(wxv)), WEIGHT_BITS),
+                    vrshrn_n_u16(vmlal_u8(vmull_u8(vget_high_u8(c), vget_high_u8(iwx)),
+                                          vget_high_u8(dd), vget_high_u8(wxv)), WEIGHT_BITS));
+
+                // Vertical blend
+                uint8x16_t out = vcombine_u8(
+                    vrshrn_n_u16(vmlal_u8(vmull_u8(vget_low_u8(top), vget_low_u8(iwy)),
+                                          vget_low_u8(bottom), vget_low_u8(wyv)), WEIGHT_BITS),
+                    vrshrn_n_u16(vmlal_u8(vmull_u8(vget_high_u8(top), vget_high_u8(iwy)),
+                                          vget_high_u8(bottom), vget_high_u8(wyv)), WEIGHT_BITS));
+
+                vst1q_u8(d + u * 4, out);
+            }
+        }
+#endif
+
+        for (; u < width_; u++) {
+            const Entry& entry = e[u];
+            uint8_t* out = d + u * bpp;
+            if (entry.offset < 0) {
+                memset(out, 0, bpp);
+                if (bpp == 4) {
+                    out[3] = 0xFF;
+                }
+                continue;
+            }
+            const uint8_t* p = src + entry.offset;
+            for (int ch = 0; ch < bpp; ch++) {
+                out[ch] = blendTap(p[ch], p[bpp + ch], p[rowStep + ch], p[rowStep + bpp + ch],
+                                   entry.wx, entry.wy);
+            }
+        }
+    }
+}
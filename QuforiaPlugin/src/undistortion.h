@@ -0,0 +1,59 @@
+#ifndef QUEST_UNDISTORTION_H
+#define QUEST_UNDISTORTION_H
+
+#include <VuforiaEngine/Driver/Driver.h>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Lens undistortion via a precomputed fixed-point remap table.
+ *
+ * The table maps every rectified output pixel to its bilinear source taps in
+ * the distorted image (OpenCV rational model: k1, k2, p1, p2, k3, k4, k5, k6,
+ * the same order as CameraIntrinsics::distortionCoefficients). It is rebuilt
+ * only when the geometry or intrinsics change, so the per-frame cost is a
+ * fixed table-driven gather + blend over packed RGB888/RGBA8888 pixels.
+ *
+ * The rectified image keeps fx, fy, cx, cy; only the distortion is removed.
+ * Output pixels that map outside the source are filled with black.
+ *
+ * Not thread-safe: one instance per ingestion thread.
+ */
+class UndistortionMap {
+public:
+    UndistortionMap();
+
+    // Prepare the table for the given source layout. Returns false (and leaves
+    // the map inactive) when the intrinsics carry no distortion.
+    bool configure(const VuforiaDriver::CameraIntrinsics& intrinsics,
+                   int width, int height, int bpp, int srcStride, bool flipVertically);
+
+    // Remap src (layout passed to configure) into a tightly packed dst
+    void apply(const uint8_t* src, uint8_t* dst, int dstStride) const;
+
+    // Number of table rebuilds since creation
+    int rebuildCount() const { return rebuildCount_; }
+
+private:
+    struct Entry {
+        int32_t offset;  // Byte offset of the top-left tap, -1 if outside the source
+        uint8_t wx;      // 7-bit horizontal weight of the right taps
+        uint8_t wy;      // 7-bit vertical weight of the bottom taps
+        uint16_t reserved;
+    };
+
+    void rebuild();
+
+    VuforiaDriver::CameraIntrinsics intrinsics_;
+    int width_;
+    int height_;
+    int bpp_;
+    int srcStride_;
+    bool flip_;
+    bool active_;
+    int rebuildCount_;
+
+    std::vector<Entry> table_;
+};
+
+#endif // QUEST_UNDISTORTION_H
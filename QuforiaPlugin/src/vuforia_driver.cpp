@@ -1,17 +1,24 @@
 #include "vuforia_driver.h"
 #include "external_camera.h"
 #include "external_tracker.h"
-#include <android/log.h>
+#include "frame_converter.h"
+#include "coordinate_transform.h"
+#include "quforia_log.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <cstring>
 
 #define LOG_TAG "QUFORIA"
-#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
-#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
-#define LOGD(...) __android_log_print(ANDROID_LOG_DEBUG, LOG_TAG, __VA_ARGS__)
 
 // Global driver instance
 QuestVuforiaDriver* g_driverInstance = nullptr;
 
+static int64_t steadyNowNs() {
+    // Same clock as the stamped frame and pose timestamps
+    return monotonicNowNs();
+}
+
 // =============================================================================
 // Entry Point Functions (C linkage - required by Vuforia Driver Framework)
 // =============================================================================
@@ -54,6 +61,9 @@ JNIEXPORT void JNICALL vuforiaDriver_deinit(VuforiaDriver::Driver* driver) {
     } else {
         LOGE("Driver mismatch");
     }
+
+    // The library may be unloaded without a normal exit: write out what is queued
+    AsyncLog::flush();
 }
 
 JNIEXPORT uint32_t JNICALL vuforiaDriver_getAPIVersion() {
@@ -74,22 +84,146 @@ JNIEXPORT uint32_t JNICALL vuforiaDriver_getLibraryVersion(char* versionString,
 
 } // extern "C"
 
+// =============================================================================
+// Frame Slot Pool
+// =============================================================================
+
+FrameSlotPool::FrameSlotPool(size_t maxSlots)
+    : allocated_(0)
+    , maxSlots_(maxSlots)
+{
+    free_.reserve(maxSlots);
+}
+
+FrameSlotPool::~FrameSlotPool() {
+    // Only reached once every slot is back (each one holds the pool)
+    for (CameraFrameData* slot : free_) {
+        delete slot;
+    }
+}
+
+std::shared_ptr<CameraFrameData> FrameSlotPool::acquire() {
+    CameraFrameData* slot = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!free_.empty()) {
+            slot = free_.back();
+            free_.pop_back();
+        } else if (allocated_ < maxSlots_) {
+            allocated_++;
+        } else {
+            return nullptr;
+        }
+    }
+
+    if (slot == nullptr) {
+        slot = new CameraFrameData();
+    }
+    std::shared_ptr<FrameSlotPool> pool = shared_from_this();
+    return std::shared_ptr<CameraFrameData>(slot, [pool](CameraFrameData* released) {
+        pool->release(released);
+    });
+}
+
+void FrameSlotPool::release(CameraFrameData* slot) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    free_.push_back(slot);
+}
+
 // =============================================================================
 // QuestVuforiaDriver Implementation
 // =============================================================================
 
+const size_t QuestVuforiaDriver::MAX_FRAME_POOL_SIZE;
+
 QuestVuforiaDriver::QuestVuforiaDriver(VuforiaDriver::PlatformData* platformData,
                                        void* userData)
     : camera_(nullptr)
     , tracker_(nullptr)
-    , intrinsicsSet_(false)
+    , frameSelectionEnabled_(false)
+    , selectionWindowNs_(50000000)  // 50ms
+    , lastSelectedTimestamp_(0)
+    , selectedOlderCount_(0)
+    , selectionCount_(0)
+    , stereoPolicy_((int32_t)StereoPolicy::ACTIVE_CAMERA)
+    , bestCamera_(0)
+    , lastPickedCamera_(0)
+    , lastPickedTimestamp_(0)
+    , cameraSwitches_(0)
+    , framePool_(std::make_shared<FrameSlotPool>(MAX_FRAME_POOL_SIZE))
+    , poseToleranceNs_(50000000)  // 50ms
+    , predictionEnabled_(false)
+    , predictionModel_((int32_t)PredictionModel::CONSTANT_VELOCITY)
+    , maxPredictionNs_(50000000)         // 50ms
+    , unreliablePredictionNs_(20000000)  // 20ms
+    , poseLookups_(0)
+    , posePredictions_(0)
+    , predictionHorizonTotalNs_(0)
+    , predictionHorizonMaxNs_(0)
+    , poseJoinEnabled_(false)
+    , poseJoinTimeoutNs_(5000000)  // 5ms
+    , poseDeliveryActive_(false)
+    , frameSequence_(0)
+    , lastDeliveredPoseTimestamp_(0)
+    , poseJoins_(0)
+    , poseJoinWaits_(0)
+    , poseJoinTimeouts_(0)
+    , poseJoinWaitTotalNs_(0)
+    , poseOrderTimeouts_(0)
+    , activeCamera_(0)
+    , poseValidationEnabled_(false)
+    , minPoseConfidence_(0.5f)
+    , maxPoseGapNs_(20000000)        // 20ms
+    , poseJumpDistance_(0.1f)        // 10cm between consecutive samples
+    , poseJumpAngle_(0.35f)          // ~20 deg between consecutive samples
+    , excessiveAngularVelocity_(6.0f)  // ~340 deg/s
+    , poseSettleNs_(500000000)       // 500ms
+    , poseValidationReset_(false)
+    , posesClassified_(0)
+    , posesUnreliable_(0)
+    , posesInitializing_(0)
+    , posesRelocalizing_(0)
+    , posesExcessiveMotion_(0)
+    , relocalizationCount_(0)
+    , confidentSinceNs_(-1)
+    , lastJumpNs_(-1)
+    , trackingSettled_(false)
+    , lastFrameAgeNs_(0)
+    , poseStreamingEnabled_(false)
+    , motionSkipEnabled_(false)
+    , maxAngularVelocity_(3.0f)  // ~170 deg/s
+    , maxLinearVelocity_(1.0f)
+    , maxConsecutiveSkips_(5)
+    , consecutiveMotionSkips_(0)
+    , motionFramesEvaluated_(0)
+    , motionFramesSkipped_(0)
+    , brightnessGateEnabled_(false)
+    , minMeanLuma_(20)
+    , lowLightState_(false)
+    , lowLightFrameCount_(0)
+    , grayscaleOnly_(false)
+    , undistortEnabled_(false)
+    , ingestTimeNs_(0)
+    , ingestAgeNs_(0)
+    , ingestFrameCount_(0)
+    , normalizedFrameCount_(0)
+    , trackingStatus_(TrackingStatus::SEARCHING)
+    , searchStartNs_(steadyNowNs())
 {
     (void)platformData;  // Unused parameter (provided by Vuforia for Android JNI access if needed)
     (void)userData;      // Unused parameter
     LOGI("QuestVuforiaDriver constructor");
 
-    // Initialize cached intrinsics with default values
-    memset(&cachedIntrinsics_, 0, sizeof(cachedIntrinsics_));
+    for (int i = 0; i < MAX_RIG_CAMERAS; i++) {
+        cameraScores_[i] = 0.0f;
+        cameraPicks_[i] = 0;
+    }
+
+    // Until a camera mode is selected, deliver RGB888 at source size
+    outputMode_.width = 0;
+    outputMode_.height = 0;
+    outputMode_.fps = 30;
+    outputMode_.format = VuforiaDriver::PixelFormat::RGB888;
 }
 
 QuestVuforiaDriver::~QuestVuforiaDriver() {
@@ -105,17 +239,12 @@ QuestVuforiaDriver::~QuestVuforiaDriver() {
         tracker_ = nullptr;
     }
 
-    // Clear frame queue
+    // Clear frame queue (its slots go back to the pool)
     std::lock_guard<std::mutex> frameLock(frameMutex_);
-    while (!frameQueue_.empty()) {
-        frameQueue_.pop();
-    }
+    frameQueue_.clear();
 
-    // Clear pose queue
-    std::lock_guard<std::mutex> poseLock(poseMutex_);
-    while (!poseQueue_.empty()) {
-        poseQueue_.pop();
-    }
+    // Clear pose history
+    poseRing_.clear();
 }
 
 uint32_t QuestVuforiaDriver::getCapabilities() {
@@ -196,164 +325,1260 @@ void QuestVuforiaDriver::destroyExternalPositionalDeviceTracker(
 // =============================================================================
 
 void QuestVuforiaDriver::feedCameraFrame(const uint8_t* imageData, int width, int height,
-                                        const float* intrinsics, int64_t timestamp) {
-    std::lock_guard<std::mutex> lock(frameMutex_);
+                                        VuforiaDriver::PixelFormat sourceFormat, bool flipVertically,
+                                        const float* intrinsics, int64_t timestamp,
+                                        int cameraId) {
+    auto ingestStart = std::chrono::steady_clock::now();
+    timestamp = clock_.stamp(timestamp);
+    const int64_t frameAgeNs = steadyNowNs() - timestamp;
+    if (trace_.enabled()) {
+        trace_.setThreadName("Frame feed");
+    }
+    TraceScope trace(trace_, "feedCameraFrame", timestamp);
+
+    if (cameraId < 0) {
+        cameraId = activeCamera_.load();
+    } else if (cameraId >= MAX_RIG_CAMERAS) {
+        LOGE("feedCameraFrame: invalid camera %d", cameraId);
+        return;
+    }
+    pipelineStats_.countFrameFed();
+    pipelineStats_.record(PipelineStage::UNITY_SUBMIT, frameAgeNs);
+
+    VuforiaDriver::CameraMode mode;
+    CropWindow crop;
+    {
+        std::lock_guard<std::mutex> modeLock(modeMutex_);
+        mode = outputMode_;
+        crop = cropWindow_;
+    }
 
-    // Create new frame data
-    auto frameData = std::make_shared<CameraFrameData>();
-    frameData->width = width;
-    frameData->height = height;
+    const VuforiaDriver::PixelFormat format = mode.format;
+    const int srcBpp = bytesPerPixel(sourceFormat);
+    const int srcStride = width * srcBpp;
+
+    // Crop window in source pixels (even-aligned for 4:2:0 output). Rows are
+    // counted top-down in the delivered (post-flip) image.
+    int cropX = 0;
+    int cropY = 0;
+    int cropWidth = width;
+    int cropHeight = height;
+    if (crop.enabled) {
+        cropX = (int)(crop.x * width) & ~1;
+        cropY = (int)(crop.y * height) & ~1;
+        cropWidth = std::max(2, std::min((int)(crop.width * width), width - cropX) & ~1);
+        cropHeight = std::max(2, std::min((int)(crop.height * height), height - cropY) & ~1);
+    }
+
+    // Output size: the mode size, shrunk to the cropped fraction unless the
+    // crop is upscaled back to the full mode size
+    int outWidth = mode.width ? (int)mode.width : width;
+    int outHeight = mode.height ? (int)mode.height : height;
+    if (crop.enabled && !crop.upscale) {
+        outWidth = std::max(2, (int)((int64_t)outWidth * cropWidth / width) & ~1);
+        outHeight = std::max(2, (int)((int64_t)outHeight * cropHeight / height) & ~1);
+    }
+
+    // Reduce below the mode size while a target is locked (kept even for 4:2:0)
+    const float outputScale = adaptiveResolution_.selectScale(steadyNowNs());
+    if (outputScale < 1.0f) {
+        outWidth = std::max(2, (int)(outWidth * outputScale) & ~1);
+        outHeight = std::max(2, (int)(outHeight * outputScale) & ~1);
+    }
+    const bool grayscaleOnly = grayscaleOnly_.load() && isYUV420Format(format);
+    const uint32_t bufferSize = frameBufferSize(format, outWidth, outHeight);
+
+    // Reuse a free slot; chroma stays valid only if the layout is unchanged
+    auto frameData = acquireFrameSlot(bufferSize);
+    const bool sameLayout = frameData->format == format &&
+                            frameData->width == outWidth && frameData->height == outHeight;
+    if (!sameLayout) {
+        frameData->neutralChroma = false;
+    }
+
+    frameData->width = outWidth;
+    frameData->height = outHeight;
+    frameData->format = format;
+    frameData->stride = frameStride(format, outWidth);
+    frameData->bufferSize = bufferSize;
     frameData->timestamp = timestamp;
 
-    // Copy image data
-    int dataSize = width * height * 3;  // RGB888
-    frameData->imageData = new uint8_t[dataSize];
-    memcpy(frameData->imageData, imageData, dataSize);
+    // Intrinsics: source-size values, principal point shifted into the crop
+    // window, then rescaled to the output size
+    VuforiaDriver::CameraIntrinsics frameIntrinsics = sourceIntrinsics(intrinsics, cameraId, width, height);
+    frameIntrinsics.principalPointX -= cropX;
+    frameIntrinsics.principalPointY -= cropY;
+    frameIntrinsics = scaleIntrinsics(frameIntrinsics, cropWidth, cropHeight, outWidth, outHeight);
+
+    // Work is done outside frameMutex_ so the delivery threads are never
+    // blocked behind a full-frame pass.
+    // Point at the crop origin; with a flip the window's first delivered row
+    // is the physical row (height - 1 - cropY), so start from its bottom edge.
+    const int cropRow = flipVertically ? (height - cropY - cropHeight) : cropY;
+    const uint8_t* pixels = imageData + (size_t)cropRow * srcStride + (size_t)cropX * srcBpp;
+    int pixelsStride = srcStride;
+    bool flip = flipVertically;
+
+    // Stages run on packed pixels at the output size; whichever stage runs
+    // last writes straight into the slot when no format conversion is needed
+    const bool needsScale = outWidth != cropWidth || outHeight != cropHeight;
+    const bool needsUndistort = undistortEnabled_.load() &&
+        undistortion_[cameraId].configure(frameIntrinsics, outWidth, outHeight, srcBpp,
+                                needsScale ? outWidth * srcBpp : pixelsStride,
+                                needsScale ? false : flipVertically);
+    const bool sameFormat = sourceFormat == format;
+
+    // 1. Crop/downscale (flip folded into the scaler)
+    if (needsScale) {
+        uint8_t* dst;
+        int dstStride;
+        if (sameFormat && !needsUndistort) {
+            dst = frameData->imageData;
+            dstStride = frameData->stride;
+        } else {
+            scaleBuffer_.resize((size_t)outWidth * outHeight * srcBpp);
+            dst = scaleBuffer_.data();
+            dstStride = outWidth * srcBpp;
+        }
+        scaler_.scale(pixels, pixelsStride, cropWidth, cropHeight,
+                      dst, dstStride, outWidth, outHeight, srcBpp, flip);
+        pixels = dst;
+        pixelsStride = dstStride;
+        flip = false;
+    }
+
+    // 2. Lens undistortion (table built once per mode/intrinsics change)
+    if (needsUndistort) {
+        uint8_t* dst;
+        int dstStride;
+        if (sameFormat) {
+            dst = frameData->imageData;
+            dstStride = frameData->stride;
+        } else {
+            remapBuffer_.resize((size_t)outWidth * outHeight * srcBpp);
+            dst = remapBuffer_.data();
+            dstStride = outWidth * srcBpp;
+        }
+        undistortion_[cameraId].apply(pixels, dst, dstStride);
+        pixels = dst;
+        pixelsStride = dstStride;
+        flip = false;
+
+        // Delivered image is rectified
+        memset(frameIntrinsics.distortionCoefficients, 0,
+               sizeof(frameIntrinsics.distortionCoefficients));
+    }
 
-    // Set intrinsics (use cached if available, otherwise from parameter)
+    // 3. Convert into the output format
+    if (pixels != frameData->imageData &&
+        !convertFrame(pixels, pixelsStride, sourceFormat, frameData->imageData, format,
+                      outWidth, outHeight, flip, grayscaleOnly)) {
+        LOGE("Unsupported conversion: format %d -> %d", (int)sourceFormat, (int)format);
+        return;
+    }
+
+    // Grayscale: chroma planes are written once per slot, then reused as-is
+    if (grayscaleOnly) {
+        if (!frameData->neutralChroma) {
+            fillNeutralChroma(frameData->imageData, outWidth, outHeight);
+            frameData->neutralChroma = true;
+        }
+    } else {
+        frameData->neutralChroma = false;
+    }
+
+    // 4. Brightness gate on the captured (pre-normalization) image, with a
+    //    small hysteresis so frames near the threshold don't flicker
+    frameData->meanLuma = -1.0f;
+    frameData->lowLight = false;
+    if (brightnessGateEnabled_.load()) {
+        const int threshold = minMeanLuma_.load();
+        frameData->meanLuma = quality_.computeMeanLuma(frameData->imageData, format,
+                                                       outWidth, outHeight, frameData->stride);
+        const bool lowLight = frameData->meanLuma <
+            (float)(lowLightState_ ? threshold + LOW_LIGHT_HYSTERESIS : threshold);
+        if (lowLight != lowLightState_) {
+            LOGI("Brightness gate: %s (mean luma %.1f, threshold %d)",
+                 lowLight ? "insufficient light, withholding frames" : "light restored",
+                 frameData->meanLuma, threshold);
+            lowLightState_ = lowLight;
+        }
+        frameData->lowLight = lowLight;
+        if (lowLight) {
+            lowLightFrameCount_++;
+        }
+    } else {
+        lowLightState_ = false;
+    }
+
+    // 5. Low-light normalization (in place, dim frames only)
+    if (normalizer_.process(frameData->imageData, format, outWidth, outHeight,
+                            frameData->stride)) {
+        normalizedFrameCount_++;
+    }
+
+    // 6. Sharpness score for best-of-N selection
+    frameData->sharpness = frameSelectionEnabled_.load() ?
+        quality_.computeSharpness(frameData->imageData, format, outWidth, outHeight,
+                                  frameData->stride) : 0.0f;
+
+    // 7. Change-detection thumbnail (what Vuforia will see, after normalization)
+    frameData->hasThumbnail = sceneChange_.enabled();
+    if (frameData->hasThumbnail) {
+        computeLumaThumbnail(frameData->imageData, format, outWidth, outHeight,
+                             frameData->stride, frameData->thumbnail);
+    }
+
+    frameData->intrinsics = frameIntrinsics;
+    frameData->cameraId = cameraId;
+
+    auto ingestEnd = std::chrono::steady_clock::now();
+    pipelineStats_.record(PipelineStage::CONVERT, std::chrono::duration_cast<std::chrono::nanoseconds>(
+        ingestEnd - ingestStart).count());
+
+    std::lock_guard<std::mutex> lock(frameMutex_);
+
+    // Add to queue
+    frameData->enqueuedNs = steadyNowNs();
+    frameQueue_.push_back(frameData);
+
+    // Keep only last N frames
+    while (frameQueue_.size() > MAX_FRAME_QUEUE_SIZE) {
+        frameQueue_.pop_front();
+    }
+
+    // Track ingestion cost per output format
+    ingestTimeNs_ += std::chrono::duration_cast<std::chrono::nanoseconds>(
+        ingestEnd - ingestStart).count();
+    ingestAgeNs_ += frameAgeNs;
+    ingestFrameCount_++;
+    if (ingestFrameCount_ % 30 == 0) {
+        LOGD("Ingest cost (%dx%d crop %dx%d format=%d -> %dx%d format=%d): avg %.3f ms, frame age %.3f ms over %d frames (%d normalized, %lld gated for low light total)",
+             width, height, cropWidth, cropHeight, (int)sourceFormat,
+             outWidth, outHeight, (int)format,
+             ingestTimeNs_ / 1e6 / ingestFrameCount_, ingestAgeNs_ / 1e6 / ingestFrameCount_,
+             ingestFrameCount_, normalizedFrameCount_, (long long)lowLightFrameCount_);
+        lastFrameAgeNs_ = ingestAgeNs_ / ingestFrameCount_;
+        ingestTimeNs_ = 0;
+        ingestAgeNs_ = 0;
+        ingestFrameCount_ = 0;
+        normalizedFrameCount_ = 0;
+    }
+
+    LOGD("Frame fed: %dx%d, camera=%d, timestamp=%lld, queue_size=%zu",
+         width, height, cameraId, (long long)timestamp, frameQueue_.size());
+
+    // Wake the tracker (join: pose for this frame; streaming: horizon moved)
+    frameSequence_++;
+    if (poseJoinEnabled_.load() || poseStreamingEnabled_.load()) {
+        notifyJoinWaiters();
+    }
+}
+
+VuforiaDriver::CameraIntrinsics QuestVuforiaDriver::sourceIntrinsics(const float* intrinsics,
+                                                                    int cameraId,
+                                                                    int width, int height) {
+    // Use the camera's cached intrinsics if available, otherwise the per-frame parameter.
     // Note: Intrinsics array format from Unity: [width, height, fx, fy, cx, cy, d0-d7]
-    // Width/height are in indices 0-1 (ignored here, used from frame dimensions)
+    // Width/height (indices 0-1) are the calibration resolution; values are
+    // rescaled to the source frame size. 0x0 means calibrated at the source size.
     // Focal lengths and principal point in indices 2-5
     // Distortion coefficients in indices 6-13
+    VuforiaDriver::CameraIntrinsics raw;
+    int calibWidth = width;
+    int calibHeight = height;
     {
         std::lock_guard<std::mutex> intrinsicsLock(intrinsicsMutex_);
-        if (intrinsicsSet_) {
-            frameData->intrinsics = cachedIntrinsics_;
+        const CameraCalibration& calibration = calibration_[cameraId];
+        if (calibration.valid) {
+            raw = calibration.intrinsics;
+            if (calibration.width > 0 && calibration.height > 0) {
+                calibWidth = calibration.width;
+                calibHeight = calibration.height;
+            }
         } else if (intrinsics != nullptr) {
-            frameData->intrinsics.focalLengthX = intrinsics[2];
-            frameData->intrinsics.focalLengthY = intrinsics[3];
-            frameData->intrinsics.principalPointX = intrinsics[4];
-            frameData->intrinsics.principalPointY = intrinsics[5];
+            raw.focalLengthX = intrinsics[2];
+            raw.focalLengthY = intrinsics[3];
+            raw.principalPointX = intrinsics[4];
+            raw.principalPointY = intrinsics[5];
             // Distortion coefficients (8 values starting at index 6)
             for (int i = 0; i < 8; i++) {
-                frameData->intrinsics.distortionCoefficients[i] = intrinsics[i + 6];
+                raw.distortionCoefficients[i] = intrinsics[i + 6];
+            }
+            if (intrinsics[0] > 0.0f && intrinsics[1] > 0.0f) {
+                calibWidth = (int)intrinsics[0];
+                calibHeight = (int)intrinsics[1];
             }
         }
     }
 
-    // Add to queue
-    frameQueue_.push(frameData);
+    return scaleIntrinsics(raw, calibWidth, calibHeight, width, height);
+}
 
-    // Keep only last N frames
-    while (frameQueue_.size() > MAX_FRAME_QUEUE_SIZE) {
-        frameQueue_.pop();
+std::shared_ptr<CameraFrameData> QuestVuforiaDriver::acquireFrameSlot(uint32_t bufferSize) {
+    std::shared_ptr<CameraFrameData> slot = framePool_->acquire();
+
+    // Pool exhausted (consumers holding frames): fall back to a one-off frame
+    if (!slot) {
+        slot = std::make_shared<CameraFrameData>();
     }
 
-    LOGD("Frame fed: %dx%d, timestamp=%lld, queue_size=%zu",
-         width, height, (long long)timestamp, frameQueue_.size());
+    if (slot->capacity < bufferSize) {
+        delete[] slot->imageData;
+        slot->imageData = new uint8_t[bufferSize];
+        slot->capacity = bufferSize;
+        slot->neutralChroma = false;
+    }
+
+    return slot;
 }
 
 void QuestVuforiaDriver::feedDevicePose(const float* position, const float* rotation,
-                                       int64_t timestamp) {
-    std::lock_guard<std::mutex> lock(poseMutex_);
+                                       int64_t timestamp, float confidence) {
+    timestamp = clock_.stamp(timestamp);
+    TraceScope trace(trace_, "feedDevicePose", timestamp);
 
     // Create new pose data
-    auto poseData = std::make_shared<PoseData>();
-    poseData->timestamp = timestamp;
+    PoseData poseData;
+    poseData.timestamp = timestamp;
+    poseData.confidence = std::max(0.0f, std::min(1.0f, confidence));
 
     // Copy position (x, y, z)
     if (position != nullptr) {
-        memcpy(poseData->position, position, 3 * sizeof(float));
+        memcpy(poseData.position, position, 3 * sizeof(float));
     }
 
     // Copy rotation quaternion (x, y, z, w)
     if (rotation != nullptr) {
-        memcpy(poseData->rotation, rotation, 4 * sizeof(float));
+        memcpy(poseData.rotation, rotation, 4 * sizeof(float));
     }
 
-    // Add to queue
-    poseQueue_.push(poseData);
+    // Velocity against the previous sample (drives motion-based frame skipping)
+    const bool validating = poseValidationEnabled_.load();
+    PoseData prev;
+    bool jumped = false;
+    if (poseRing_.latest(&prev)) {
+        const int64_t dt = timestamp - prev.timestamp;
+        if (dt > 0) {
+            const float seconds = dt / 1e9f;
+            const float dx = poseData.position[0] - prev.position[0];
+            const float dy = poseData.position[1] - prev.position[1];
+            const float dz = poseData.position[2] - prev.position[2];
+            const float distance = std::sqrt(dx * dx + dy * dy + dz * dz);
+            poseData.linearVelocity = distance / seconds;
+
+            // Rotation angle between the two orientations: 2 * acos(|q0 . q1|)
+            float dot = 0.0f;
+            for (int i = 0; i < 4; i++) {
+                dot += poseData.rotation[i] * prev.rotation[i];
+            }
+            dot = std::min(1.0f, std::fabs(dot));
+            const float angle = 2.0f * std::acos(dot);
+            poseData.angularVelocity = angle / seconds;
+
+            // Consecutive samples this far apart are a relocalization teleport,
+            // not head motion. Only judged across a normal sample interval:
+            // after a gap the displacement is ordinary motion over a long dt
+            // (the gap itself is flagged by the gap check)
+            jumped = validating && dt <= maxPoseGapNs_.load() &&
+                     (distance > poseJumpDistance_.load() || angle > poseJumpAngle_.load());
+        }
+    }
+
+    // Tracking timeline: settle after start/reset, tracking loss and jumps.
+    // Worked out on copies; committed only once the ring accepts the sample.
+    // Not tracked while validation is off (enabling it restarts the timeline)
+    const bool reset = validating && poseValidationReset_.load();
+    int64_t confidentSinceNs = reset ? -1 : confidentSinceNs_;
+    int64_t lastJumpNs = reset ? -1 : lastJumpNs_;
+    bool trackingSettled = reset ? false : trackingSettled_;
+    bool relocalized = false;
+    if (validating) {
+        const int64_t settleNs = poseSettleNs_.load();
+        if (poseData.confidence < minPoseConfidence_.load()) {
+            confidentSinceNs = -1;
+        } else if (confidentSinceNs < 0) {
+            confidentSinceNs = timestamp;
+        }
+        relocalized = jumped && trackingSettled;
+        if (relocalized) {
+            lastJumpNs = timestamp;
+        }
+        const bool confidentRunSettled = confidentSinceNs >= 0 && timestamp - confidentSinceNs >= settleNs;
+        const bool jumpSettled = lastJumpNs < 0 || timestamp - lastJumpNs >= settleNs;
+        if (!trackingSettled) {
+            trackingSettled = confidentRunSettled;
+            poseData.initializing = !trackingSettled;
+        } else {
+            poseData.relocalizing = !confidentRunSettled || !jumpSettled;
+        }
+    }
 
-    // Keep only last N poses
-    while (poseQueue_.size() > MAX_POSE_QUEUE_SIZE) {
-        poseQueue_.pop();
+    // Add to history (keeps the last PoseRing::CAPACITY samples, sorted by time)
+    if (!poseRing_.push(poseData)) {
+        LOGD("Pose dropped: timestamp %lld is not newer than the latest pose",
+             (long long)timestamp);
+        return;
+    }
+
+    if (reset) {
+        poseValidationReset_ = false;
     }
+    confidentSinceNs_ = confidentSinceNs;
+    lastJumpNs_ = lastJumpNs;
+    trackingSettled_ = trackingSettled;
+    if (relocalized) {
+        const int64_t relocalizations = ++relocalizationCount_;
+        LOGI("Pose jump detected at %lld (%lld relocalizations)",
+             (long long)timestamp, (long long)relocalizations);
+        anchors_.pauseAll();
+    }
+
+    pipelineStats_.countPoseFed();
 
-    LOGD("Pose fed: pos(%.3f,%.3f,%.3f), timestamp=%lld, queue_size=%zu",
-         poseData->position[0], poseData->position[1], poseData->position[2],
-         (long long)timestamp, poseQueue_.size());
+    // Release frames held for this pose
+    if (poseJoinEnabled_.load()) {
+        notifyJoinWaiters();
+    }
+
+    LOGD("Pose fed: pos(%.3f,%.3f,%.3f), timestamp=%lld, history_size=%u",
+         poseData.position[0], poseData.position[1], poseData.position[2],
+         (long long)timestamp, poseRing_.size());
 }
 
-void QuestVuforiaDriver::setCameraIntrinsics(const float* intrinsics) {
+bool QuestVuforiaDriver::setCameraIntrinsics(const float* intrinsics, int cameraId) {
     if (intrinsics == nullptr) {
         LOGE("setCameraIntrinsics: intrinsics is null");
-        return;
+        return false;
+    }
+    if (cameraId < 0) {
+        cameraId = activeCamera_.load();
+    } else if (cameraId >= MAX_RIG_CAMERAS) {
+        LOGE("setCameraIntrinsics: invalid camera %d", cameraId);
+        return false;
     }
 
     std::lock_guard<std::mutex> lock(intrinsicsMutex_);
+    CameraCalibration& calibration = calibration_[cameraId];
 
     // Intrinsics array format from Unity: [width, height, fx, fy, cx, cy, d0-d7]
-    // Width/height are at indices 0-1 (only for reference, not stored in CameraIntrinsics struct)
+    // Width/height are at indices 0-1 (calibration resolution, used for per-mode rescaling)
     // Focal lengths and principal point at indices 2-5
     // Distortion coefficients at indices 6-13
-    cachedIntrinsics_.focalLengthX = intrinsics[2];
-    cachedIntrinsics_.focalLengthY = intrinsics[3];
-    cachedIntrinsics_.principalPointX = intrinsics[4];
-    cachedIntrinsics_.principalPointY = intrinsics[5];
+    calibration.intrinsics.focalLengthX = intrinsics[2];
+    calibration.intrinsics.focalLengthY = intrinsics[3];
+    calibration.intrinsics.principalPointX = intrinsics[4];
+    calibration.intrinsics.principalPointY = intrinsics[5];
+    calibration.width = (int)intrinsics[0];
+    calibration.height = (int)intrinsics[1];
 
     // Distortion coefficients (8 values starting at index 6)
     for (int i = 0; i < 8; i++) {
-        cachedIntrinsics_.distortionCoefficients[i] = intrinsics[i + 6];
+        calibration.intrinsics.distortionCoefficients[i] = intrinsics[i + 6];
+    }
+
+    calibration.valid = true;
+
+    LOGI("Camera %d intrinsics set: %.0fx%.0f, fx=%.2f, fy=%.2f, cx=%.2f, cy=%.2f",
+         cameraId, intrinsics[0], intrinsics[1],  // width, height for logging only
+         calibration.intrinsics.focalLengthX, calibration.intrinsics.focalLengthY,
+         calibration.intrinsics.principalPointX, calibration.intrinsics.principalPointY);
+    return true;
+}
+
+void QuestVuforiaDriver::setOutputMode(const VuforiaDriver::CameraMode& mode) {
+    if (mode.format != VuforiaDriver::PixelFormat::RGB888 &&
+        mode.format != VuforiaDriver::PixelFormat::RGBA8888 &&
+        !isYUV420Format(mode.format)) {
+        LOGE("setOutputMode: unsupported format %d", (int)mode.format);
+        return;
+    }
+
+    bool changed;
+    {
+        std::lock_guard<std::mutex> modeLock(modeMutex_);
+        changed = outputMode_.width != mode.width ||
+                  outputMode_.height != mode.height ||
+                  outputMode_.format != mode.format;
+        outputMode_ = mode;
+    }
+
+    if (changed) {
+        // Drop frames converted for the previous mode
+        std::lock_guard<std::mutex> lock(frameMutex_);
+        frameQueue_.clear();
+    }
+
+    LOGI("Output mode set to %ux%u@%ufps, format=%d",
+         mode.width, mode.height, mode.fps, (int)mode.format);
+}
+
+void QuestVuforiaDriver::setCropWindow(bool enabled, float x, float y,
+                                       float width, float height, bool upscale) {
+    if (enabled && (x < 0.0f || y < 0.0f || width <= 0.0f || height <= 0.0f ||
+                    x + width > 1.0f || y + height > 1.0f)) {
+        LOGE("setCropWindow: invalid window (%.3f, %.3f, %.3f, %.3f)", x, y, width, height);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> modeLock(modeMutex_);
+        cropWindow_.enabled = enabled;
+        cropWindow_.x = x;
+        cropWindow_.y = y;
+        cropWindow_.width = width;
+        cropWindow_.height = height;
+        cropWindow_.upscale = upscale;
+    }
+
+    LOGI("Crop window %s: (%.3f, %.3f, %.3f, %.3f), upscale=%d",
+         enabled ? "enabled" : "disabled", x, y, width, height, upscale);
+}
+
+void QuestVuforiaDriver::setUndistortionEnabled(bool enabled) {
+    undistortEnabled_ = enabled;
+    LOGI("Lens undistortion %s", enabled ? "enabled" : "disabled");
+}
+
+void QuestVuforiaDriver::setLowLightNormalization(int mode, int darkThreshold, float maxGain) {
+    if (mode < (int)NormalizationMode::OFF || mode > (int)NormalizationMode::CLAHE) {
+        LOGE("setLowLightNormalization: invalid mode %d", mode);
+        return;
+    }
+    normalizer_.setConfig((NormalizationMode)mode, darkThreshold, maxGain);
+}
+
+void QuestVuforiaDriver::setGrayscaleOnly(bool enabled) {
+    grayscaleOnly_ = enabled;
+    LOGI("Grayscale-only delivery %s", enabled ? "enabled" : "disabled");
+}
+
+void QuestVuforiaDriver::setAdaptiveResolution(bool enabled, float reducedScale, int holdMs) {
+    adaptiveResolution_.setConfig(enabled, reducedScale, (int64_t)holdMs * 1000000);
+}
+
+void QuestVuforiaDriver::setTrackingStatus(TrackingStatus status) {
+    const int64_t nowNs = steadyNowNs();
+    adaptiveResolution_.reportTrackingStatus(status, nowNs);
+
+    // Time-to-detection, tagged with the normalization mode for A/B comparison
+    std::lock_guard<std::mutex> lock(statusMutex_);
+    if (status == TrackingStatus::SEARCHING && trackingStatus_ != TrackingStatus::SEARCHING) {
+        searchStartNs_ = nowNs;
+    } else if (status != TrackingStatus::SEARCHING && trackingStatus_ == TrackingStatus::SEARCHING) {
+        LOGI("Time to detection: %.1f ms (normalization mode=%d)",
+             (nowNs - searchStartNs_) / 1e6, (int)normalizer_.mode());
+    }
+    trackingStatus_ = status;
+}
+
+void QuestVuforiaDriver::getAdaptiveResolutionStats(int64_t* fullNs, int64_t* reducedNs,
+                                                    int* switchCount) {
+    adaptiveResolution_.getStats(fullNs, reducedNs, switchCount);
+}
+
+void QuestVuforiaDriver::setMotionSkipping(bool enabled, float maxAngularVelocityDeg,
+                                           float maxLinearVelocity, int maxConsecutiveSkips) {
+    std::lock_guard<std::mutex> lock(motionMutex_);
+
+    motionSkipEnabled_ = enabled;
+    if (maxAngularVelocityDeg > 0.0f) {
+        maxAngularVelocity_ = maxAngularVelocityDeg * (float)M_PI / 180.0f;
+    }
+    if (maxLinearVelocity > 0.0f) {
+        maxLinearVelocity_ = maxLinearVelocity;
+    }
+    if (maxConsecutiveSkips >= 0) {
+        maxConsecutiveSkips_ = maxConsecutiveSkips;
     }
 
-    intrinsicsSet_ = true;
+    LOGI("Motion skipping %s (max angular=%.1f deg/s, max linear=%.2f m/s, max consecutive=%d)",
+         enabled ? "enabled" : "disabled", maxAngularVelocity_ * 180.0f / (float)M_PI,
+         maxLinearVelocity_, maxConsecutiveSkips_);
+}
+
+bool QuestVuforiaDriver::shouldSkipFrameForMotion(int64_t timestamp) {
+    float maxAngular;
+    float maxLinear;
+    int maxConsecutive;
+    {
+        std::lock_guard<std::mutex> lock(motionMutex_);
+        if (!motionSkipEnabled_) {
+            return false;
+        }
+        maxAngular = maxAngularVelocity_;
+        maxLinear = maxLinearVelocity_;
+        maxConsecutive = maxConsecutiveSkips_;
+    }
+
+    // Without a pose near the frame there is no motion estimate: deliver.
+    // Plain history lookup: this is a check, not a delivery, so it stays out
+    // of the lookup and prediction stats
+    PoseData pose;
+    if (!poseRing_.sample(timestamp, poseToleranceNs_.load(), &pose)) {
+        return false;
+    }
+
+    motionFramesEvaluated_++;
+
+    const bool fastMotion = pose.angularVelocity > maxAngular ||
+                            pose.linearVelocity > maxLinear;
+    if (fastMotion && consecutiveMotionSkips_ < maxConsecutive) {
+        consecutiveMotionSkips_++;
+        int64_t skipped = ++motionFramesSkipped_;
+        if (skipped % 30 == 0) {
+            LOGD("Motion skipping: %lld of %lld frames skipped (angular=%.2f rad/s, linear=%.2f m/s)",
+                 (long long)skipped, (long long)motionFramesEvaluated_.load(),
+                 pose.angularVelocity, pose.linearVelocity);
+        }
+        return true;
+    }
+
+    consecutiveMotionSkips_ = 0;
+    return false;
+}
 
-    LOGI("Camera intrinsics set: %.0fx%.0f, fx=%.2f, fy=%.2f, cx=%.2f, cy=%.2f",
-         intrinsics[0], intrinsics[1],  // width, height for logging only
-         cachedIntrinsics_.focalLengthX, cachedIntrinsics_.focalLengthY,
-         cachedIntrinsics_.principalPointX, cachedIntrinsics_.principalPointY);
+void QuestVuforiaDriver::getMotionSkipStats(int64_t* evaluated, int64_t* skipped) {
+    if (evaluated) *evaluated = motionFramesEvaluated_.load();
+    if (skipped) *skipped = motionFramesSkipped_.load();
+}
+
+void QuestVuforiaDriver::setSceneChangeGating(bool enabled, float lumaThreshold,
+                                              float translationThreshold,
+                                              float rotationThresholdDeg, float floorFps) {
+    sceneChange_.setConfig(enabled, lumaThreshold, translationThreshold,
+                           rotationThresholdDeg * (float)M_PI / 180.0f, floorFps);
+}
+
+bool QuestVuforiaDriver::shouldSkipStaticFrame(const CameraFrameData& frame) {
+    if (!sceneChange_.enabled() || !frame.hasThumbnail) {
+        return false;
+    }
+
+    // Plain history lookup, as for motion skipping (no lookup stats or trace)
+    PoseData pose;
+    const bool hasPose = poseRing_.sample(frame.timestamp, poseToleranceNs_.load(), &pose);
+    return !sceneChange_.shouldDeliver(frame.thumbnail,
+                                       hasPose ? pose.position : nullptr,
+                                       hasPose ? pose.rotation : nullptr,
+                                       steadyNowNs());
+}
+
+void QuestVuforiaDriver::getSceneChangeStats(int64_t* evaluated, int64_t* skipped) {
+    sceneChange_.getStats(evaluated, skipped);
+}
+
+void QuestVuforiaDriver::setBrightnessGating(bool enabled, int minMeanLuma) {
+    minMeanLuma_ = std::max(0, std::min(minMeanLuma, 255));
+    brightnessGateEnabled_ = enabled;
+    LOGI("Brightness gating %s (min mean luma=%d)", enabled ? "enabled" : "disabled",
+         minMeanLuma_.load());
+}
+
+void QuestVuforiaDriver::setFrameSelection(bool enabled, int windowMs) {
+    {
+        std::lock_guard<std::mutex> lock(frameMutex_);
+        if (windowMs >= 0) {
+            selectionWindowNs_ = (int64_t)windowMs * 1000000;
+        }
+        lastSelectedTimestamp_ = 0;
+    }
+    frameSelectionEnabled_ = enabled;
+
+    LOGI("Sharpest-frame selection %s (window=%d ms)", enabled ? "enabled" : "disabled", windowMs);
 }
 
 // =============================================================================
 // Frame/Pose Retrieval (called by ExternalCamera and ExternalTracker)
 // =============================================================================
 
-std::shared_ptr<CameraFrameData> QuestVuforiaDriver::acquireLatestFrame() {
+std::shared_ptr<CameraFrameData> QuestVuforiaDriver::peekFrame(bool* sharperOlder) {
     std::lock_guard<std::mutex> lock(frameMutex_);
 
+    if (sharperOlder) {
+        *sharperOlder = false;
+    }
     if (frameQueue_.empty()) {
         return nullptr;
     }
 
-    // Return the latest frame (back of queue)
-    // Don't pop it - let it age out naturally
-    return frameQueue_.back();
+    // Return the latest frame from the camera the stereo policy picks.
+    // Don't pop it - let it age out naturally. If that camera has nothing
+    // at or after the last pick, keep serving the newest frame overall.
+    // Only the committed pick is read, so the camera and tracker resolve to
+    // the same frame for the same queue contents.
+    const int camera = deliveryCamera();
+    std::shared_ptr<CameraFrameData> newest;
+    for (auto it = frameQueue_.rbegin(); it != frameQueue_.rend(); ++it) {
+        if ((*it)->cameraId == camera) {
+            if ((*it)->timestamp >= lastPickedTimestamp_) {
+                newest = *it;
+            }
+            break;
+        }
+    }
+    if (!newest) {
+        newest = frameQueue_.back();
+        for (const auto& frame : frameQueue_) {
+            if (frame->timestamp > newest->timestamp) {
+                newest = frame;
+            }
+        }
+    }
+
+    std::shared_ptr<CameraFrameData> best = newest;
+    if (frameSelectionEnabled_.load()) {
+        // Sharpest frame of the same camera within the window. Frames older
+        // than the last selection are excluded so delivery never steps back
+        // in time.
+        for (const auto& candidate : frameQueue_) {
+            if (candidate->cameraId != newest->cameraId ||
+                candidate->timestamp < lastSelectedTimestamp_ ||
+                newest->timestamp - candidate->timestamp > selectionWindowNs_) {
+                continue;
+            }
+            if (candidate->sharpness > best->sharpness) {
+                best = candidate;
+            }
+        }
+        if (sharperOlder) {
+            *sharperOlder = best != newest;
+        }
+    }
+    return best;
 }
 
-std::shared_ptr<PoseData> QuestVuforiaDriver::acquirePoseForTimestamp(int64_t timestamp) {
-    std::lock_guard<std::mutex> lock(poseMutex_);
+void QuestVuforiaDriver::commitPick(const CameraFrameData& frame, bool sharperOlder) {
+    std::lock_guard<std::mutex> lock(frameMutex_);
 
-    if (poseQueue_.empty()) {
-        LOGD("Pose queue is empty");
-        return nullptr;
+    if (frameSelectionEnabled_.load() && frame.timestamp != lastSelectedTimestamp_) {
+        lastSelectedTimestamp_ = frame.timestamp;
+        selectionCount_++;
+        if (sharperOlder) {
+            selectedOlderCount_++;
+        }
+        if (selectionCount_ % 30 == 0) {
+            LOGD("Frame selection: %lld of %lld picks were older but sharper frames",
+                 (long long)selectedOlderCount_, (long long)selectionCount_);
+        }
     }
 
-    // Find the pose with the closest timestamp
-    // In production, you should interpolate between poses
-    std::shared_ptr<PoseData> closestPose = nullptr;
-    int64_t minTimeDiff = INT64_MAX;
+    if (frame.timestamp != lastPickedTimestamp_ || frame.cameraId != lastPickedCamera_) {
+        if (frame.cameraId != lastPickedCamera_) {
+            cameraSwitches_++;
+        }
+        lastPickedCamera_ = frame.cameraId;
+        lastPickedTimestamp_ = frame.timestamp;
+        cameraPicks_[frame.cameraId]++;
+    }
+}
 
-    // Create a temporary queue to iterate without modifying the original
-    std::queue<std::shared_ptr<PoseData>> tempQueue = poseQueue_;
+int QuestVuforiaDriver::deliveryCamera() const {
+    switch ((StereoPolicy)stereoPolicy_.load()) {
+    case StereoPolicy::ALTERNATE: {
+        // Switch once the other camera has a frame newer than the last pick
+        const int other = (lastPickedCamera_ + 1) % MAX_RIG_CAMERAS;
+        for (const auto& frame : frameQueue_) {
+            if (frame->cameraId == other && frame->timestamp > lastPickedTimestamp_) {
+                return other;
+            }
+        }
+        return lastPickedCamera_;
+    }
+    case StereoPolicy::BEST_CAMERA:
+        return bestCamera_.load();
+    case StereoPolicy::ACTIVE_CAMERA:
+    default:
+        return activeCamera_.load();
+    }
+}
 
-    while (!tempQueue.empty()) {
-        auto pose = tempQueue.front();
-        tempQueue.pop();
+bool QuestVuforiaDriver::acquirePoseForTimestamp(int64_t timestamp, PoseData* pose,
+                                                 bool forcePrediction) {
+    StageTimer timer(pipelineStats_, PipelineStage::POSE_LOOKUP);
+    TraceScope trace(trace_, "poseLookup", timestamp);
+    poseLookups_++;
+
+    // Frame newer than the newest sample: extrapolate instead of handing back
+    // a lagged pose
+    if (forcePrediction || predictionEnabled_.load()) {
+        PoseData history[3];
+        const uint32_t count = poseRing_.latestSamples(history, 3);
+        if (count > 0 && timestamp > history[count - 1].timestamp) {
+            const int64_t horizonNs = timestamp - history[count - 1].timestamp;
+            if (horizonNs <= maxPredictionNs_.load() &&
+                predictPose(history, count, timestamp,
+                            (PredictionModel)predictionModel_.load(), pose)) {
+                pose->unreliable = horizonNs > unreliablePredictionNs_.load();
+
+                const int64_t predictions = ++posePredictions_;
+                predictionHorizonTotalNs_ += horizonNs;
+                if (horizonNs > predictionHorizonMaxNs_.load()) {
+                    predictionHorizonMaxNs_ = horizonNs;
+                }
+                if (predictions % 100 == 0) {
+                    LOGD("Pose prediction: %lld of %lld lookups, avg horizon %.2f ms, max %.2f ms",
+                         (long long)predictions, (long long)poseLookups_.load(),
+                         predictionHorizonTotalNs_.load() / 1e6 / predictions,
+                         predictionHorizonMaxNs_.load() / 1e6);
+                }
+                return true;
+            }
+        }
+    }
 
-        int64_t timeDiff = std::abs(pose->timestamp - timestamp);
-        if (timeDiff < minTimeDiff) {
-            minTimeDiff = timeDiff;
-            closestPose = pose;
+    // Binary search + lerp/slerp between the bracketing samples; never blocks
+    // the feeding thread
+    if (!poseRing_.sample(timestamp, poseToleranceNs_.load(), pose)) {
+        LOGD("No matching pose found for timestamp %lld (history_size=%u)",
+             (long long)timestamp, poseRing_.size());
+        return false;
+    }
+
+    LOGD("Found pose for timestamp %lld (gap=%lld ns)", (long long)timestamp, (long long)pose->gapNs);
+    return true;
+}
+
+bool QuestVuforiaDriver::queryPose(int64_t timestamp, PoseData* pose) const {
+    timestamp = clock_.map(timestamp);
+
+    if (predictionEnabled_.load()) {
+        PoseData history[3];
+        const uint32_t count = poseRing_.latestSamples(history, 3);
+        if (count > 0 && timestamp > history[count - 1].timestamp &&
+            timestamp - history[count - 1].timestamp <= maxPredictionNs_.load() &&
+            predictPose(history, count, timestamp, (PredictionModel)predictionModel_.load(), pose)) {
+            pose->unreliable = pose->gapNs > unreliablePredictionNs_.load();
+            return true;
         }
     }
 
-    if (closestPose && minTimeDiff < 50000000) {  // Within 50ms
-        LOGD("Found pose for timestamp %lld (diff=%lld ns)",
-             (long long)timestamp, (long long)minTimeDiff);
-        return closestPose;
-    } else {
-        LOGD("No matching pose found for timestamp %lld (closest diff=%lld ns)",
-             (long long)timestamp, (long long)minTimeDiff);
-        return nullptr;
+    return poseRing_.sample(timestamp, poseToleranceNs_.load(), pose);
+}
+
+void QuestVuforiaDriver::setPoseTolerance(int toleranceMs) {
+    if (toleranceMs <= 0) {
+        LOGE("setPoseTolerance: invalid tolerance %d ms", toleranceMs);
+        return;
+    }
+    poseToleranceNs_ = (int64_t)toleranceMs * 1000000;
+    LOGI("Pose lookup tolerance set to %d ms", toleranceMs);
+}
+
+void QuestVuforiaDriver::setPosePrediction(bool enabled, PredictionModel model, int maxHorizonMs,
+                                           int unreliableHorizonMs) {
+    if (maxHorizonMs >= 0) {
+        maxPredictionNs_ = (int64_t)maxHorizonMs * 1000000;
+    }
+    if (unreliableHorizonMs >= 0) {
+        unreliablePredictionNs_ = (int64_t)unreliableHorizonMs * 1000000;
+    }
+    predictionModel_ = (int32_t)model;
+    predictionEnabled_ = enabled;
+
+    LOGI("Pose prediction %s (model=%d, max horizon=%d ms, unreliable beyond %d ms)",
+         enabled ? "enabled" : "disabled", (int)model, maxHorizonMs, unreliableHorizonMs);
+}
+
+void QuestVuforiaDriver::getPosePredictionStats(int64_t* lookups, int64_t* predicted,
+                                                int64_t* totalHorizonNs, int64_t* maxHorizonNs) {
+    if (lookups) *lookups = poseLookups_.load();
+    if (predicted) *predicted = posePredictions_.load();
+    if (totalHorizonNs) *totalHorizonNs = predictionHorizonTotalNs_.load();
+    if (maxHorizonNs) *maxHorizonNs = predictionHorizonMaxNs_.load();
+}
+
+// =============================================================================
+// Late-Pose Join (pose-then-frame ordering)
+// =============================================================================
+
+void QuestVuforiaDriver::notifyJoinWaiters() {
+    // Lock pairs with the waiters' predicate check so a wake-up is never lost
+    {
+        std::lock_guard<std::mutex> lock(joinMutex_);
+    }
+    joinCv_.notify_all();
+}
+
+void QuestVuforiaDriver::setPoseJoin(bool enabled, int timeoutMs) {
+    if (timeoutMs < 0) {
+        LOGE("setPoseJoin: invalid timeout %d ms", timeoutMs);
+        return;
+    }
+    poseJoinTimeoutNs_ = (int64_t)timeoutMs * 1000000;
+    poseJoinEnabled_ = enabled;
+
+    // Release anything still waiting under the previous config
+    notifyJoinWaiters();
+
+    LOGI("Late-pose join %s (timeout=%d ms)", enabled ? "enabled" : "disabled", timeoutMs);
+}
+
+bool QuestVuforiaDriver::waitForBracketingPose(int64_t timestamp) {
+    if (!poseJoinEnabled_.load()) {
+        return true;
+    }
+
+    const int64_t joins = ++poseJoins_;
+    PoseData newest;
+    if (poseRing_.latest(&newest) && newest.timestamp >= timestamp) {
+        return true;  // Pose already arrived
+    }
+
+    poseJoinWaits_++;
+    const auto waitStart = std::chrono::steady_clock::now();
+    bool arrived;
+    {
+        std::unique_lock<std::mutex> lock(joinMutex_);
+        arrived = joinCv_.wait_for(lock, std::chrono::nanoseconds(poseJoinTimeoutNs_.load()), [&] {
+            PoseData latest;
+            return !poseJoinEnabled_.load() ||
+                   (poseRing_.latest(&latest) && latest.timestamp >= timestamp);
+        });
+    }
+    poseJoinWaitTotalNs_ += std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - waitStart).count();
+
+    if (!arrived) {
+        poseJoinTimeouts_++;
+    }
+    if (joins % 100 == 0) {
+        LOGD("Pose join: %lld of %lld frames waited (avg %.2f ms), %lld timed out",
+             (long long)poseJoinWaits_.load(), (long long)joins,
+             poseJoinWaitTotalNs_.load() / 1e6 / std::max<int64_t>(1, poseJoinWaits_.load()),
+             (long long)poseJoinTimeouts_.load());
+    }
+    return arrived;
+}
+
+void QuestVuforiaDriver::waitForNewFrame(uint64_t* frameSequence, int64_t timeoutNs) {
+    std::unique_lock<std::mutex> lock(joinMutex_);
+    joinCv_.wait_for(lock, std::chrono::nanoseconds(timeoutNs), [&] {
+        return frameSequence_.load() != *frameSequence;
+    });
+    *frameSequence = frameSequence_.load();
+}
+
+void QuestVuforiaDriver::setPoseDeliveryActive(bool active) {
+    poseDeliveryActive_ = active;
+    lastDeliveredPoseTimestamp_ = 0;
+    notifyJoinWaiters();
+}
+
+void QuestVuforiaDriver::notifyPoseDelivered(int64_t timestamp) {
+    lastDeliveredPoseTimestamp_ = timestamp;
+    if (poseJoinEnabled_.load()) {
+        notifyJoinWaiters();
+    }
+}
+
+bool QuestVuforiaDriver::waitForPoseDelivered(int64_t timestamp) {
+    if (!poseJoinEnabled_.load() || !poseDeliveryActive_.load()) {
+        return true;
+    }
+    TraceScope trace(trace_, "waitForPoseDelivered", timestamp);
+
+    // The tracker waits at most the join timeout before predicting, so allow
+    // that plus its wake-up latency
+    const int64_t timeoutNs = poseJoinTimeoutNs_.load() + POSE_ORDER_MARGIN_NS;
+    bool delivered;
+    {
+        std::unique_lock<std::mutex> lock(joinMutex_);
+        delivered = joinCv_.wait_for(lock, std::chrono::nanoseconds(timeoutNs), [&] {
+            return !poseJoinEnabled_.load() || !poseDeliveryActive_.load() ||
+                   lastDeliveredPoseTimestamp_.load() >= timestamp;
+        });
+    }
+
+    if (!delivered) {
+        const int64_t orderTimeouts = ++poseOrderTimeouts_;
+        if (orderTimeouts % 30 == 1) {
+            LOGD("Pose join: frame %lld delivered without its pose (%lld total)",
+                 (long long)timestamp, (long long)orderTimeouts);
+        }
+    }
+    return delivered;
+}
+
+void QuestVuforiaDriver::getPoseJoinStats(int64_t* joins, int64_t* waits, int64_t* timeouts,
+                                          int64_t* totalWaitNs, int64_t* orderTimeouts) {
+    if (joins) *joins = poseJoins_.load();
+    if (waits) *waits = poseJoinWaits_.load();
+    if (timeouts) *timeouts = poseJoinTimeouts_.load();
+    if (totalWaitNs) *totalWaitNs = poseJoinWaitTotalNs_.load();
+    if (orderTimeouts) *orderTimeouts = poseOrderTimeouts_.load();
+}
+
+// =============================================================================
+// Pose Streaming (tracker-rate delivery)
+// =============================================================================
+
+void QuestVuforiaDriver::setPoseStreaming(bool enabled) {
+    poseStreamingEnabled_ = enabled;
+    notifyJoinWaiters();
+    LOGI("Pose streaming %s", enabled ? "enabled" : "disabled");
+}
+
+bool QuestVuforiaDriver::deliverFramePose(const CameraFrameData& frame) {
+    if (!tracker_) {
+        return false;
+    }
+    tracker_->streamPosesBefore(frame.timestamp, frame.cameraId);
+    return tracker_->deliverFramePose(frame);
+}
+
+uint32_t QuestVuforiaDriver::latestPoseSamples(PoseData* out, uint32_t maxCount) const {
+    return poseRing_.latestSamples(out, maxCount);
+}
+
+int64_t QuestVuforiaDriver::poseStreamHorizon(int64_t lastFramePose) {
+    std::lock_guard<std::mutex> lock(frameMutex_);
+
+    // Frames are picked in timestamp order and later frames are newer than
+    // every queued one, so the next frame pose is at or after this
+    bool pending = false;
+    int64_t oldestPending = 0;
+    int64_t newest = lastFramePose;
+    for (const auto& frame : frameQueue_) {
+        if (frame->timestamp > lastFramePose && (!pending || frame->timestamp < oldestPending)) {
+            oldestPending = frame->timestamp;
+            pending = true;
+        }
+        newest = std::max(newest, frame->timestamp);
+    }
+    return pending ? oldestPending : newest;
+}
+
+// =============================================================================
+// Pose Validity Classification
+// =============================================================================
+
+void QuestVuforiaDriver::setPoseValidation(bool enabled, float minConfidence, int maxGapMs,
+                                           float jumpDistance, float jumpAngleDeg,
+                                           float maxAngularVelocityDeg, int settleMs) {
+    if (minConfidence < 0.0f || minConfidence > 1.0f || maxGapMs <= 0 || jumpDistance <= 0.0f ||
+        jumpAngleDeg <= 0.0f || maxAngularVelocityDeg <= 0.0f || settleMs < 0) {
+        LOGE("setPoseValidation: invalid config (confidence=%.2f, gap=%d ms, jump=%.3f m / %.1f deg, "
+             "max angular velocity=%.1f deg/s, settle=%d ms)",
+             minConfidence, maxGapMs, jumpDistance, jumpAngleDeg, maxAngularVelocityDeg, settleMs);
+        return;
+    }
+
+    const float degToRad = (float)M_PI / 180.0f;
+    minPoseConfidence_ = minConfidence;
+    maxPoseGapNs_ = (int64_t)maxGapMs * 1000000;
+    poseJumpDistance_ = jumpDistance;
+    poseJumpAngle_ = jumpAngleDeg * degToRad;
+    excessiveAngularVelocity_ = maxAngularVelocityDeg * degToRad;
+    poseSettleNs_ = (int64_t)settleMs * 1000000;
+    // The tracking timeline is not kept while disabled: start it afresh
+    if (enabled && !poseValidationEnabled_.load()) {
+        poseValidationReset_ = true;
+    }
+    poseValidationEnabled_ = enabled;
+
+    LOGI("Pose validation %s (min confidence=%.2f, max gap=%d ms, jump=%.3f m / %.1f deg, "
+         "excessive motion=%.1f deg/s, settle=%d ms)",
+         enabled ? "enabled" : "disabled", minConfidence, maxGapMs, jumpDistance, jumpAngleDeg,
+         maxAngularVelocityDeg, settleMs);
+}
+
+void QuestVuforiaDriver::classifyPose(const PoseData& pose, VuforiaDriver::PoseReason* reason,
+                                      VuforiaDriver::PoseValidity* validity) {
+    bool unreliable = pose.unreliable;  // Predicted far past the newest tracker sample
+    *reason = VuforiaDriver::PoseReason::VALID;
+
+    if (poseValidationEnabled_.load()) {
+        if (pose.initializing) {
+            *reason = VuforiaDriver::PoseReason::INITIALIZING;
+            posesInitializing_++;
+        } else if (pose.relocalizing) {
+            *reason = VuforiaDriver::PoseReason::RELOCALIZING;
+            posesRelocalizing_++;
+        } else if (pose.angularVelocity > excessiveAngularVelocity_.load()) {
+            *reason = VuforiaDriver::PoseReason::EXCESSIVE_MOTION;
+            posesExcessiveMotion_++;
+        }
+
+        unreliable = unreliable || *reason != VuforiaDriver::PoseReason::VALID ||
+                     pose.confidence < minPoseConfidence_.load() ||
+                     pose.gapNs > maxPoseGapNs_.load();
+    }
+
+    *validity = unreliable ? VuforiaDriver::PoseValidity::UNRELIABLE : VuforiaDriver::PoseValidity::VALID;
+
+    const int64_t classified = ++posesClassified_;
+    if (unreliable) {
+        posesUnreliable_++;
+    }
+    if (classified % 300 == 0) {
+        LOGD("Pose validity: %lld of %lld unreliable (initializing %lld, relocalizing %lld, "
+             "excessive motion %lld)",
+             (long long)posesUnreliable_.load(), (long long)classified,
+             (long long)posesInitializing_.load(), (long long)posesRelocalizing_.load(),
+             (long long)posesExcessiveMotion_.load());
+    }
+}
+
+void QuestVuforiaDriver::resetPoseValidation() {
+    // Applied by the feeding thread on the next sample
+    poseValidationReset_ = true;
+}
+
+void QuestVuforiaDriver::getPoseValidityStats(int64_t* classified, int64_t* unreliable,
+                                              int64_t* initializing, int64_t* relocalizing,
+                                              int64_t* excessiveMotion, int64_t* relocalizations) {
+    if (classified) *classified = posesClassified_.load();
+    if (unreliable) *unreliable = posesUnreliable_.load();
+    if (initializing) *initializing = posesInitializing_.load();
+    if (relocalizing) *relocalizing = posesRelocalizing_.load();
+    if (excessiveMotion) *excessiveMotion = posesExcessiveMotion_.load();
+    if (relocalizations) *relocalizations = relocalizationCount_.load();
+}
+
+// =============================================================================
+// Camera Rig
+// =============================================================================
+
+bool QuestVuforiaDriver::setCameraExtrinsics(int cameraId, const float* position,
+                                             const float* rotation) {
+    if (cameraId < 0 || cameraId >= MAX_RIG_CAMERAS || position == nullptr || rotation == nullptr) {
+        LOGE("setCameraExtrinsics: invalid camera %d", cameraId);
+        return false;
+    }
+
+    float norm = 0.0f;
+    for (int i = 0; i < 4; i++) {
+        norm += rotation[i] * rotation[i];
+    }
+    if (norm < 1e-6f) {
+        LOGE("setCameraExtrinsics: degenerate rotation for camera %d", cameraId);
+        return false;
+    }
+    norm = 1.0f / std::sqrt(norm);
+
+    {
+        std::lock_guard<std::mutex> lock(rigMutex_);
+        RigCamera& camera = rig_[cameraId];
+        memcpy(camera.position, position, 3 * sizeof(float));
+        for (int i = 0; i < 4; i++) {
+            camera.rotation[i] = rotation[i] * norm;
+        }
+        camera.valid = true;
+    }
+
+    LOGI("Camera %d extrinsics set: pos(%.4f, %.4f, %.4f) rot(%.4f, %.4f, %.4f, %.4f)",
+         cameraId, position[0], position[1], position[2],
+         rotation[0] * norm, rotation[1] * norm, rotation[2] * norm, rotation[3] * norm);
+    return true;
+}
+
+void QuestVuforiaDriver::clearCameraExtrinsics() {
+    {
+        std::lock_guard<std::mutex> lock(rigMutex_);
+        for (int i = 0; i < MAX_RIG_CAMERAS; i++) {
+            rig_[i] = RigCamera();
+        }
+    }
+    LOGI("Camera extrinsics cleared (fed poses are camera poses)");
+}
+
+bool QuestVuforiaDriver::setActiveCamera(int cameraId) {
+    if (cameraId < 0 || cameraId >= MAX_RIG_CAMERAS) {
+        LOGE("setActiveCamera: invalid camera %d", cameraId);
+        return false;
     }
+    activeCamera_ = cameraId;
+    LOGI("Active camera set to %d", cameraId);
+    return true;
+}
+
+void QuestVuforiaDriver::composeCameraPose(int cameraId, PoseData* pose) {
+    if (cameraId < 0 || cameraId >= MAX_RIG_CAMERAS) {
+        return;
+    }
+
+    RigCamera camera;
+    {
+        std::lock_guard<std::mutex> lock(rigMutex_);
+        camera = rig_[cameraId];
+    }
+    if (!camera.valid) {
+        return;
+    }
+
+    // camera = head * extrinsics: p = p_head + R_head * t, q = q_head * q_ext
+    float offset[3];
+    rotateVector(pose->rotation, camera.position, offset);
+    for (int i = 0; i < 3; i++) {
+        pose->position[i] += offset[i];
+    }
+
+    const float head[4] = { pose->rotation[0], pose->rotation[1], pose->rotation[2], pose->rotation[3] };
+    multiplyQuaternion(head, camera.rotation, pose->rotation);
+}
+
+// =============================================================================
+// Stereo Delivery
+// =============================================================================
+
+void QuestVuforiaDriver::setStereoPolicy(StereoPolicy policy) {
+    if (policy != StereoPolicy::ACTIVE_CAMERA && policy != StereoPolicy::ALTERNATE &&
+        policy != StereoPolicy::BEST_CAMERA) {
+        LOGE("setStereoPolicy: invalid policy %d", (int)policy);
+        return;
+    }
+    stereoPolicy_ = (int32_t)policy;
+
+    LOGI("Stereo policy: %s",
+         policy == StereoPolicy::ALTERNATE ? "alternate cameras" :
+         policy == StereoPolicy::BEST_CAMERA ? "best camera" : "active camera only");
+}
+
+bool QuestVuforiaDriver::setCameraTargetScore(int cameraId, float score) {
+    if (cameraId < 0 || cameraId >= MAX_RIG_CAMERAS) {
+        LOGE("setCameraTargetScore: invalid camera %d", cameraId);
+        return false;
+    }
+    cameraScores_[cameraId] = std::max(0.0f, std::min(score, 1.0f));
+
+    // Hysteresis: only switch when another camera clearly sees the target better
+    const int current = bestCamera_.load();
+    int best = current;
+    for (int i = 0; i < MAX_RIG_CAMERAS; i++) {
+        if (cameraScores_[i].load() > cameraScores_[best].load() + BEST_CAMERA_MARGIN) {
+            best = i;
+        }
+    }
+    if (best != current) {
+        bestCamera_ = best;
+        LOGD("Best camera: %d (score %.2f)", best, cameraScores_[best].load());
+    }
+    return true;
+}
+
+void QuestVuforiaDriver::getStereoStats(int64_t* picks, int64_t* switches) {
+    std::lock_guard<std::mutex> lock(frameMutex_);
+    for (int i = 0; i < MAX_RIG_CAMERAS; i++) {
+        picks[i] = cameraPicks_[i];
+    }
+    *switches = cameraSwitches_;
+}
+
+// =============================================================================
+// Clock Domain
+// =============================================================================
+
+void QuestVuforiaDriver::setClockDomain(ClockDomain domain) {
+    if (domain < ClockDomain::MONOTONIC || domain > ClockDomain::ARRIVAL) {
+        LOGE("setClockDomain: invalid clock domain %d", (int)domain);
+        return;
+    }
+    clock_.setDomain(domain);
+}
+
+void QuestVuforiaDriver::getClockStats(int64_t* offsetNs, int64_t* driftPpb, int64_t* resyncs,
+                                       int64_t* samples, int64_t* avgFrameAgeNs) {
+    clock_.getStats(offsetNs, driftPpb, resyncs, samples);
+    if (avgFrameAgeNs) *avgFrameAgeNs = lastFrameAgeNs_.load();
 }
@@ -2,10 +2,24 @@
 #define QUEST_VUFORIA_DRIVER_H
 
 #include <VuforiaEngine/Driver/Driver.h>
+#include "frame_scaler.h"
+#include "adaptive_resolution.h"
+#include "undistortion.h"
+#include "luma_normalizer.h"
+#include "scene_change.h"
+#include "frame_quality.h"
+#include "pose_ring.h"
+#include "anchor_store.h"
+#include "clock_domain.h"
+#include "pipeline_stats.h"
+#include "trace_recorder.h"
 #include <mutex>
-#include <queue>
+#include <deque>
 #include <memory>
+#include <vector>
 #include <atomic>
+#include <condition_variable>
+#include <cstring>
 
 // Forward declarations
 class QuestExternalCamera;
@@ -14,12 +28,28 @@ class QuestExternalTracker;
 // Frame data structure for passing from Java/Kotlin layer
 struct CameraFrameData {
     uint8_t* imageData;
+    uint32_t capacity;   // Allocated bytes (slots are recycled between frames)
     int width;
     int height;
+    int stride;          // Bytes per row (Y plane for YUV formats)
+    uint32_t bufferSize; // Bytes used in imageData
+    VuforiaDriver::PixelFormat format;
+    bool neutralChroma;  // Chroma planes already hold constant 128 (grayscale mode)
     int64_t timestamp;  // Nanoseconds
     VuforiaDriver::CameraIntrinsics intrinsics;
+    float sharpness;     // Laplacian variance, 0 if not computed
+    float meanLuma;      // Mean luma before normalization, -1 if not computed
+    bool lowLight;       // Below the brightness gate (not delivered, pose flagged)
+    int cameraId;        // Rig camera that captured the frame
+    int64_t enqueuedNs;  // CLOCK_MONOTONIC when queued for delivery
+    bool hasThumbnail;   // thumbnail is valid (scene change gating enabled)
+    uint8_t thumbnail[SCENE_THUMB_SIZE];
 
-    CameraFrameData() : imageData(nullptr), width(0), height(0), timestamp(0) {
+    CameraFrameData()
+        : imageData(nullptr), capacity(0), width(0), height(0), stride(0), bufferSize(0)
+        , format(VuforiaDriver::PixelFormat::RGB888), neutralChroma(false), timestamp(0)
+        , sharpness(0.0f), meanLuma(-1.0f), lowLight(false), cameraId(0), enqueuedNs(0)
+        , hasThumbnail(false) {
         memset(&intrinsics, 0, sizeof(intrinsics));
     }
 
@@ -31,19 +61,81 @@ struct CameraFrameData {
     }
 };
 
-// Pose data structure for 6DoF tracking
-struct PoseData {
-    int64_t timestamp;  // Nanoseconds
-    float position[3];   // World space position (x, y, z)
-    float rotation[4];   // Quaternion (x, y, z, w)
+/**
+ * Recycled frame slots.
+ *
+ * acquire() hands a slot out as a shared_ptr whose deleter puts it back on
+ * the free list once the last holder (queue, delivery thread) lets go. The
+ * free list is guarded by the pool mutex, so the next user of a slot sees
+ * every write made by its previous holders. Slots may outlive the driver:
+ * each one keeps the pool alive until it comes back.
+ */
+class FrameSlotPool : public std::enable_shared_from_this<FrameSlotPool> {
+public:
+    explicit FrameSlotPool(size_t maxSlots);
+    ~FrameSlotPool();
+
+    // A free slot, a new one while below maxSlots, or nullptr when exhausted
+    std::shared_ptr<CameraFrameData> acquire();
+
+private:
+    void release(CameraFrameData* slot);
+
+    std::mutex mutex_;
+    std::vector<CameraFrameData*> free_;
+    size_t allocated_;
+    const size_t maxSlots_;
+};
+
+// Digital crop/zoom window applied at ingestion (normalized to the source frame)
+struct CropWindow {
+    bool enabled;
+    float x;        // Left edge [0, 1]
+    float y;        // Top edge [0, 1] (in the delivered, post-flip image)
+    float width;    // Fraction of source width
+    float height;   // Fraction of source height
+    bool upscale;   // Scale the window back up to the full mode size
 
-    PoseData() : timestamp(0) {
+    CropWindow() : enabled(false), x(0.0f), y(0.0f), width(1.0f), height(1.0f), upscale(false) {}
+};
+
+// Camera mounting relative to the head (head-local, same axes as fed poses)
+struct RigCamera {
+    bool valid;
+    float position[3];
+    float rotation[4];  // Quaternion (x, y, z, w)
+
+    RigCamera() : valid(false) {
         position[0] = position[1] = position[2] = 0.0f;
         rotation[0] = rotation[1] = rotation[2] = 0.0f;
-        rotation[3] = 1.0f;  // Identity quaternion
+        rotation[3] = 1.0f;
+    }
+};
+
+// Intrinsics calibrated for one rig camera ([width, height, fx, fy, cx, cy, d0-d7]
+// from Unity; 0x0 means calibrated at the source frame size)
+struct CameraCalibration {
+    bool valid;
+    int width;
+    int height;
+    VuforiaDriver::CameraIntrinsics intrinsics;
+
+    CameraCalibration() : valid(false), width(0), height(0) {
+        memset(&intrinsics, 0, sizeof(intrinsics));
     }
 };
 
+/**
+ * Which rig camera's frames are delivered to Vuforia when both cameras are fed.
+ * Vuforia always sees a single stream; each frame carries its own intrinsics
+ * and its pose is composed with the capturing camera's extrinsics.
+ */
+enum class StereoPolicy : int32_t {
+    ACTIVE_CAMERA = 0,  ///< Frames from the active camera only (mono)
+    ALTERNATE = 1,      ///< Interleave left/right frames (each camera at half the mode rate)
+    BEST_CAMERA = 2     ///< Frames from the camera that sees the tracked target best
+};
+
 // Main driver class implementing Vuforia Driver Framework
 class QuestVuforiaDriver : public VuforiaDriver::Driver {
 public:
@@ -58,33 +150,325 @@ public:
     virtual void destroyExternalPositionalDeviceTracker(VuforiaDriver::ExternalPositionalDeviceTracker* instance) override;
 
     // Frame and pose feeding methods (called from JNI)
+    // Timestamps are in the declared clock domain and stamped into
+    // CLOCK_MONOTONIC on entry.
+    // sourceFormat must be RGB888 or RGBA8888 (Unity passthrough is RGBA32)
+    // cameraId: rig camera that captured the frame (-1 = the active camera)
     void feedCameraFrame(const uint8_t* imageData, int width, int height,
-                        const float* intrinsics, int64_t timestamp);
-    void feedDevicePose(const float* position, const float* rotation, int64_t timestamp);
-    void setCameraIntrinsics(const float* intrinsics);
+                        VuforiaDriver::PixelFormat sourceFormat, bool flipVertically,
+                        const float* intrinsics, int64_t timestamp, int cameraId = -1);
+    // confidence: tracker confidence in [0, 1] (1 when the source has none)
+    void feedDevicePose(const float* position, const float* rotation, int64_t timestamp,
+                        float confidence = 1.0f);
+    bool setCameraIntrinsics(const float* intrinsics, int cameraId = -1);
+
+    // Clock of fed (and queried) timestamps
+    void setClockDomain(ClockDomain domain);
+    void getClockStats(int64_t* offsetNs, int64_t* driftPpb, int64_t* resyncs, int64_t* samples,
+                       int64_t* avgFrameAgeNs);
+
+    // Output size/format for ingested frames (set by camera when Vuforia picks a mode)
+    void setOutputMode(const VuforiaDriver::CameraMode& mode);
+
+    // Digital crop/zoom window (normalized coordinates)
+    void setCropWindow(bool enabled, float x, float y, float width, float height, bool upscale);
+
+    // Luma-only delivery for YUV formats (chroma planes held at constant grey)
+    void setGrayscaleOnly(bool enabled);
+
+    // Rectify frames natively using the intrinsics' distortion coefficients
+    void setUndistortionEnabled(bool enabled);
+
+    // Brighten dim frames (mode: NormalizationMode) before delivery
+    void setLowLightNormalization(int mode, int darkThreshold, float maxGain);
+
+    // Adaptive output resolution driven by tracking status reported from Unity
+    void setAdaptiveResolution(bool enabled, float reducedScale, int holdMs);
+    void setTrackingStatus(TrackingStatus status);
+    void getAdaptiveResolutionStats(int64_t* fullNs, int64_t* reducedNs, int* switchCount);
+
+    // Skip frames captured during fast head motion (likely motion-blurred).
+    // maxConsecutiveSkips bounds how long delivery can be starved.
+    void setMotionSkipping(bool enabled, float maxAngularVelocityDeg, float maxLinearVelocity,
+                           int maxConsecutiveSkips);
+    bool shouldSkipFrameForMotion(int64_t timestamp);
+    void getMotionSkipStats(int64_t* evaluated, int64_t* skipped);
+
+    // Throttle delivery to floorFps while the headset and scene are static
+    // (shouldSkipStaticFrame advances the gate: call it once per new frame)
+    void setSceneChangeGating(bool enabled, float lumaThreshold, float translationThreshold,
+                              float rotationThresholdDeg, float floorFps);
+    bool shouldSkipStaticFrame(const CameraFrameData& frame);
+    void getSceneChangeStats(int64_t* evaluated, int64_t* skipped);
+
+    // Withhold frames darker than minMeanLuma; their poses are reported as
+    // INSUFFICIENT_LIGHT / UNRELIABLE
+    void setBrightnessGating(bool enabled, int minMeanLuma);
+
+    // Best-of-N: deliver the sharpest queued frame within windowMs of the newest
+    void setFrameSelection(bool enabled, int windowMs);
 
-    // Frame buffer management
-    std::shared_ptr<CameraFrameData> acquireLatestFrame();
-    std::shared_ptr<PoseData> acquirePoseForTimestamp(int64_t timestamp);
+    // Frame buffer management. peekFrame() has no side effects: the camera
+    // and tracker both see the frame the camera thread will deliver next.
+    // Only the camera thread calls commitPick(), once per frame it handles,
+    // which advances the stereo pick and the sharpest-frame selection.
+    // sharperOlder: selection chose an older, sharper frame over the newest.
+    std::shared_ptr<CameraFrameData> peekFrame(bool* sharperOlder = nullptr);
+    void commitPick(const CameraFrameData& frame, bool sharperOlder);
+    // Pose at the timestamp, interpolated from the pose history
+    // (forcePrediction extrapolates even when prediction is disabled)
+    bool acquirePoseForTimestamp(int64_t timestamp, PoseData* pose, bool forcePrediction = false);
+
+    // Pose at an arbitrary timestamp for the app (interpolated, or predicted
+    // when enabled); does not count towards delivery stats. timestamp is in
+    // the declared clock domain.
+    bool queryPose(int64_t timestamp, PoseData* pose) const;
+
+    // Max distance to the nearest pose sample for a lookup to succeed
+    void setPoseTolerance(int toleranceMs);
+
+    // Extrapolate poses for frames newer than the newest sample (up to
+    // maxHorizonMs; flagged unreliable beyond unreliableHorizonMs)
+    void setPosePrediction(bool enabled, PredictionModel model, int maxHorizonMs,
+                           int unreliableHorizonMs);
+    void getPosePredictionStats(int64_t* lookups, int64_t* predicted,
+                                int64_t* totalHorizonNs, int64_t* maxHorizonNs);
+
+    // Late-pose join: hold a frame up to timeoutMs until a pose sample at or
+    // after its timestamp arrives, and deliver the pose before the frame
+    void setPoseJoin(bool enabled, int timeoutMs);
+    bool poseJoinEnabled() const { return poseJoinEnabled_.load(); }
+    // Tracker side: false on timeout (caller falls back to prediction)
+    bool waitForBracketingPose(int64_t timestamp);
+    // Tracker side: block until a frame newer than *frameSequence is queued
+    void waitForNewFrame(uint64_t* frameSequence, int64_t timeoutNs);
+    void setPoseDeliveryActive(bool active);
+    void notifyPoseDelivered(int64_t timestamp);
+    // Camera side: block until the pose for timestamp has been delivered
+    bool waitForPoseDelivered(int64_t timestamp);
+    void getPoseJoinStats(int64_t* joins, int64_t* waits, int64_t* timeouts,
+                          int64_t* totalWaitNs, int64_t* orderTimeouts);
+
+    // Camera rig: per-camera extrinsics relative to the head. When set, fed
+    // poses are treated as head poses and composed with the extrinsics of the
+    // camera that captured each frame.
+    static const int MAX_RIG_CAMERAS = 2;
+    bool setCameraExtrinsics(int cameraId, const float* position, const float* rotation);
+    void clearCameraExtrinsics();
+    bool setActiveCamera(int cameraId);
+    int activeCamera() const { return activeCamera_.load(); }
+    // Head pose -> camera pose in place (no-op without extrinsics for cameraId)
+    void composeCameraPose(int cameraId, PoseData* pose);
+
+    // Stereo ingestion: pick which camera's queued frames are delivered.
+    // score: how well a camera currently sees the tracked target [0, 1]
+    // (reported from Unity, used by BEST_CAMERA).
+    void setStereoPolicy(StereoPolicy policy);
+    StereoPolicy stereoPolicy() const { return (StereoPolicy)stereoPolicy_.load(); }
+    bool setCameraTargetScore(int cameraId, float score);
+    void getStereoStats(int64_t* picks, int64_t* switches);
+
+    // Pose validity: classify delivered poses from tracker confidence, lookup
+    // gap, pose jumps (relocalization) and motion. A jump is a step beyond
+    // jumpDistance/jumpAngleDeg between samples at most maxGapMs apart.
+    // settleMs is how long poses stay INITIALIZING/RELOCALIZING after start,
+    // a jump or tracking loss. Disabled, no jumps or relocalizations are tracked.
+    void setPoseValidation(bool enabled, float minConfidence, int maxGapMs, float jumpDistance,
+                           float jumpAngleDeg, float maxAngularVelocityDeg, int settleMs);
+    void classifyPose(const PoseData& pose, VuforiaDriver::PoseReason* reason,
+                      VuforiaDriver::PoseValidity* validity);
+    // Next poses report INITIALIZING until tracking settles again
+    void resetPoseValidation();
+    void getPoseValidityStats(int64_t* classified, int64_t* unreliable, int64_t* initializing,
+                              int64_t* relocalizing, int64_t* excessiveMotion,
+                              int64_t* relocalizations);
+
+    // Pose streaming: forward every pose sample at tracker rate. Frame poses
+    // are then emitted by the camera thread immediately before their frame;
+    // both paths serialize on poseDeliveryMutex(). Samples are held back
+    // until they are older than the next frame to be posed, so timestamps
+    // handed to Vuforia never go backwards.
+    void setPoseStreaming(bool enabled);
+    bool poseStreamingEnabled() const { return poseStreamingEnabled_.load(); }
+    std::mutex& poseDeliveryMutex() { return poseDeliveryMutex_; }
+    // Camera side (under poseDeliveryMutex): streams the samples older than
+    // the frame, then the frame's own pose
+    bool deliverFramePose(const CameraFrameData& frame);
+    uint32_t latestPoseSamples(PoseData* out, uint32_t maxCount) const;
+    // Samples older than this may be streamed: the oldest queued frame still
+    // awaiting its pose (after lastFramePose), else the newest queued frame
+    int64_t poseStreamHorizon(int64_t lastFramePose);
+
+    // Anchors created by Vuforia and backed by Unity spatial anchors. Pose
+    // jumps (relocalization) pause them until Unity reports fresh poses.
+    AnchorStore& anchorStore() { return anchors_; }
+
+    // Per-stage latency histograms and throughput counters (recorded by the
+    // driver, camera and tracker threads)
+    PipelineStats& pipelineStats() { return pipelineStats_; }
+
+    // Timeline of the frame/pose pipeline, dumped as Chrome trace JSON
+    TraceRecorder& traceRecorder() { return trace_; }
 
 private:
     QuestExternalCamera* camera_;
     QuestExternalTracker* tracker_;
 
-    // Frame buffer (circular buffer, keep last 3 frames)
+    // Frame buffer (circular buffer, keep last 4 frames: two per stereo camera)
     std::mutex frameMutex_;
-    std::queue<std::shared_ptr<CameraFrameData>> frameQueue_;
-    static const size_t MAX_FRAME_QUEUE_SIZE = 3;
+    std::deque<std::shared_ptr<CameraFrameData>> frameQueue_;
+    static const size_t MAX_FRAME_QUEUE_SIZE = 4;
+
+    // Sharpness-based selection among queued frames (guarded by frameMutex_)
+    std::atomic<bool> frameSelectionEnabled_;
+    int64_t selectionWindowNs_;
+    int64_t lastSelectedTimestamp_;  // Selection never goes back in time
+    int64_t selectedOlderCount_;
+    int64_t selectionCount_;
+
+    // Stereo delivery (pick state guarded by frameMutex_)
+    std::atomic<int32_t> stereoPolicy_;
+    std::atomic<float> cameraScores_[MAX_RIG_CAMERAS];
+    std::atomic<int> bestCamera_;
+    int lastPickedCamera_;
+    int64_t lastPickedTimestamp_;    // Picks never go back in time
+    int64_t cameraPicks_[MAX_RIG_CAMERAS];
+    int64_t cameraSwitches_;
+    static constexpr float BEST_CAMERA_MARGIN = 0.1f;  // Score lead needed to switch
+    int deliveryCamera() const;
+
+    // Recycled frame slots
+    std::shared_ptr<FrameSlotPool> framePool_;
+    static const size_t MAX_FRAME_POOL_SIZE = MAX_FRAME_QUEUE_SIZE + 3;
+    std::shared_ptr<CameraFrameData> acquireFrameSlot(uint32_t bufferSize);
+
+    // Intrinsics rescaled to the source frame size
+    VuforiaDriver::CameraIntrinsics sourceIntrinsics(const float* intrinsics, int cameraId,
+                                                     int width, int height);
+
+    // Pose history (lock-free for readers)
+    PoseRing poseRing_;
+    std::atomic<int64_t> poseToleranceNs_;
 
-    // Pose buffer (keep last 90 poses ~ 3 seconds @ 30fps)
-    std::mutex poseMutex_;
-    std::queue<std::shared_ptr<PoseData>> poseQueue_;
-    static const size_t MAX_POSE_QUEUE_SIZE = 90;
+    // Pose prediction config and stats
+    std::atomic<bool> predictionEnabled_;
+    std::atomic<int32_t> predictionModel_;
+    std::atomic<int64_t> maxPredictionNs_;
+    std::atomic<int64_t> unreliablePredictionNs_;
+    std::atomic<int64_t> poseLookups_;
+    std::atomic<int64_t> posePredictions_;
+    std::atomic<int64_t> predictionHorizonTotalNs_;
+    std::atomic<int64_t> predictionHorizonMaxNs_;
 
-    // Cached intrinsics
+    // Late-pose join (frame/pose arrival and pose delivery wake joinCv_)
+    std::mutex joinMutex_;
+    std::condition_variable joinCv_;
+    std::atomic<bool> poseJoinEnabled_;
+    std::atomic<int64_t> poseJoinTimeoutNs_;
+    std::atomic<bool> poseDeliveryActive_;
+    std::atomic<uint64_t> frameSequence_;
+    std::atomic<int64_t> lastDeliveredPoseTimestamp_;
+    std::atomic<int64_t> poseJoins_;
+    std::atomic<int64_t> poseJoinWaits_;
+    std::atomic<int64_t> poseJoinTimeouts_;
+    std::atomic<int64_t> poseJoinWaitTotalNs_;
+    std::atomic<int64_t> poseOrderTimeouts_;
+    static const int64_t POSE_ORDER_MARGIN_NS = 5000000;  // Tracker wake-up slack
+    void notifyJoinWaiters();
+
+    // Camera rig (extrinsics set once from Unity, read per pose)
+    std::mutex rigMutex_;
+    RigCamera rig_[MAX_RIG_CAMERAS];
+    std::atomic<int> activeCamera_;
+
+    // Pose validity config (set from Unity) and counters
+    std::atomic<bool> poseValidationEnabled_;
+    std::atomic<float> minPoseConfidence_;
+    std::atomic<int64_t> maxPoseGapNs_;
+    std::atomic<float> poseJumpDistance_;        // m
+    std::atomic<float> poseJumpAngle_;           // rad
+    std::atomic<float> excessiveAngularVelocity_;  // rad/s
+    std::atomic<int64_t> poseSettleNs_;
+    std::atomic<bool> poseValidationReset_;
+    std::atomic<int64_t> posesClassified_;
+    std::atomic<int64_t> posesUnreliable_;
+    std::atomic<int64_t> posesInitializing_;
+    std::atomic<int64_t> posesRelocalizing_;
+    std::atomic<int64_t> posesExcessiveMotion_;
+    std::atomic<int64_t> relocalizationCount_;
+
+    // Tracking timeline (only touched by the pose feeding thread)
+    int64_t confidentSinceNs_;   // First confident sample of the current run, -1 if lost
+    int64_t lastJumpNs_;         // Most recent relocalization jump, -1 if none
+    bool trackingSettled_;       // Settled at least once since start/reset
+
+    // Anchor table (Vuforia creates, Unity updates, tracker reports in batches)
+    AnchorStore anchors_;
+
+    // Source clock -> CLOCK_MONOTONIC (mutable: queryPose maps without stamping)
+    mutable ClockSync clock_;
+    std::atomic<int64_t> lastFrameAgeNs_;  // Average over the last ingest-cost period
+
+    // Pipeline latency/throughput (lock-free)
+    PipelineStats pipelineStats_;
+    TraceRecorder trace_;
+
+    // Pose streaming (pose/frame pairs and streamed samples never interleave)
+    std::atomic<bool> poseStreamingEnabled_;
+    std::mutex poseDeliveryMutex_;
+
+    // Motion-based frame skipping (thresholds from Unity, counters for stats)
+    std::mutex motionMutex_;
+    bool motionSkipEnabled_;
+    float maxAngularVelocity_;  // rad/s
+    float maxLinearVelocity_;   // m/s
+    int maxConsecutiveSkips_;
+    int consecutiveMotionSkips_;  // Only touched by the camera delivery thread
+    std::atomic<int64_t> motionFramesEvaluated_;
+    std::atomic<int64_t> motionFramesSkipped_;
+
+    // Static-scene throttling (thumbnails computed at ingestion)
+    SceneChangeDetector sceneChange_;
+
+    // Cached per-camera intrinsics (rescaled per frame to the output size)
     std::mutex intrinsicsMutex_;
-    VuforiaDriver::CameraIntrinsics cachedIntrinsics_;
-    bool intrinsicsSet_;
+    CameraCalibration calibration_[MAX_RIG_CAMERAS];
+
+    // Size/format frames are converted to at ingestion (0x0 = source size)
+    std::mutex modeMutex_;
+    VuforiaDriver::CameraMode outputMode_;
+    CropWindow cropWindow_;
+
+    // Output scale within the active mode (tracking-status driven)
+    AdaptiveResolutionController adaptiveResolution_;
+
+    // Ingestion scratch (only touched by the feeding thread)
+    FrameScaler scaler_;
+    std::vector<uint8_t> scaleBuffer_;
+    UndistortionMap undistortion_[MAX_RIG_CAMERAS];  // Per rig camera (tables differ per lens)
+    std::vector<uint8_t> remapBuffer_;
+    FrameQualityAnalyzer quality_;
+
+    // Brightness gate (threshold set from Unity; state only touched at ingestion)
+    std::atomic<bool> brightnessGateEnabled_;
+    std::atomic<int> minMeanLuma_;
+    bool lowLightState_;
+    int64_t lowLightFrameCount_;
+    static const int LOW_LIGHT_HYSTERESIS = 8;
+    std::atomic<bool> grayscaleOnly_;
+    std::atomic<bool> undistortEnabled_;
+    LumaNormalizer normalizer_;
+
+    // Ingestion cost stats (conversion time, logged periodically)
+    int64_t ingestTimeNs_;
+    int64_t ingestAgeNs_;        // Capture (end of exposure) -> ingest start
+    int ingestFrameCount_;
+    int normalizedFrameCount_;
+
+    // Time-to-detection (searching -> tracked), logged per acquisition
+    std::mutex statusMutex_;
+    TrackingStatus trackingStatus_;
+    int64_t searchStartNs_;
 };
 
 // Global driver instance (managed by Vuforia)
@@ -0,0 +1,334 @@
+// Runtime checks for coordinate_transform.h: the batch (NEON on arm64) paths
+// against the scalar ones, and every convention pair round-tripping.
+// The compile-time checks in the header only cover a few constant poses.
+
+#include "coordinate_transform.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+static int g_failures = 0;
+static int g_checks = 0;
+
+#define CHECK(cond, ...) \
+    do { \
+        g_checks++; \
+        if (!(cond)) { \
+            g_failures++; \
+            fprintf(stderr, "FAIL %s:%d: ", __FILE__, __LINE__); \
+            fprintf(stderr, __VA_ARGS__); \
+            fprintf(stderr, "\n"); \
+        } \
+    } while (0)
+
+static const float TOLERANCE = 2e-5f;
+
+static float maxDifference(const float* a, const float* b, int n) {
+    float worst = 0.0f;
+    for (int i = 0; i < n; i++) {
+        worst = std::fmax(worst, std::fabs(a[i] - b[i]));
+    }
+    return worst;
+}
+
+// q and -q are the same rotation
+static float quaternionDifference(const float* a, const float* b) {
+    const float negated[4] = { -b[0], -b[1], -b[2], -b[3] };
+    return std::fmin(maxDifference(a, b, 4), maxDifference(a, negated, 4));
+}
+
+static void normalize(float* q) {
+    const float n = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+    for (int i = 0; i < 4; i++) {
+        q[i] /= n;
+    }
+}
+
+// =============================================================================
+// Test Data
+// =============================================================================
+
+// Unit quaternions: random ones plus the cases the pivoting has to get right
+static std::vector<float> makeQuaternions(std::mt19937& rng, int randomCount) {
+    const float h = std::sqrt(0.5f);
+    const float degenerate[][4] = {
+        { 0.0f, 0.0f, 0.0f, 1.0f },           // identity
+        { 0.0f, 0.0f, 0.0f, -1.0f },          // identity, negative w
+        { 1.0f, 0.0f, 0.0f, 0.0f },           // 180 degrees about each axis (trace -1)
+        { 0.0f, 1.0f, 0.0f, 0.0f },
+        { 0.0f, 0.0f, 1.0f, 0.0f },
+        { -1.0f, 0.0f, 0.0f, 0.0f },
+        { h, h, 0.0f, 0.0f },                 // 180 degrees about diagonals (pivot ties)
+        { 0.0f, h, h, 0.0f },
+        { h, 0.0f, -h, 0.0f },
+        { 0.5f, 0.5f, 0.5f, 0.5f },           // all pivots equal
+        { -0.5f, 0.5f, -0.5f, 0.5f },
+        { h, 0.0f, 0.0f, h },                 // 90 degrees about each axis
+        { 0.0f, h, 0.0f, h },
+        { 0.0f, 0.0f, h, -h },
+        { 1e-4f, 0.0f, 0.0f, 1.0f },          // near identity
+        { 0.0f, 0.0f, 1e-4f, 1.0f },
+        { 1.0f, 1e-4f, 0.0f, 0.0f },          // near 180 degrees
+        { 0.0f, 1e-4f, 1.0f, 1e-4f },
+        { -0.0f, -0.0f, -0.0f, 1.0f },        // signed zeros
+    };
+
+    std::vector<float> quats;
+    for (const float* q : degenerate) {
+        float unit[4] = { q[0], q[1], q[2], q[3] };
+        normalize(unit);
+        quats.insert(quats.end(), unit, unit + 4);
+    }
+
+    std::normal_distribution<float> gaussian(0.0f, 1.0f);
+    for (int i = 0; i < randomCount; i++) {
+        float q[4] = { gaussian(rng), gaussian(rng), gaussian(rng), gaussian(rng) };
+        normalize(q);
+        quats.insert(quats.end(), q, q + 4);
+    }
+    return quats;
+}
+
+// =============================================================================
+// Quaternion <-> Matrix
+// =============================================================================
+
+// Batch conversion against the scalar one for every count (NEON groups of
+// four plus the scalar tail)
+static void testBatchQuaternionToMatrix(const std::vector<float>& quats) {
+    const size_t total = quats.size() / 4;
+    std::vector<float> batch(total * 9);
+    for (size_t count = 0; count <= total; count = count < 16 ? count + 1 : count * 2 + 1) {
+        const size_t n = std::min(count, total);
+        std::fill(batch.begin(), batch.end(), NAN);
+        quaternionsToMatrices(quats.data(), batch.data(), n);
+        for (size_t i = 0; i < n; i++) {
+            float scalar[9];
+            quaternionToMatrix(&quats[i * 4], scalar);
+            const float diff = maxDifference(scalar, &batch[i * 9], 9);
+            CHECK(diff <= TOLERANCE, "quaternionsToMatrices[%zu] of %zu differs by %g", i, n, diff);
+        }
+        // Nothing written past the batch
+        if (n < total) {
+            CHECK(std::isnan(batch[n * 9]), "quaternionsToMatrices(%zu) wrote past the batch", n);
+        }
+    }
+
+    // Non-unit input follows the same formula in both paths
+    const float scaled[8] = { 0.2f, -0.4f, 0.1f, 0.3f, 2.0f, 0.0f, 0.0f, 0.0f };
+    float scalar[18];
+    float batched[18];
+    quaternionToMatrix(scaled, scalar);
+    quaternionToMatrix(scaled + 4, scalar + 9);
+    quaternionsToMatrices(scaled, batched, 2);
+    CHECK(maxDifference(scalar, batched, 18) <= TOLERANCE, "non-unit quaternions differ");
+}
+
+static void testMatrixToQuaternion(const std::vector<float>& quats) {
+    const size_t total = quats.size() / 4;
+    std::vector<float> matrices(total * 9);
+    quaternionsToMatrices(quats.data(), matrices.data(), total);
+
+    for (size_t count = 0; count <= total; count = count < 16 ? count + 1 : count * 2 + 1) {
+        const size_t n = std::min(count, total);
+        std::vector<float> batch(n * 4);
+        matricesToQuaternions(matrices.data(), batch.data(), n);
+        for (size_t i = 0; i < n; i++) {
+            float scalar[4];
+            matrixToQuaternion(&matrices[i * 9], scalar);
+            CHECK(quaternionDifference(scalar, &batch[i * 4]) <= TOLERANCE,
+                  "matricesToQuaternions[%zu] of %zu differs by %g", i, n,
+                  quaternionDifference(scalar, &batch[i * 4]));
+        }
+    }
+
+    // Round trip q -> R -> q
+    for (size_t i = 0; i < total; i++) {
+        float q[4];
+        matrixToQuaternion(&matrices[i * 9], q);
+        const float diff = quaternionDifference(&quats[i * 4], q);
+        CHECK(diff <= TOLERANCE, "matrixToQuaternion round trip %zu differs by %g", i, diff);
+
+        const float norm = q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3];
+        CHECK(std::fabs(norm - 1.0f) <= TOLERANCE, "matrixToQuaternion %zu not unit (%g)", i, norm);
+    }
+}
+
+// =============================================================================
+// Rotation Conversions
+// =============================================================================
+
+template <typename Conversion>
+static void checkConversion(const std::vector<float>& quats, const char* name) {
+    const size_t total = quats.size() / 4;
+    std::vector<float> scratch(total * 4);
+    std::vector<float> batch(total * 9);
+
+    for (size_t count = 0; count <= total; count = count < 16 ? count + 1 : count * 2 + 1) {
+        const size_t n = std::min(count, total);
+        Conversion::matrices(quats.data(), n, scratch.data(), batch.data());
+        for (size_t i = 0; i < n; i++) {
+            float single[9];
+            Conversion::matrix(&quats[i * 4], single);
+            const float diff = maxDifference(single, &batch[i * 9], 9);
+            CHECK(diff <= TOLERANCE, "%s::matrices[%zu] of %zu differs by %g", name, i, n, diff);
+        }
+    }
+
+    for (size_t i = 0; i < total; i++) {
+        float m[9];
+        float q[4];
+        Conversion::matrix(&quats[i * 4], m);
+        Conversion::inverse(m, q);
+        const float diff = quaternionDifference(&quats[i * 4], q);
+        CHECK(diff <= TOLERANCE, "%s::inverse round trip %zu differs by %g", name, i, diff);
+    }
+}
+
+// Every pair of conventions: there and back is the identity, and the
+// quaternion, matrix and batch forms agree
+template <typename From, typename To>
+static void checkPair(const std::vector<float>& quats, std::mt19937& rng, const char* name) {
+    typedef BasisChange<From, To> Forward;
+    typedef BasisChange<To, From> Backward;
+    std::uniform_real_distribution<float> coordinate(-5.0f, 5.0f);
+
+    for (int i = 0; i < 64; i++) {
+        const float p[3] = { coordinate(rng), coordinate(rng), coordinate(rng) };
+        float there[3];
+        float back[3];
+        Forward::position(p, there);
+        Backward::position(there, back);
+        CHECK(maxDifference(p, back, 3) == 0.0f, "%s position round trip", name);
+    }
+
+    const size_t total = quats.size() / 4;
+    for (size_t i = 0; i < total; i++) {
+        const float* q = &quats[i * 4];
+        float there[4];
+        float back[4];
+        Forward::quaternion(q, there);
+        Backward::quaternion(there, back);
+        CHECK(maxDifference(q, back, 4) == 0.0f, "%s quaternion round trip %zu", name, i);
+
+        // Converting the quaternion and converting its matrix agree
+        float m[9];
+        float converted[9];
+        float fromQuaternion[9];
+        quaternionToMatrix(q, m);
+        Forward::rotationMatrix(m, converted);
+        quaternionToMatrix(there, fromQuaternion);
+        CHECK(maxDifference(converted, fromQuaternion, 9) <= TOLERANCE,
+              "%s quaternion/matrix mismatch %zu", name, i);
+
+        float restored[9];
+        Backward::rotationMatrix(converted, restored);
+        CHECK(maxDifference(m, restored, 9) == 0.0f, "%s matrix round trip %zu", name, i);
+    }
+
+    checkConversion<BasisRotation<From, To>>(quats, name);
+}
+
+// =============================================================================
+// Delivered Poses
+// =============================================================================
+
+// Compile-time pin of the original hand-written tracker conversion, the
+// matrix of the quaternion (w, -z, -y, x), on a few constant poses
+static constexpr bool matchesLegacyRotation(float x, float y, float z, float w) {
+    const float q[4] = { x, y, z, w };
+    const float legacyQuat[4] = { w, -z, -y, x };
+    float legacy[9] = {};
+    float actual[9] = {};
+    quaternionToMatrix(legacyQuat, legacy);
+    RotationToCV::matrix(q, actual);
+    for (int i = 0; i < 9; i++) {
+        if (legacy[i] - actual[i] > 1e-5f || actual[i] - legacy[i] > 1e-5f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(matchesLegacyRotation(0.6f, 0.0f, 0.0f, 0.8f) &&
+              matchesLegacyRotation(0.0f, 0.6f, 0.0f, 0.8f) &&
+              matchesLegacyRotation(0.0f, 0.0f, 0.6f, 0.8f) &&
+              matchesLegacyRotation(0.36f, 0.48f, -0.64f, 0.48f),
+              "RotationToCV must reproduce the on-device validated rotation mapping");
+
+// Streamed batches (PositionToCV + RotationToCV::matrices) against the
+// per-frame transformOpenXRToCV, and both against the conversion validated
+// on device: p' = (x, -y, -z), R' = matrix of (w, -z, -y, x)
+static void testDeliveredPoses(const std::vector<float>& quats, std::mt19937& rng) {
+    const size_t total = quats.size() / 4;
+    std::uniform_real_distribution<float> coordinate(-5.0f, 5.0f);
+    std::vector<float> positions(total * 3);
+    for (float& v : positions) {
+        v = coordinate(rng);
+    }
+
+    std::vector<float> scratch(total * 4);
+    std::vector<float> positionsOut(total * 3);
+    std::vector<float> matricesOut(total * 9);
+    for (size_t i = 0; i < total; i++) {
+        PositionToCV::position(&positions[i * 3], &positionsOut[i * 3]);
+    }
+    RotationToCV::matrices(quats.data(), total, scratch.data(), matricesOut.data());
+
+    for (size_t i = 0; i < total; i++) {
+        const float* p = &positions[i * 3];
+        const float* q = &quats[i * 4];
+        float position[3];
+        float rotation[9];
+        transformOpenXRToCV(p, q, position, rotation);
+        CHECK(maxDifference(position, &positionsOut[i * 3], 3) == 0.0f, "streamed position %zu", i);
+        CHECK(maxDifference(rotation, &matricesOut[i * 9], 9) <= TOLERANCE,
+              "streamed rotation %zu differs by %g", i, maxDifference(rotation, &matricesOut[i * 9], 9));
+
+        const float legacyPosition[3] = { p[0], -p[1], -p[2] };
+        const float legacyQuat[4] = { q[3], -q[2], -q[1], q[0] };
+        float legacyRotation[9];
+        quaternionToMatrix(legacyQuat, legacyRotation);
+        CHECK(maxDifference(position, legacyPosition, 3) == 0.0f, "legacy position %zu", i);
+        CHECK(maxDifference(rotation, legacyRotation, 9) <= TOLERANCE,
+              "legacy rotation %zu differs by %g", i, maxDifference(rotation, legacyRotation, 9));
+
+        // Still a proper rotation: det(R') = +1
+        const float* r = rotation;
+        const float det = r[0] * (r[4] * r[8] - r[5] * r[7]) -
+                          r[1] * (r[3] * r[8] - r[5] * r[6]) +
+                          r[2] * (r[3] * r[7] - r[4] * r[6]);
+        CHECK(std::fabs(det - 1.0f) <= 1e-4f, "delivered rotation %zu has determinant %g", i, det);
+    }
+
+    checkConversion<RotationToCV>(quats, "RotationToCV");
+}
+
+int main() {
+    std::mt19937 rng(20240611);
+    const std::vector<float> quats = makeQuaternions(rng, 4096);
+
+#ifdef QUFORIA_HAS_NEON
+    printf("Batch paths: NEON\n");
+#else
+    printf("Batch paths: scalar\n");
+#endif
+
+    testBatchQuaternionToMatrix(quats);
+    testMatrixToQuaternion(quats);
+
+    checkPair<OpenXRConvention, UnityConvention>(quats, rng, "OpenXR->Unity");
+    checkPair<UnityConvention, OpenXRConvention>(quats, rng, "Unity->OpenXR");
+    checkPair<OpenXRConvention, VuforiaCVConvention>(quats, rng, "OpenXR->CV");
+    checkPair<VuforiaCVConvention, OpenXRConvention>(quats, rng, "CV->OpenXR");
+    checkPair<UnityConvention, VuforiaCVConvention>(quats, rng, "Unity->CV");
+    checkPair<VuforiaCVConvention, UnityConvention>(quats, rng, "CV->Unity");
+    checkPair<OpenXRConvention, OpenXRConvention>(quats, rng, "OpenXR->OpenXR");
+
+    testDeliveredPoses(quats, rng);
+
+    printf("%d checks, %d failures\n", g_checks, g_failures);
+    return g_failures == 0 ? 0 : 1;
+}